@@ -1,4 +1,6 @@
 #include "raylib.h"
+#define FRAME_PROFILER_IMPLEMENTATION
+#include "frame_profiler.h"
 #include <cmath>
 
 int main()
@@ -20,6 +22,7 @@ int main()
 
     while (!WindowShouldClose())
     {
+        PROFILE_BEGIN("update");
         ballPosition.x += ballSpeed.x;
         ballPosition.y += ballSpeed.y;
 
@@ -55,13 +58,19 @@ int main()
             }
         }
 
+        PROFILE_END();
+
+        PROFILE_BEGIN("draw");
         BeginDrawing();
         ClearBackground(RAYWHITE);
         DrawCircleV(ballPosition, ballRadius, MAROON);
         DrawRectangleV(paddlePosition, paddleSize, BLACK);
         DrawText(TextFormat("Score: %i", score), 10, 10, 20, DARKGRAY);
         DrawText("Управляйте ракеткой с помощью мыши", screenWidth - 350, screenHeight - 30, 15, GRAY);
+        PROFILE_OVERLAY();
+        PROFILE_END();
         EndDrawing();
+        PROFILE_FRAME_END();
     }
 
     CloseWindow();
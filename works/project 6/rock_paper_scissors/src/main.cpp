@@ -1,4 +1,6 @@
 #include "raylib.h"
+#define FRAME_PROFILER_IMPLEMENTATION
+#include "frame_profiler.h"
 #include <cstdlib>
 #include <ctime>
 
@@ -117,6 +119,7 @@ int main()
 
     while (!WindowShouldClose())
     {
+        PROFILE_BEGIN("update");
         // Обработка ввода
         if (!gameStarted)
         {
@@ -203,7 +206,10 @@ int main()
             computer.alpha = 255;
         }
 
+        PROFILE_END();
+
         // Отрисовка
+        PROFILE_BEGIN("draw");
         BeginDrawing();
         ClearBackground(RAYWHITE);
         DrawTexture(bgTexture, 0, 0, WHITE);
@@ -246,7 +252,10 @@ int main()
             DrawText("Press SPACE to restart", 280, 550, 20, GRAY);
         }
 
+        PROFILE_OVERLAY();
+        PROFILE_END();
         EndDrawing();
+        PROFILE_FRAME_END();
     }
 
     UnloadAssets();
@@ -0,0 +1,132 @@
+// Замер логики кадра: перебор всех монстров против сетки.
+// Логика повторяет SimulationStep без отрисовки и звука:
+// MonsterPoolSeek к игроку + поиск столкновений с игроком,
+// с радиусами и ячейкой сетки из simulation.h/simulation.c.
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 199309L // clock_gettime
+#endif
+#include "raylib.h"
+#include "../monster_pool.h"
+#include "../simulation.h"
+#include "../spatial_grid.h"
+#include "bench_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FRAMES 200
+#define R_PLAYER SIM_PLAYER_RADIUS
+#define R_MONSTER SIM_MONSTER_RADIUS
+
+static volatile int sink;
+
+static void Scatter(MonsterPool *pool, int n)
+{
+    srand(1);
+    MonsterPoolClear(pool);
+    for (int i = 0; i < n; i++)
+    {
+        Vector2 p = {(float)(rand() % SIM_WORLD_WIDTH), (float)(rand() % SIM_WORLD_HEIGHT)};
+        MonsterPoolSpawn(pool, p, MONSTER_TYPE_BASIC, 25, 100);
+    }
+}
+
+// игрок ходит по кругу, чтобы монстры не слиплись в одну точку
+static Vector2 PlayerAt(int frame)
+{
+    return (Vector2){SIM_WORLD_WIDTH / 2 + 250 * cosf(frame * 0.05f),
+                     SIM_WORLD_HEIGHT / 2 + 200 * sinf(frame * 0.05f)};
+}
+
+static int Hits(const MonsterPool *pool, Vector2 p, const int *candidates, int found)
+{
+    int hits = 0;
+    for (int k = 0; k < found; k++)
+        if (CheckCollisionCircles(p, R_PLAYER, MonsterPosition(pool, candidates[k]), R_MONSTER))
+            hits++;
+    return hits;
+}
+
+typedef struct
+{
+    double seek;   // только движение
+    double keyed;  // движение + ключи ячеек тем же проходом
+    double scan;   // MonsterPoolNear + точная проверка
+    double commit; // сортировка подсчётом
+    double query;  // запрос к сетке + точная проверка
+} FrameCost;
+
+// Кадр симуляции стоит seek + scan без сетки или keyed + commit + query с ней.
+// Оба варианта гоняются на одних и тех же позициях: ключи пишутся
+// в тот же кадр, что и движение, поэтому seek замеряется отдельным прогоном.
+static FrameCost Run(int n, MonsterPool *pool, SpatialGrid *grid, int *query)
+{
+    FrameCost cost = {0};
+    Scatter(pool, n);
+    for (int f = 0; f < FRAMES; f++)
+    {
+        Vector2 p = PlayerAt(f);
+        double t0 = Now();
+        MonsterPoolSeek(pool, p, 200, 1.0f / 60, grid);
+        double t1 = Now();
+
+        int found = MonsterPoolNear(pool, p, R_PLAYER + R_MONSTER + 1, query);
+        int hits = Hits(pool, p, query, found);
+        double t2 = Now();
+
+        SpatialGridCommit(grid);
+        double t3 = Now();
+
+        found = SpatialGridQuery(grid, p, R_PLAYER + R_MONSTER, query, n);
+        hits -= Hits(pool, p, query, found);
+        double t4 = Now();
+
+        sink += hits; // должно остаться 0
+        cost.keyed += t1 - t0;
+        cost.scan += t2 - t1;
+        cost.commit += t3 - t2;
+        cost.query += t4 - t3;
+    }
+    Scatter(pool, n);
+    for (int f = 0; f < FRAMES; f++)
+    {
+        double t0 = Now();
+        MonsterPoolSeek(pool, PlayerAt(f), 200, 1.0f / 60, NULL);
+        cost.seek += Now() - t0;
+    }
+    double toMs = 1000.0 / FRAMES;
+    cost.seek *= toMs;
+    cost.keyed *= toMs;
+    cost.scan *= toMs;
+    cost.commit *= toMs;
+    cost.query *= toMs;
+    return cost;
+}
+
+int main(void)
+{
+    const int counts[] = {100, 1000, 10000, 100000};
+    const int maxCount = 100000;
+    int *query = malloc(maxCount * sizeof(int));
+    MonsterPool pool;
+    MonsterPoolInit(&pool, maxCount);
+    SpatialGrid grid;
+    SpatialGridInit(&grid, SIM_WORLD_WIDTH, SIM_WORLD_HEIGHT, fmaxf(2 * R_MONSTER, 32.0f));
+
+    // ms на кадр
+    printf("%10s %10s %10s %10s %10s %10s %10s %10s\n", "monsters", "seek", "keyed",
+           "scan", "commit", "query", "no grid", "grid");
+    for (int c = 0; c < 4; c++)
+    {
+        FrameCost cost = Run(counts[c], &pool, &grid, query);
+        printf("%10d %10.4f %10.4f %10.4f %10.4f %10.4f %10.4f %10.4f\n", counts[c],
+               cost.seek, cost.keyed, cost.scan, cost.commit, cost.query,
+               cost.seek + cost.scan, cost.keyed + cost.commit + cost.query);
+    }
+    if (sink != 0)
+        printf("mismatch between scan and grid: %d\n", sink);
+
+    SpatialGridFree(&grid);
+    MonsterPoolFree(&pool);
+    free(query);
+    return sink != 0;
+}
@@ -0,0 +1,123 @@
+// Обновление монстров: старый массив структур (AoS) с raymath
+// против SoA-хранилища со скалярным и векторным ядром.
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 199309L // clock_gettime
+#endif
+#include "raylib.h"
+#include "raymath.h"
+#include "../monster_pool.h"
+#include "bench_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MONSTERS 100000
+#define FRAMES 500
+
+// прежняя раскладка из main.c
+typedef struct
+{
+    Vector2 position;
+    int health;
+    bool isAlive;
+    MonsterType type;
+    bool isHit;
+    float hitTimer;
+    Vector2 knockbackDir;
+} Monster;
+
+static void UpdateAoS(Monster *monsters, int n, Vector2 target, float delta)
+{
+    for (int i = 0; i < n; i++)
+    {
+        Monster *m = &monsters[i];
+        if (!m->isAlive)
+            continue;
+        Vector2 dir = Vector2Subtract(target, m->position);
+        float speed = (m->type == MONSTER_TYPE_FAST ? 150 : m->type == MONSTER_TYPE_TANK ? 80
+                                                                                         : 100);
+        float len = Vector2Length(dir);
+        if (len > 0)
+            dir = Vector2Scale(dir, speed * delta / len);
+        m->position = Vector2Add(m->position, dir);
+        if (m->isHit)
+        {
+            m->position = Vector2Add(m->position,
+                                     Vector2Scale(m->knockbackDir, 200 * delta));
+            m->hitTimer -= delta;
+            if (m->hitTimer <= 0)
+                m->isHit = false;
+        }
+    }
+}
+
+static void Fill(MonsterPool *pool, Monster *aos)
+{
+    srand(1);
+    MonsterPoolClear(pool);
+    for (int i = 0; i < MONSTERS; i++)
+    {
+        Vector2 p = {(float)(rand() % 800), (float)(rand() % 600)};
+        MonsterType type = (MonsterType)(rand() % 3);
+        float speed = type == MONSTER_TYPE_FAST ? 150 : type == MONSTER_TYPE_TANK ? 80
+                                                                                  : 100;
+        int m = MonsterPoolIndex(pool, MonsterPoolSpawn(pool, p, type, 25, speed));
+        aos[i] = (Monster){.position = p, .health = 25, .isAlive = true, .type = type};
+        // каждый десятый отброшен
+        if (i % 10 == 0)
+        {
+            pool->hitTimer[m] = aos[i].hitTimer = 0.2f;
+            pool->knockX[m] = aos[i].knockbackDir.x = 1.0f;
+            aos[i].isHit = true;
+        }
+    }
+}
+
+static Vector2 TargetAt(int frame)
+{
+    return (Vector2){400 + 250 * cosf(frame * 0.05f),
+                     300 + 200 * sinf(frame * 0.05f)};
+}
+
+int main(void)
+{
+    MonsterPool pool, check;
+    MonsterPoolInit(&pool, MONSTERS);
+    MonsterPoolInit(&check, MONSTERS);
+    Monster *aos = malloc(MONSTERS * sizeof(Monster));
+    const float delta = 1.0f / 60;
+
+    Fill(&pool, aos);
+    double t0 = Now();
+    for (int f = 0; f < FRAMES; f++)
+        UpdateAoS(aos, MONSTERS, TargetAt(f), delta);
+    double aosMs = (Now() - t0) * 1000.0 / FRAMES;
+
+    Fill(&check, aos);
+    t0 = Now();
+    for (int f = 0; f < FRAMES; f++)
+        MonsterPoolSeekScalar(&check, 0, check.count, TargetAt(f), 200, delta, NULL, NULL);
+    double scalarMs = (Now() - t0) * 1000.0 / FRAMES;
+
+    Fill(&pool, aos);
+    t0 = Now();
+    for (int f = 0; f < FRAMES; f++)
+        MonsterPoolSeek(&pool, TargetAt(f), 200, delta, NULL);
+    double simdMs = (Now() - t0) * 1000.0 / FRAMES;
+
+    // векторное ядро обязано совпадать со скалярным побитово
+    int mismatches = 0;
+    for (int i = 0; i < MONSTERS; i++)
+        if (pool.posX[i] != check.posX[i] || pool.posY[i] != check.posY[i])
+            mismatches++;
+
+    printf("%d monsters, ms per update\n", MONSTERS);
+    printf("  AoS + raymath : %.4f\n", aosMs);
+    printf("  SoA scalar    : %.4f\n", scalarMs);
+    printf("  SoA SIMD      : %.4f\n", simdMs);
+    printf("  SIMD/scalar mismatches: %d\n", mismatches);
+
+    free(aos);
+    MonsterPoolFree(&check);
+    MonsterPoolFree(&pool);
+    return mismatches != 0;
+}
@@ -0,0 +1,51 @@
+// Скорость симуляции без окна: сколько шагов SimulationStep
+// в секунду выдаёт одна игра со сценарным вводом.
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 199309L // clock_gettime
+#endif
+#include "raylib.h"
+#include "../simulation.h"
+#include "bench_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TICKS (60 * 60 * 10) // десять минут игрового времени
+
+// игрок ходит по квадрату и всё время бьёт
+static SimInput ScriptedInput(unsigned long long tick)
+{
+    static const unsigned int moves[] = {
+        SIM_INPUT_UP, SIM_INPUT_RIGHT, SIM_INPUT_DOWN, SIM_INPUT_LEFT};
+    SimInput input = {moves[(tick / 90) % 4] | SIM_INPUT_ATTACK};
+    return input;
+}
+
+int main(void)
+{
+    static SimState sim;
+    if (!SimulationInit(&sim, NULL))
+        return 1;
+    SimulationSeed(&sim, 1);
+
+    double t0 = Now();
+    int games = 1;
+    for (int t = 0; t < TICKS; t++)
+    {
+        SimulationStep(&sim, ScriptedInput(sim.tick));
+        if (sim.gameOver)
+        {
+            games++;
+            SimulationSeed(&sim, games);
+            SimulationReset(&sim);
+        }
+    }
+    double seconds = Now() - t0;
+
+    printf("%d ticks (%d games) in %.3f s: %.0f ticks/s, %.1fx real time\n",
+           TICKS, games, seconds, TICKS / seconds, TICKS * SIM_DT / seconds);
+    printf("last game: tick %llu, score %d, monsters %d\n",
+           sim.tick, sim.score, sim.monsters.count);
+
+    SimulationFree(&sim);
+    return 0;
+}
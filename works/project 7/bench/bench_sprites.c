@@ -0,0 +1,107 @@
+// Отрисовка спрайтов в стиле bunnymark: DrawTextureEx на каждый
+// спрайт против SpriteBatchDraw. Открывает окно без vsync и
+// печатает среднее время кадра для 1k..100k прыгающих монстров.
+// Запускать из папки проекта (нужен resources/monster.png).
+#include "raylib.h"
+#include "../sprite_batch.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define WIDTH 800
+#define HEIGHT 600
+#define WARMUP_FRAMES 30
+#define FRAMES 200
+#define MAX_SPRITES 100000
+#define SCALE 0.25f
+
+static float x[MAX_SPRITES], y[MAX_SPRITES];
+static float vx[MAX_SPRITES], vy[MAX_SPRITES];
+static Color tint[MAX_SPRITES];
+
+static void Scatter(void)
+{
+    srand(1);
+    for (int i = 0; i < MAX_SPRITES; i++)
+    {
+        x[i] = (float)(rand() % WIDTH);
+        y[i] = (float)(rand() % HEIGHT);
+        vx[i] = (float)(rand() % 240 - 120);
+        vy[i] = (float)(rand() % 240 - 120);
+        tint[i] = (Color){rand() % 190 + 50, rand() % 160 + 80, rand() % 140 + 100, 255};
+    }
+}
+
+static void Move(int n)
+{
+    const float dt = 1.0f / 60;
+    for (int i = 0; i < n; i++)
+    {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        if (x[i] < 0 || x[i] > WIDTH)
+            vx[i] = -vx[i];
+        if (y[i] < 0 || y[i] > HEIGHT)
+            vy[i] = -vy[i];
+    }
+}
+
+static void DrawEach(Texture2D tex, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        Vector2 p = {x[i] - tex.width * SCALE / 2, y[i] - tex.height * SCALE / 2};
+        DrawTextureEx(tex, p, 0, SCALE, tint[i]);
+    }
+}
+
+// мс на кадр; batch == NULL — старый путь
+static double Measure(Texture2D tex, SpriteBatch *batch, int n)
+{
+    double t0 = 0;
+    for (int f = 0; f < WARMUP_FRAMES + FRAMES; f++)
+    {
+        if (f == WARMUP_FRAMES)
+            t0 = GetTime();
+        Move(n);
+        BeginDrawing();
+        ClearBackground(BLACK);
+        if (batch)
+            SpriteBatchDraw(batch, tex, x, y, tint, NULL, SCALE, n);
+        else
+            DrawEach(tex, n);
+        EndDrawing();
+    }
+    return (GetTime() - t0) * 1000.0 / FRAMES;
+}
+
+int main(void)
+{
+    SetConfigFlags(0); // без FLAG_VSYNC_HINT
+    SetTraceLogLevel(LOG_WARNING);
+    InitWindow(WIDTH, HEIGHT, "bench_sprites");
+    SetTargetFPS(0);
+    Texture2D tex = LoadTexture("resources/monster.png");
+    SpriteBatch batch;
+    if (tex.id == 0 || !SpriteBatchInit(&batch, 16384))
+    {
+        CloseWindow();
+        return 1;
+    }
+
+    static const int counts[] = {1000, 10000, 50000, 100000};
+    printf("%8s %16s %16s\n", "sprites", "DrawTextureEx ms", "SpriteBatch ms");
+    for (int c = 0; c < (int)(sizeof(counts) / sizeof(counts[0])); c++)
+    {
+        int n = counts[c];
+        Scatter();
+        double each = Measure(tex, NULL, n);
+        Scatter();
+        double batched = Measure(tex, &batch, n);
+        printf("%8d %16.3f %16.3f\n", n, each, batched);
+    }
+
+    SpriteBatchFree(&batch);
+    UnloadTexture(tex);
+    CloseWindow();
+    return 0;
+}
@@ -0,0 +1,27 @@
+#ifndef BENCH_TIMER_H
+#define BENCH_TIMER_H
+
+// Монотонные часы в секундах для бенчмарков.
+#if defined(_WIN32)
+// windows.h конфликтует с raylib.h (Rectangle, DrawText...), поэтому
+// объявляем только нужные функции, как это делает сам raylib
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(unsigned long long *count);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(unsigned long long *frequency);
+static double Now(void)
+{
+    unsigned long long f, c;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&c);
+    return (double)c / (double)f;
+}
+#else
+#include <time.h>
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+#endif
+
+#endif // BENCH_TIMER_H
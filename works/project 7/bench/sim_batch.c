@@ -0,0 +1,338 @@
+// Пакетный прогон режима выживания без окна и звука.
+// N независимых игр раздаются по ядрам через ThreadPool, в конце
+// печатаются гистограммы времени жизни, очков и цены шага.
+// Параметры баланса задаются ключами, см. Usage().
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 199309L // clock_gettime
+#endif
+#include "raylib.h"
+#include "../simulation.h"
+#include "../thread_pool.h"
+#include "bench_timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HIST_BINS 10
+#define COST_BUCKETS 32 // log2 наносекунд
+
+typedef enum
+{
+    POLICY_SCRIPTED,
+    POLICY_RANDOM
+} Policy;
+
+typedef struct
+{
+    SimConfig config;
+    Policy policy;
+    int games;
+    int threads;
+    float maxSeconds; // предел одной игры
+    unsigned int seed;
+} BatchOptions;
+
+typedef struct
+{
+    float seconds;
+    int score;
+    bool timedOut;
+    bool failed;
+    unsigned long long stepCost[COST_BUCKETS];
+} GameResult;
+
+typedef struct
+{
+    const BatchOptions *options;
+    GameResult *results;
+} Batch;
+
+//==============================================
+//                  ВВОД
+//==============================================
+// игрок ходит по квадрату и всё время бьёт (как в bench_sim)
+static SimInput ScriptedInput(unsigned long long tick)
+{
+    static const unsigned int moves[] = {
+        SIM_INPUT_UP, SIM_INPUT_RIGHT, SIM_INPUT_DOWN, SIM_INPUT_LEFT};
+    SimInput input = {moves[(tick / 90) % 4] | SIM_INPUT_ATTACK};
+    return input;
+}
+
+// xorshift32: у каждой игры свой поток, rand() тут не годится
+static unsigned int NextRandom(unsigned int *state)
+{
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+// случайная кнопка держится 0.25 с, атака с вероятностью 1/2
+static SimInput RandomInput(unsigned long long tick, unsigned int *rng, SimInput held)
+{
+    if (tick % 15 != 0)
+        return held;
+    unsigned int r = NextRandom(rng);
+    SimInput input = {r & (SIM_INPUT_UP | SIM_INPUT_DOWN | SIM_INPUT_LEFT | SIM_INPUT_RIGHT)};
+    if (r & (1u << 8))
+        input.buttons |= SIM_INPUT_ATTACK;
+    return input;
+}
+
+//==============================================
+//                  ИГРА
+//==============================================
+static int CostBucket(double seconds)
+{
+    unsigned long long ns = (unsigned long long)(seconds * 1e9);
+    int b = 0;
+    while (ns > 1 && b < COST_BUCKETS - 1)
+    {
+        ns >>= 1;
+        b++;
+    }
+    return b;
+}
+
+static void RunGame(void *userData, int index)
+{
+    Batch *batch = userData;
+    const BatchOptions *options = batch->options;
+    GameResult *result = &batch->results[index];
+    memset(result, 0, sizeof(*result));
+
+    SimState sim;
+    if (!SimulationInit(&sim, &options->config))
+    {
+        result->failed = true;
+        return;
+    }
+    // у игры index свой seed, результат не зависит от числа потоков
+    SimulationSeed(&sim, (unsigned long long)options->seed << 32 | (unsigned int)index);
+    SimulationReset(&sim);
+    unsigned int rng = options->seed * 2654435761u + (unsigned int)index + 1;
+    if (rng == 0)
+        rng = 1;
+    unsigned long long maxTicks = (unsigned long long)(options->maxSeconds / SIM_DT);
+    SimInput input = {0};
+
+    while (!sim.gameOver && sim.tick < maxTicks)
+    {
+        input = options->policy == POLICY_RANDOM
+                    ? RandomInput(sim.tick, &rng, input)
+                    : ScriptedInput(sim.tick);
+        double t0 = Now();
+        SimulationStep(&sim, input);
+        result->stepCost[CostBucket(Now() - t0)]++;
+    }
+    result->seconds = sim.tick * SIM_DT;
+    result->score = sim.score;
+    result->timedOut = !sim.gameOver;
+    SimulationFree(&sim);
+}
+
+//==============================================
+//                ГИСТОГРАММЫ
+//==============================================
+static void PrintBar(unsigned long long count, unsigned long long max)
+{
+    int width = max ? (int)(count * 40 / max) : 0;
+    for (int i = 0; i < width; i++)
+        putchar('#');
+    putchar('\n');
+}
+
+static void PrintHistogram(const char *title, const double *values, int n)
+{
+    double lo = values[0], hi = values[0], sum = 0;
+    for (int i = 0; i < n; i++)
+    {
+        lo = values[i] < lo ? values[i] : lo;
+        hi = values[i] > hi ? values[i] : hi;
+        sum += values[i];
+    }
+    printf("\n%s: min %.1f, mean %.1f, max %.1f\n", title, lo, sum / n, hi);
+
+    unsigned long long bins[HIST_BINS] = {0}, max = 0;
+    double width = (hi - lo) / HIST_BINS;
+    for (int i = 0; i < n; i++)
+    {
+        int b = width > 0 ? (int)((values[i] - lo) / width) : 0;
+        bins[b < HIST_BINS ? b : HIST_BINS - 1]++;
+    }
+    for (int b = 0; b < HIST_BINS; b++)
+        max = bins[b] > max ? bins[b] : max;
+    for (int b = 0; b < HIST_BINS; b++)
+    {
+        printf("%10.1f .. %-10.1f %6llu ", lo + b * width, lo + (b + 1) * width, bins[b]);
+        PrintBar(bins[b], max);
+    }
+}
+
+static void PrintStepCost(const GameResult *results, int n)
+{
+    unsigned long long buckets[COST_BUCKETS] = {0}, max = 0, total = 0;
+    for (int i = 0; i < n; i++)
+        for (int b = 0; b < COST_BUCKETS; b++)
+            buckets[b] += results[i].stepCost[b];
+    int first = COST_BUCKETS, last = 0;
+    for (int b = 0; b < COST_BUCKETS; b++)
+    {
+        total += buckets[b];
+        max = buckets[b] > max ? buckets[b] : max;
+        if (buckets[b])
+        {
+            first = b < first ? b : first;
+            last = b;
+        }
+    }
+    printf("\nstep cost: %llu steps\n", total);
+    for (int b = first; b <= last; b++)
+    {
+        printf("%9llu ns .. %-9llu %10llu ", 1ull << b, 1ull << (b + 1), buckets[b]);
+        PrintBar(buckets[b], max);
+    }
+}
+
+//==============================================
+//                 ПАРАМЕТРЫ
+//==============================================
+static void Usage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  -n GAMES               number of games (64)\n"
+            "  -j THREADS             worker threads, 0 = all cores (0)\n"
+            "  --policy scripted|random\n"
+            "  --seed N               base seed for spawns and random policy (1)\n"
+            "  --max-time SECONDS     stop a game after this long (1800)\n"
+            "  --spawn-interval S     initial spawn interval\n"
+            "  --spawn-growth S       spawn interval growth per second\n"
+            "  --TYPE-health N        TYPE is basic, fast or tank\n"
+            "  --TYPE-speed F\n"
+            "  --TYPE-weight N        relative spawn frequency\n",
+            program);
+}
+
+static bool ParseMonsterOption(SimConfig *config, const char *name, const char *value)
+{
+    static const char *types[MONSTER_TYPE_COUNT] = {
+        [MONSTER_TYPE_BASIC] = "basic",
+        [MONSTER_TYPE_FAST] = "fast",
+        [MONSTER_TYPE_TANK] = "tank"};
+    for (int t = 0; t < MONSTER_TYPE_COUNT; t++)
+    {
+        size_t len = strlen(types[t]);
+        if (strncmp(name, types[t], len) != 0 || name[len] != '-')
+            continue;
+        const char *field = name + len + 1;
+        MonsterStats *stats = &config->monsters[t];
+        if (strcmp(field, "health") == 0)
+            stats->health = atoi(value);
+        else if (strcmp(field, "speed") == 0)
+            stats->speed = (float)atof(value);
+        else if (strcmp(field, "weight") == 0)
+            stats->spawnWeight = atoi(value);
+        else
+            return false;
+        return true;
+    }
+    return false;
+}
+
+static bool ParseOptions(int argc, char **argv, BatchOptions *options)
+{
+    *options = (BatchOptions){
+        .config = SimDefaultConfig(),
+        .policy = POLICY_SCRIPTED,
+        .games = 64,
+        .threads = 0,
+        .maxSeconds = 1800.0f,
+        .seed = 1};
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if (i + 1 >= argc)
+            return false;
+        const char *value = argv[++i];
+        if (strcmp(arg, "-n") == 0)
+            options->games = atoi(value);
+        else if (strcmp(arg, "-j") == 0)
+            options->threads = atoi(value);
+        else if (strcmp(arg, "--policy") == 0)
+        {
+            if (strcmp(value, "scripted") == 0)
+                options->policy = POLICY_SCRIPTED;
+            else if (strcmp(value, "random") == 0)
+                options->policy = POLICY_RANDOM;
+            else
+                return false;
+        }
+        else if (strcmp(arg, "--seed") == 0)
+            options->seed = (unsigned int)strtoul(value, NULL, 10);
+        else if (strcmp(arg, "--max-time") == 0)
+            options->maxSeconds = (float)atof(value);
+        else if (strcmp(arg, "--spawn-interval") == 0)
+            options->config.spawnInterval = (float)atof(value);
+        else if (strcmp(arg, "--spawn-growth") == 0)
+            options->config.spawnGrowthRate = (float)atof(value);
+        else if (strncmp(arg, "--", 2) != 0 ||
+                 !ParseMonsterOption(&options->config, arg + 2, value))
+            return false;
+    }
+    return options->games > 0 && options->maxSeconds > 0;
+}
+
+int main(int argc, char **argv)
+{
+    BatchOptions options;
+    if (!ParseOptions(argc, argv, &options))
+    {
+        Usage(argv[0]);
+        return 2;
+    }
+
+    Batch batch = {&options, calloc(options.games, sizeof(GameResult))};
+    double *values = malloc(options.games * sizeof(double));
+    ThreadPool *pool = ThreadPoolCreate(options.threads);
+    if (!batch.results || !values || !pool)
+    {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    double t0 = Now();
+    ThreadPoolParallelFor(pool, options.games, RunGame, &batch);
+    double wall = Now() - t0;
+
+    int done = 0, timedOut = 0;
+    double simulated = 0;
+    for (int i = 0; i < options.games; i++)
+    {
+        if (batch.results[i].failed)
+            continue;
+        timedOut += batch.results[i].timedOut;
+        simulated += batch.results[i].seconds;
+        batch.results[done] = batch.results[i];
+        done++;
+    }
+    printf("%d games on %d threads in %.2f s (%.0fx real time), %d reached --max-time\n",
+           done, ThreadPoolSize(pool), wall, simulated / wall, timedOut);
+    if (done == 0)
+        return 1;
+
+    for (int i = 0; i < done; i++)
+        values[i] = batch.results[i].seconds;
+    PrintHistogram("survival time, s", values, done);
+    for (int i = 0; i < done; i++)
+        values[i] = batch.results[i].score;
+    PrintHistogram("score", values, done);
+    PrintStepCost(batch.results, done);
+
+    ThreadPoolDestroy(pool);
+    free(values);
+    free(batch.results);
+    return 0;
+}
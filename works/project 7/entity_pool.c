@@ -0,0 +1,93 @@
+#include "entity_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool EntityPoolInit(EntityPool *pool, int capacity)
+{
+    memset(pool, 0, sizeof(*pool));
+    pool->freeHead = -1;
+    return EntityPoolReserve(pool, capacity);
+}
+
+void EntityPoolFree(EntityPool *pool)
+{
+    free(pool->generation);
+    free(pool->slotDense);
+    free(pool->denseSlot);
+    memset(pool, 0, sizeof(*pool));
+    pool->freeHead = -1;
+}
+
+void EntityPoolClear(EntityPool *pool)
+{
+    // живые дескрипторы становятся недействительными;
+    // поколения свободных слотов уже увеличены при удалении
+    for (int i = 0; i < pool->count; i++)
+        pool->generation[pool->denseSlot[i]]++;
+    pool->count = 0;
+    pool->slotCount = 0;
+    pool->freeHead = -1;
+}
+
+bool EntityPoolReserve(EntityPool *pool, int capacity)
+{
+    if (capacity <= pool->capacity)
+        return true;
+    unsigned int *gen = realloc(pool->generation, capacity * sizeof(unsigned int));
+    if (gen)
+        pool->generation = gen;
+    int *slotDense = realloc(pool->slotDense, capacity * sizeof(int));
+    if (slotDense)
+        pool->slotDense = slotDense;
+    int *denseSlot = realloc(pool->denseSlot, capacity * sizeof(int));
+    if (denseSlot)
+        pool->denseSlot = denseSlot;
+    if (!gen || !slotDense || !denseSlot)
+        return false;
+    for (int s = pool->capacity; s < capacity; s++)
+        pool->generation[s] = 1;
+    pool->capacity = capacity;
+    return true;
+}
+
+EntityHandle EntityPoolAcquire(EntityPool *pool)
+{
+    if (pool->count >= pool->capacity)
+        return (EntityHandle){0};
+    int slot;
+    if (pool->freeHead >= 0)
+    {
+        slot = pool->freeHead;
+        pool->freeHead = pool->slotDense[slot];
+    }
+    else
+        slot = pool->slotCount++;
+    int index = pool->count++;
+    pool->slotDense[slot] = index;
+    pool->denseSlot[index] = slot;
+    return (EntityHandle){slot, pool->generation[slot]};
+}
+
+int EntityPoolRelease(EntityPool *pool, EntityHandle handle)
+{
+    int index = EntityPoolIndex(pool, handle);
+    if (index < 0)
+        return -1;
+    int last = --pool->count;
+    int lastSlot = pool->denseSlot[last];
+    pool->denseSlot[index] = lastSlot;
+    pool->slotDense[lastSlot] = index;
+
+    pool->generation[handle.slot]++;
+    pool->slotDense[handle.slot] = pool->freeHead;
+    pool->freeHead = handle.slot;
+    return index;
+}
+
+int EntityPoolIndex(const EntityPool *pool, EntityHandle handle)
+{
+    if (handle.slot < 0 || handle.slot >= pool->slotCount ||
+        pool->generation[handle.slot] != handle.generation)
+        return -1;
+    return pool->slotDense[handle.slot];
+}
@@ -0,0 +1,58 @@
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include <stdbool.h>
+
+//==============================================
+//     ТАБЛИЦА ДЕСКРИПТОРОВ С ПОКОЛЕНИЯМИ
+//==============================================
+// Живые сущности всегда лежат плотно в [0, count): удаление
+// переносит последнюю на место удалённой. Снаружи сущность
+// держат через EntityHandle — номер слота и поколение; после
+// удаления поколение слота растёт, и старый дескриптор
+// перестаёт находиться. Свободные слоты связаны в список.
+//
+// Таблица хранит только индексы: данные сущностей лежат у
+// владельца, который сам переносит их при удалении и сам
+// увеличивает ёмкость через EntityPoolReserve.
+
+typedef struct
+{
+    int slot;
+    unsigned int generation; // 0 — пустой дескриптор
+} EntityHandle;
+
+typedef struct
+{
+    unsigned int *generation; // по слотам
+    int *slotDense;           // слот -> плотный индекс (у свободных — следующий свободный)
+    int *denseSlot;           // плотный индекс -> слот
+    int freeHead;
+    int slotCount;
+    int count;
+    int capacity;
+} EntityPool;
+
+bool EntityPoolInit(EntityPool *pool, int capacity);
+void EntityPoolFree(EntityPool *pool);
+void EntityPoolClear(EntityPool *pool);
+bool EntityPoolReserve(EntityPool *pool, int capacity);
+
+// новая сущность получает плотный индекс count - 1;
+// перед вызовом нужна свободная ёмкость
+EntityHandle EntityPoolAcquire(EntityPool *pool);
+
+// возвращает освободившийся плотный индекс или -1;
+// если он меньше нового count, владелец переносит туда
+// данные с индекса count
+int EntityPoolRelease(EntityPool *pool, EntityHandle handle);
+
+int EntityPoolIndex(const EntityPool *pool, EntityHandle handle);
+
+static inline EntityHandle EntityPoolHandleAt(const EntityPool *pool, int index)
+{
+    int slot = pool->denseSlot[index];
+    return (EntityHandle){slot, pool->generation[slot]};
+}
+
+#endif // ENTITY_POOL_H
@@ -0,0 +1,47 @@
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L // fileno, fsync
+#endif
+#include "file_replace.h"
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <io.h> // _commit
+#else
+#include <unistd.h>
+#endif
+
+bool FileSync(FILE *f)
+{
+    if (fflush(f) != 0)
+        return false;
+#if defined(_WIN32)
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+bool FileReplace(const char *from, const char *to)
+{
+#if defined(_WIN32)
+    return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(from, to) == 0;
+#endif
+}
+
+bool FileWriteReplace(const char *path, const char *tmpPath,
+                      const void *data, size_t size)
+{
+    FILE *f = fopen(tmpPath, "wb");
+    if (!f)
+        return false;
+    bool ok = fwrite(data, 1, size, f) == size && FileSync(f);
+    ok = fclose(f) == 0 && ok;
+    if (!ok)
+    {
+        remove(tmpPath);
+        return false;
+    }
+    return FileReplace(tmpPath, path);
+}
@@ -0,0 +1,22 @@
+#ifndef FILE_REPLACE_H
+#define FILE_REPLACE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+//==============================================
+//         ЗАМЕНА ФАЙЛА ЧЕРЕЗ ВРЕМЕННЫЙ
+//==============================================
+// Файл пишется во временный рядом, сбрасывается на диск и
+// переименовывается поверх старого: при сбое остаётся либо
+// старый файл, либо новый целиком.
+
+// сбрасывает буферы ОС на диск перед переименованием
+bool FileSync(FILE *f);
+// rename, который и на Windows заменяет существующий файл
+bool FileReplace(const char *from, const char *to);
+// size байт data в tmpPath, затем FileReplace(tmpPath, path)
+bool FileWriteReplace(const char *path, const char *tmpPath,
+                      const void *data, size_t size);
+
+#endif // FILE_REPLACE_H
@@ -0,0 +1,243 @@
+#include "highscore_store.h"
+#include "file_replace.h"
+#include "platform_thread.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct HighscoreStore
+{
+    Highscore *entries; // по убыванию очков
+    int count;
+    int capacity;
+    int limit;
+    char *path;
+    char *tmpPath;
+
+    Thread writer;
+    Mutex lock;
+    Cond wake;  // есть что писать или пора выходить
+    bool dirty; // таблица менялась после последней записи
+    bool quit;
+    bool writerStarted;
+};
+
+//==============================================
+//                  ЗАПИСЬ
+//==============================================
+static bool WriteTable(const HighscoreStore *store, const Highscore *entries, int count)
+{
+    FILE *f = fopen(store->tmpPath, "w");
+    if (!f)
+        return false;
+    for (int i = 0; i < count; i++)
+        fprintf(f, "%s %d\n", entries[i].name, entries[i].score);
+    bool ok = !ferror(f) && FileSync(f);
+    ok = fclose(f) == 0 && ok;
+    if (!ok)
+    {
+        remove(store->tmpPath);
+        return false;
+    }
+    return FileReplace(store->tmpPath, store->path);
+}
+
+// пишет снимок таблицы, снятый под lock; сам файл — уже без него
+static ThreadResult THREAD_CALL WriterMain(void *arg)
+{
+    HighscoreStore *store = arg;
+    Highscore *snapshot = NULL;
+    int snapshotCapacity = 0;
+
+    MutexLock(&store->lock);
+    for (;;)
+    {
+        while (!store->dirty && !store->quit)
+            CondWait(&store->wake, &store->lock);
+        if (!store->dirty)
+            break;
+        if (store->count > snapshotCapacity)
+        {
+            Highscore *grown = realloc(snapshot, store->count * sizeof(Highscore));
+            if (!grown)
+                break;
+            snapshot = grown;
+            snapshotCapacity = store->count;
+        }
+        int count = store->count;
+        memcpy(snapshot, store->entries, count * sizeof(Highscore));
+        store->dirty = false;
+        MutexUnlock(&store->lock);
+
+        WriteTable(store, snapshot, count);
+
+        MutexLock(&store->lock);
+    }
+    MutexUnlock(&store->lock);
+    free(snapshot);
+    return 0;
+}
+
+//==============================================
+//                 ТАБЛИЦА
+//==============================================
+static int CompareScores(const void *a, const void *b)
+{
+    const Highscore *x = a, *y = b;
+    if (x->score != y->score)
+        return x->score > y->score ? -1 : 1;
+    return strcmp(x->name, y->name);
+}
+
+static bool Reserve(HighscoreStore *store, int n)
+{
+    if (n <= store->capacity)
+        return true;
+    int capacity = store->capacity ? store->capacity : 64;
+    while (capacity < n)
+        capacity *= 2;
+    Highscore *grown = realloc(store->entries, capacity * sizeof(Highscore));
+    if (!grown)
+        return false;
+    store->entries = grown;
+    store->capacity = capacity;
+    return true;
+}
+
+static void LoadTable(HighscoreStore *store)
+{
+    FILE *f = fopen(store->path, "r");
+    if (!f)
+        return;
+    Highscore entry;
+    bool sorted = true;
+    while (fscanf(f, "%15s%d", entry.name, &entry.score) == 2 &&
+           Reserve(store, store->count + 1))
+    {
+        if (store->count > 0 && store->entries[store->count - 1].score < entry.score)
+            sorted = false;
+        store->entries[store->count++] = entry;
+    }
+    fclose(f);
+    // файл, записанный самой таблицей, уже упорядочен
+    if (!sorted)
+        qsort(store->entries, store->count, sizeof(Highscore), CompareScores);
+    if (store->count > store->limit)
+        store->count = store->limit;
+}
+
+static char *CopyString(const char *s)
+{
+    size_t n = strlen(s) + 1;
+    char *copy = malloc(n);
+    if (copy)
+        memcpy(copy, s, n);
+    return copy;
+}
+
+HighscoreStore *HighscoreStoreOpen(const char *path, int limit)
+{
+    HighscoreStore *store = calloc(1, sizeof(HighscoreStore));
+    if (!store)
+        return NULL;
+    store->limit = limit > 0 ? limit : 1;
+    store->path = CopyString(path);
+    store->tmpPath = malloc(strlen(path) + 5);
+    if (!store->path || !store->tmpPath)
+    {
+        free(store->path);
+        free(store->tmpPath);
+        free(store);
+        return NULL;
+    }
+    sprintf(store->tmpPath, "%s.tmp", path);
+    LoadTable(store);
+
+    MutexInit(&store->lock);
+    CondInit(&store->wake);
+    // без потока таблица всё равно работает, только не сохраняется
+    store->writerStarted = ThreadStart(&store->writer, WriterMain, store);
+    return store;
+}
+
+void HighscoreStoreClose(HighscoreStore *store)
+{
+    if (!store)
+        return;
+    if (store->writerStarted)
+    {
+        MutexLock(&store->lock);
+        store->quit = true;
+        CondBroadcast(&store->wake);
+        MutexUnlock(&store->lock);
+        ThreadJoin(store->writer);
+    }
+    CondDestroy(&store->wake);
+    MutexDestroy(&store->lock);
+    free(store->entries);
+    free(store->path);
+    free(store->tmpPath);
+    free(store);
+}
+
+int HighscoreStoreAdd(HighscoreStore *store, const char *name, int score)
+{
+    MutexLock(&store->lock);
+    // первое место, где очков меньше: равные остаются выше
+    int lo = 0, hi = store->count;
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+        if (store->entries[mid].score >= score)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    int rank = lo;
+    if (rank >= store->limit ||
+        (store->count < store->limit && !Reserve(store, store->count + 1)))
+    {
+        MutexUnlock(&store->lock);
+        return -1;
+    }
+
+    int moved = (store->count < store->limit ? store->count : store->limit - 1) - rank;
+    memmove(&store->entries[rank + 1], &store->entries[rank], moved * sizeof(Highscore));
+    if (store->count < store->limit)
+        store->count++;
+
+    Highscore *entry = &store->entries[rank];
+    snprintf(entry->name, HIGHSCORE_NAME_SIZE, "%s", name[0] ? name : "Player");
+    // пробел разорвал бы строку файла
+    for (char *c = entry->name; *c; c++)
+        if (isspace((unsigned char)*c))
+            *c = '_';
+    entry->score = score;
+
+    store->dirty = true;
+    CondBroadcast(&store->wake);
+    MutexUnlock(&store->lock);
+    return rank;
+}
+
+int HighscoreStoreCount(HighscoreStore *store)
+{
+    MutexLock(&store->lock);
+    int count = store->count;
+    MutexUnlock(&store->lock);
+    return count;
+}
+
+int HighscoreStorePage(HighscoreStore *store, int first, Highscore *out, int max)
+{
+    MutexLock(&store->lock);
+    int n = 0;
+    if (first >= 0 && first < store->count)
+    {
+        n = store->count - first < max ? store->count - first : max;
+        memcpy(out, &store->entries[first], n * sizeof(Highscore));
+    }
+    MutexUnlock(&store->lock);
+    return n;
+}
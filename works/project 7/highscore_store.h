@@ -0,0 +1,40 @@
+#ifndef HIGHSCORE_STORE_H
+#define HIGHSCORE_STORE_H
+
+#include <stdbool.h>
+
+//==============================================
+//              ТАБЛИЦА РЕКОРДОВ
+//==============================================
+// Лучшие limit результатов в массиве, отсортированном по убыванию
+// очков; новый результат встаёт двоичным поиском после равных,
+// худший при переполнении вытесняется.
+//
+// На диск пишет отдельный поток: HighscoreStoreAdd только будит
+// его, кадр не ждёт файловой системы. Файл пишется во временный
+// path.tmp, сбрасывается на диск и переименовывается поверх
+// старого, так что при сбое остаётся либо старая, либо новая
+// таблица целиком. Формат прежний: строки «имя очки».
+
+#define HIGHSCORE_NAME_SIZE 16
+
+typedef struct
+{
+    char name[HIGHSCORE_NAME_SIZE];
+    int score;
+} Highscore;
+
+typedef struct HighscoreStore HighscoreStore;
+
+// загружает path (если есть) и запускает поток записи
+HighscoreStore *HighscoreStoreOpen(const char *path, int limit);
+// дописывает несохранённое и останавливает поток
+void HighscoreStoreClose(HighscoreStore *store);
+
+// место в таблице (с 0) или -1, если результат в неё не попал
+int HighscoreStoreAdd(HighscoreStore *store, const char *name, int score);
+int HighscoreStoreCount(HighscoreStore *store);
+// копирует до max записей начиная с места first, возвращает число скопированных
+int HighscoreStorePage(HighscoreStore *store, int first, Highscore *out, int max);
+
+#endif // HIGHSCORE_STORE_H
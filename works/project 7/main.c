@@ -1,5 +1,12 @@
 #include "raylib.h"
 #include "raymath.h"
+#include "simulation.h"
+#include "replay.h"
+#include "replay_writer.h"
+#include "sprite_batch.h"
+#include "highscore_store.h"
+#define FRAME_PROFILER_IMPLEMENTATION
+#include "frame_profiler.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -8,11 +15,15 @@
 //==============================================
 //                 КОНСТАНТЫ
 //==============================================
-#define SCREEN_WIDTH 800
-#define SCREEN_HEIGHT 600
-#define MAX_MONSTERS 100
-#define MAX_BONUSES 100
-#define MAX_HIGHSCORES 5
+#define SCREEN_WIDTH SIM_WORLD_WIDTH
+#define SCREEN_HEIGHT SIM_WORLD_HEIGHT
+// не больше стольких секунд симуляции за кадр, иначе
+// после долгой паузы шаги догоняли бы время бесконечно
+#define MAX_FRAME_TIME 0.25f
+#define MAX_HIGHSCORES 100000
+#define LEADERBOARD_PAGE 8
+#define REPLAY_FILE "last_replay.rpl"
+#define SPRITE_BATCH_CAPACITY 16384
 
 //==============================================
 //               ПЕРЕЧИСЛЕНИЯ
@@ -28,92 +39,41 @@ typedef enum
     GAME_OVER
 } GameState;
 
-typedef enum
-{
-    MONSTER_TYPE_BASIC,
-    MONSTER_TYPE_FAST,
-    MONSTER_TYPE_TANK
-} MonsterType;
-
-//==============================================
-//               СТРУКТУРЫ
-//==============================================
-typedef struct
-{
-    Vector2 position;
-    int health;
-    bool isAlive;
-} Player;
-
-typedef struct
-{
-    Vector2 position;
-    int health;
-    bool isAlive;
-    MonsterType type;
-    bool isHit;
-    float hitTimer;
-    Vector2 knockbackDir;
-} Monster;
-
-typedef struct
-{
-    Vector2 position;
-    bool isActive;
-    float timer;
-} Bonus;
-
-typedef struct
-{
-    char name[16];
-    int score;
-} Highscore;
-
 //==============================================
 //            ПРОТОТИПЫ ФУНКЦИЙ
 //==============================================
 void ResetGame(void);
-void SpawnMonster(void);
-void SpawnBonus(Vector2 position);
-void MaybeSpawnBonusRandom(float delta);
-void LoadHighscores(void);
 void SaveHighscore(int score);
 void DrawMainMenu(void);
 void DrawControls(void);
 void DrawLeaderboard(void);
-void UpdateGameLogic(float delta);
-void DrawGame(void);
+void UpdateGame(float frameTime);
+void DrawGame(float alpha);
 
 //==============================================
 //            ГЛОБАЛЬНЫЕ ПЕРЕМЕННЫЕ
 //==============================================
-static Player player;
-static Monster monsters[MAX_MONSTERS];
-static int monsterCount = 0;
-static Bonus bonuses[MAX_BONUSES];
-static int bonusCount = 0;
+static SimState sim;
+static Replay replay; // текущая игра, сохраняется при её конце
+static ReplayWriter *replayWriter;
+static float accumulator = 0.0f;
 
-static int score = 0;
-static Highscore highscores[MAX_HIGHSCORES];
-static int highscoreCount = 0;
+static HighscoreStore *highscores;
+static int leaderboardFirst = 0; // первое место на странице
 
 static GameState gameState = MENU_MAIN;
 static int selectedOption = 0;
 static bool gamePaused = false;
-static float attackCooldown = 0.0f;
-static float monsterAttackCooldown = 1.0f;
-static float spawnTimer = 0.0f;
-static float spawnInterval = 2.0f;
-static const float spawnGrowthRate = 0.02f;
-
-static bool playerHit = false;
-static float playerHitTimer = 0.0f;
-static bool flashScreen = false;
-static float flashTimer = 0.0f;
-
 static float bgScrollX = 0.0f;
 static const float bgScrollSpeed = 20.0f;
 
+// сущности кадра для SpriteBatchDraw
+static SpriteBatch spriteBatch;
+static float *drawX;
+static float *drawY;
+static Color *drawTint;
+static int drawCapacity = 0;
+
 static Texture2D texBackground;
 static Texture2D texPlayer;
 static Texture2D texMonster;
@@ -126,93 +86,18 @@ static Music bgmMusic;
 //==============================================
 void ResetGame(void)
 {
-    player.position = (Vector2){SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2};
-    player.health = 100;
-    player.isAlive = true;
-
-    monsterCount = bonusCount = 0;
-    score = 0;
-    spawnTimer = 0.0f;
-    spawnInterval = 2.0f;
-}
-
-void SpawnMonster(void)
-{
-    if (monsterCount >= MAX_MONSTERS)
-        return;
-    Monster m = {0};
-    m.position = (Vector2){(float)(rand() % SCREEN_WIDTH),
-                           (float)(rand() % SCREEN_HEIGHT)};
-    int r = rand() % 10;
-    if (r < 6)
-    {
-        m.type = MONSTER_TYPE_BASIC;
-        m.health = 25;
-    }
-    else if (r < 9)
-    {
-        m.type = MONSTER_TYPE_FAST;
-        m.health = 15;
-    }
-    else
-    {
-        m.type = MONSTER_TYPE_TANK;
-        m.health = 40;
-    }
-    m.isAlive = true;
-    m.isHit = false;
-    monsters[monsterCount++] = m;
-}
-
-void SpawnBonus(Vector2 position)
-{
-    if (bonusCount >= MAX_BONUSES)
-        return;
-    bonuses[bonusCount++] = (Bonus){
-        .position = position,
-        .isActive = true,
-        .timer = 5.0f};
-}
-
-void MaybeSpawnBonusRandom(float delta)
-{
-    static float timer = 0.0f;
-    timer += delta;
-    if (timer >= 10.0f)
-    {
-        timer = 0.0f;
-        SpawnBonus((Vector2){
-            (float)(rand() % SCREEN_WIDTH),
-            (float)(rand() % SCREEN_HEIGHT)});
-    }
-}
-
-void LoadHighscores(void)
-{
-    FILE *f = fopen("highscores.txt", "r");
-    if (!f)
-        return;
-    while (highscoreCount < MAX_HIGHSCORES &&
-           fscanf(f, "%15s%d",
-                  highscores[highscoreCount].name,
-                  &highscores[highscoreCount].score) == 2)
-        highscoreCount++;
-    fclose(f);
+    unsigned long long seed = (unsigned long long)time(NULL);
+    SimulationSeed(&sim, seed);
+    SimulationReset(&sim);
+    ReplayBegin(&replay, seed, &sim.config);
+    accumulator = 0.0f;
 }
 
+// файл пишет фоновый поток таблицы, кадр не ждёт диска
 void SaveHighscore(int sc)
 {
-    if (highscoreCount < MAX_HIGHSCORES)
-    {
-        highscores[highscoreCount].score = sc;
-        snprintf(highscores[highscoreCount].name, 16, "Player");
-        highscoreCount++;
-    }
-    FILE *f = fopen("highscores.txt", "w");
-    for (int i = 0; i < highscoreCount; i++)
-        fprintf(f, "%s %d\n",
-                highscores[i].name, highscores[i].score);
-    fclose(f);
+    if (highscores)
+        HighscoreStoreAdd(highscores, "Player", sc);
 }
 
 void DrawMainMenu(void)
@@ -235,163 +120,102 @@ void DrawControls(void)
     DrawText("ESC - Back / Exit", 320, 280, 20, LIGHTGRAY);
 }
 
+// таблица может быть огромной: копируется и рисуется только страница
 void DrawLeaderboard(void)
 {
     DrawText("Highscores", 340, 100, 30, WHITE);
-    for (int i = 0; i < highscoreCount; i++)
+    Highscore page[LEADERBOARD_PAGE];
+    int n = highscores ? HighscoreStorePage(highscores, leaderboardFirst,
+                                            page, LEADERBOARD_PAGE)
+                       : 0;
+    for (int i = 0; i < n; i++)
     {
         char buf[64];
         sprintf(buf, "%d. %s - %d",
-                i + 1, highscores[i].name, highscores[i].score);
+                leaderboardFirst + i + 1, page[i].name, page[i].score);
         DrawText(buf, 320, 160 + i * 30, 20, LIGHTGRAY);
     }
-    DrawText("ESC to back", 300, 360, 20, GRAY);
+    DrawText("UP/DOWN to scroll, ESC to back", 220, 420, 20, GRAY);
 }
 
-void UpdateGameLogic(float delta)
+static SimInput ReadInput(void)
 {
-    // эффекты
-    if (playerHitTimer > 0)
-        playerHitTimer -= delta;
-    else
-        playerHit = false;
-    if (flashTimer > 0)
-        flashTimer -= delta;
-    else
-        flashScreen = false;
-
-    if (gameState != MODE_SURVIVAL && gameState != MODE_ARENA)
-        return;
-
-    if (IsKeyPressed(KEY_P))
-        gamePaused = !gamePaused;
-    if (gamePaused)
-        return;
-
-    if (player.health <= 0)
-    {
-        gameState = GAME_OVER;
-        SaveHighscore(score);
-        return;
-    }
-
-    // движение игрока
+    SimInput input = {0};
     if (IsKeyDown(KEY_W))
-        player.position.y -= 200 * delta;
+        input.buttons |= SIM_INPUT_UP;
     if (IsKeyDown(KEY_S))
-        player.position.y += 200 * delta;
+        input.buttons |= SIM_INPUT_DOWN;
     if (IsKeyDown(KEY_A))
-        player.position.x -= 200 * delta;
+        input.buttons |= SIM_INPUT_LEFT;
     if (IsKeyDown(KEY_D))
-        player.position.x += 200 * delta;
+        input.buttons |= SIM_INPUT_RIGHT;
+    if (IsKeyDown(KEY_SPACE))
+        input.buttons |= SIM_INPUT_ATTACK;
+    return input;
+}
 
-    // таймеры
-    attackCooldown = fmaxf(0, attackCooldown - delta);
-    monsterAttackCooldown = fmaxf(0, monsterAttackCooldown - delta);
-    spawnTimer += delta;
-    spawnInterval += spawnGrowthRate * delta;
+// Время кадра копится и расходуется шагами по SIM_DT;
+// остаток (меньше шага) уходит в интерполяцию при отрисовке.
+void UpdateGame(float frameTime)
+{
+    if (IsKeyPressed(KEY_P))
+        gamePaused = !gamePaused;
+    if (gamePaused)
+        return;
 
     // фон
-    bgScrollX += bgScrollSpeed * delta;
+    bgScrollX += bgScrollSpeed * frameTime;
     if (bgScrollX > texBackground.width - SCREEN_WIDTH)
         bgScrollX = 0;
 
-    // спавн
-    if (spawnTimer >= spawnInterval)
-    {
-        spawnTimer = 0;
-        SpawnMonster();
-    }
-    MaybeSpawnBonusRandom(delta);
-
-    // вычисляем радиусы по texture+scale
-    float pScale = 0.6f;
-    float mScale = 0.5f;
-    float bScale = 0.5f;
-    float rPlayer = (texPlayer.width * pScale) / 2.0f;
-    float rMonster = (texMonster.width * mScale) / 2.0f;
-    float rBonus = (texBonus.width * bScale) / 2.0f;
-
-    // бонусы
-    for (int i = 0; i < bonusCount; i++)
-    {
-        if (!bonuses[i].isActive)
-            continue;
-        bonuses[i].timer -= delta;
-        if (bonuses[i].timer <= 0)
-        {
-            bonuses[i].isActive = false;
-            continue;
-        }
-        if (CheckCollisionCircles(player.position, rPlayer,
-                                  bonuses[i].position, rBonus))
-        {
-            player.health = fmin(player.health + 20, 100);
-            bonuses[i].isActive = false;
-            flashScreen = true;
-            flashTimer = 0.1f;
-        }
-    }
-
-    // монстры
-    for (int i = 0; i < monsterCount; i++)
+    accumulator += fminf(frameTime, MAX_FRAME_TIME);
+    SimInput input = ReadInput();
+    while (accumulator >= SIM_DT)
     {
-        Monster *m = &monsters[i];
-        if (!m->isAlive)
-            continue;
-        // движение
-        Vector2 dir = Vector2Subtract(player.position, m->position);
-        float speed = (m->type == MONSTER_TYPE_FAST ? 150 : m->type == MONSTER_TYPE_TANK ? 80
-                                                                                         : 100);
-        float len = Vector2Length(dir);
-        if (len > 0)
-            dir = Vector2Scale(dir, speed * delta / len);
-        m->position = Vector2Add(m->position, dir);
-        // атака на игрока
-        if (CheckCollisionCircles(player.position, rPlayer,
-                                  m->position, rMonster) &&
-            monsterAttackCooldown <= 0)
-        {
-            player.health -= 10;
-            monsterAttackCooldown = 1.0f;
-            playerHit = true;
-            playerHitTimer = 0.2f;
-        }
-        // удар игроком
-        if (CheckCollisionCircles(player.position, rPlayer,
-                                  m->position, rMonster) &&
-            IsKeyDown(KEY_SPACE) && attackCooldown <= 0)
-        {
-            m->health -= 10;
-            attackCooldown = 0.5f;
+        SimulationStep(&sim, input);
+        ReplayRecord(&replay, input, SimulationHash(&sim));
+        accumulator -= SIM_DT;
+        if (sim.events & SIM_EVENT_PLAYER_ATTACK)
             PlaySound(sfxAttack);
-            // эффект knockback от игрока
-            m->isHit = true;
-            m->hitTimer = 0.2f;
-            m->knockbackDir = Vector2Normalize(
-                Vector2Subtract(m->position, player.position));
-        }
-        // отбрасывание
-        if (m->isHit)
+        if (sim.events & SIM_EVENT_GAME_OVER)
         {
-            m->position = Vector2Add(
-                m->position,
-                Vector2Scale(m->knockbackDir, 200 * delta));
-            m->hitTimer -= delta;
-            if (m->hitTimer <= 0)
-                m->isHit = false;
-        }
-        // смерть
-        if (m->health <= 0 && m->isAlive)
-        {
-            m->isAlive = false;
-            score += 10;
-            SpawnBonus(m->position);
+            gameState = GAME_OVER;
+            SaveHighscore(sim.score);
+            // кадр только кодирует реплей в память, диск — в потоке записи
+            if (replayWriter)
+            {
+                size_t size;
+                unsigned char *data = ReplayEncode(&replay, &size);
+                ReplayWriterSubmit(replayWriter, data, size);
+            }
+            break;
         }
     }
 }
 
-void DrawGame(void)
+static bool EnsureDrawCapacity(int n)
+{
+    if (n <= drawCapacity)
+        return true;
+    int cap = drawCapacity ? drawCapacity : 256;
+    while (cap < n)
+        cap *= 2;
+    float *x = realloc(drawX, cap * sizeof(float));
+    if (x)
+        drawX = x;
+    float *y = realloc(drawY, cap * sizeof(float));
+    if (y)
+        drawY = y;
+    Color *tint = realloc(drawTint, cap * sizeof(Color));
+    if (tint)
+        drawTint = tint;
+    if (!x || !y || !tint)
+        return false;
+    drawCapacity = cap;
+    return true;
+}
+
+void DrawGame(float alpha)
 {
     // фон
     Rectangle src = {bgScrollX, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
@@ -399,46 +223,48 @@ void DrawGame(void)
     DrawTexturePro(texBackground, src, dst, (Vector2){0}, 0, WHITE);
 
     // вспышка
-    if (flashScreen)
+    if (sim.flashTimer > 0)
         DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, Fade(WHITE, 0.5f));
 
     // игрок
-    float pScale = 0.6f;
-    Color pCol = playerHit ? RED : WHITE;
+    float pScale = SIM_PLAYER_SCALE;
+    Color pCol = sim.playerHitTimer > 0 ? RED : WHITE;
+    Vector2 pPos = Vector2Lerp(sim.player.prevPosition, sim.player.position, alpha);
     Vector2 pDraw = {
-        player.position.x - (texPlayer.width * pScale) / 2,
-        player.position.y - (texPlayer.height * pScale) / 2};
+        pPos.x - (texPlayer.width * pScale) / 2,
+        pPos.y - (texPlayer.height * pScale) / 2};
     DrawTextureEx(texPlayer, pDraw, 0, pScale, pCol);
 
-    // монстры
-    float mScale = 0.5f;
-    for (int i = 0; i < monsterCount; i++)
+    // монстры: всё стадо одним пакетом
+    const MonsterPool *monsters = &sim.monsters;
+    if (EnsureDrawCapacity(monsters->count))
     {
-        Monster *m = &monsters[i];
-        if (!m->isAlive)
-            continue;
-        Color mCol = m->isHit ? RED : WHITE;
-        Vector2 mDraw = {
-            m->position.x - (texMonster.width * mScale) / 2,
-            m->position.y - (texMonster.height * mScale) / 2};
-        DrawTextureEx(texMonster, mDraw, 0, mScale, mCol);
+        for (int i = 0; i < monsters->count; i++)
+        {
+            drawX[i] = Lerp(monsters->prevX[i], monsters->posX[i], alpha);
+            drawY[i] = Lerp(monsters->prevY[i], monsters->posY[i], alpha);
+            drawTint[i] = monsters->hitTimer[i] > 0 ? RED : WHITE;
+        }
+        SpriteBatchDraw(&spriteBatch, texMonster, drawX, drawY, drawTint,
+                        NULL, SIM_MONSTER_SCALE, monsters->count);
     }
 
     // бонусы
-    float bScale = 0.5f;
-    for (int i = 0; i < bonusCount; i++)
+    int bonusCount = sim.bonusHandles.count;
+    if (EnsureDrawCapacity(bonusCount))
     {
-        if (!bonuses[i].isActive)
-            continue;
-        Vector2 bDraw = {
-            bonuses[i].position.x - (texBonus.width * bScale) / 2,
-            bonuses[i].position.y - (texBonus.height * bScale) / 2};
-        DrawTextureEx(texBonus, bDraw, 0, bScale, WHITE);
+        for (int i = 0; i < bonusCount; i++)
+        {
+            drawX[i] = sim.bonuses[i].position.x;
+            drawY[i] = sim.bonuses[i].position.y;
+        }
+        SpriteBatchDraw(&spriteBatch, texBonus, drawX, drawY, NULL,
+                        NULL, SIM_BONUS_SCALE, bonusCount);
     }
 
     // HUD
-    DrawText(TextFormat("HP: %d", player.health), 10, 10, 20, WHITE);
-    DrawText(TextFormat("Score: %d", score), 10, 40, 20, WHITE);
+    DrawText(TextFormat("HP: %d", sim.player.health), 10, 10, 20, WHITE);
+    DrawText(TextFormat("Score: %d", sim.score), 10, 40, 20, WHITE);
 }
 
 int main(void)
@@ -446,7 +272,6 @@ int main(void)
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Monster Battle Game");
     InitAudioDevice();
     SetTargetFPS(60);
-    srand(time(NULL));
 
     texBackground = LoadTexture("resources/background.png");
     texPlayer = LoadTexture("resources/player.png");
@@ -456,14 +281,30 @@ int main(void)
     bgmMusic = LoadMusicStream("resources/music.mp3");
     PlayMusicStream(bgmMusic);
 
-    LoadHighscores();
+    SimulationInit(&sim, NULL);
+    ReplayInit(&replay);
+    SpriteBatchInit(&spriteBatch, SPRITE_BATCH_CAPACITY);
+    highscores = HighscoreStoreOpen("highscores.txt", MAX_HIGHSCORES);
+    replayWriter = ReplayWriterOpen(REPLAY_FILE);
     ResetGame();
 
     while (!WindowShouldClose())
     {
-        float delta = GetFrameTime();
+        float frameTime = GetFrameTime();
+
+        // симуляция идёт до и независимо от отрисовки
+        if (gameState == MODE_SURVIVAL || gameState == MODE_ARENA)
+        {
+            PROFILE_BEGIN("update");
+            UpdateGame(frameTime);
+            PROFILE_END();
+            PROFILE_BEGIN("audio");
+            UpdateMusicStream(bgmMusic);
+            PROFILE_END();
+        }
 
         // меню и режимы
+        PROFILE_BEGIN("draw");
         BeginDrawing();
         ClearBackground(BLACK);
         switch (gameState)
@@ -489,6 +330,7 @@ int main(void)
                 if (selectedOption == 2)
                 {
                     gameState = MENU_LEADERBOARD;
+                    leaderboardFirst = 0;
                 }
                 if (selectedOption == 3)
                 {
@@ -507,14 +349,17 @@ int main(void)
             break;
         case MENU_LEADERBOARD:
             DrawLeaderboard();
+            if (IsKeyPressed(KEY_DOWN) && highscores &&
+                leaderboardFirst + LEADERBOARD_PAGE < HighscoreStoreCount(highscores))
+                leaderboardFirst += LEADERBOARD_PAGE;
+            if (IsKeyPressed(KEY_UP) && leaderboardFirst > 0)
+                leaderboardFirst -= LEADERBOARD_PAGE;
             if (IsKeyPressed(KEY_ESCAPE))
                 gameState = MENU_MAIN;
             break;
         case MODE_SURVIVAL:
         case MODE_ARENA:
-            UpdateGameLogic(delta);
-            UpdateMusicStream(bgmMusic);
-            DrawGame();
+            DrawGame(accumulator / SIM_DT);
             break;
         case GAME_OVER:
             DrawText("GAME OVER",
@@ -527,9 +372,20 @@ int main(void)
         default:
             break;
         }
+        PROFILE_OVERLAY();
+        PROFILE_END();
         EndDrawing();
+        PROFILE_FRAME_END();
     }
 
+    ReplayFree(&replay);
+    SimulationFree(&sim);
+    SpriteBatchFree(&spriteBatch);
+    HighscoreStoreClose(highscores);
+    ReplayWriterClose(replayWriter);
+    free(drawX);
+    free(drawY);
+    free(drawTint);
     UnloadTexture(texBackground);
     UnloadTexture(texPlayer);
     UnloadTexture(texMonster);
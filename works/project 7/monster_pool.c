@@ -0,0 +1,300 @@
+#include "monster_pool.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MONSTER_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MONSTER_SIMD_SSE
+#endif
+
+static bool GrowArray(void **array, int capacity, size_t elemSize)
+{
+    void *p = realloc(*array, capacity * elemSize);
+    if (!p)
+        return false;
+    *array = p;
+    return true;
+}
+
+static bool MonsterPoolGrow(MonsterPool *pool, int capacity)
+{
+    bool ok = GrowArray((void **)&pool->posX, capacity, sizeof(float)) &&
+              GrowArray((void **)&pool->posY, capacity, sizeof(float)) &&
+              GrowArray((void **)&pool->speed, capacity, sizeof(float)) &&
+              GrowArray((void **)&pool->hitTimer, capacity, sizeof(float)) &&
+              GrowArray((void **)&pool->knockX, capacity, sizeof(float)) &&
+              GrowArray((void **)&pool->knockY, capacity, sizeof(float)) &&
+              GrowArray((void **)&pool->health, capacity, sizeof(int)) &&
+              GrowArray((void **)&pool->type, capacity, sizeof(unsigned char)) &&
+              GrowArray((void **)&pool->prevX, capacity, sizeof(float)) &&
+              GrowArray((void **)&pool->prevY, capacity, sizeof(float)) &&
+              EntityPoolReserve(&pool->handles, capacity);
+    // при частичной неудаче старая ёмкость остаётся в силе
+    if (ok)
+        pool->capacity = capacity;
+    return ok;
+}
+
+bool MonsterPoolInit(MonsterPool *pool, int capacity)
+{
+    memset(pool, 0, sizeof(*pool));
+    if (!EntityPoolInit(&pool->handles, 0) || !MonsterPoolGrow(pool, capacity))
+    {
+        MonsterPoolFree(pool);
+        return false;
+    }
+    return true;
+}
+
+void MonsterPoolFree(MonsterPool *pool)
+{
+    free(pool->posX);
+    free(pool->posY);
+    free(pool->speed);
+    free(pool->hitTimer);
+    free(pool->knockX);
+    free(pool->knockY);
+    free(pool->health);
+    free(pool->type);
+    free(pool->prevX);
+    free(pool->prevY);
+    EntityPoolFree(&pool->handles);
+    memset(pool, 0, sizeof(*pool));
+}
+
+void MonsterPoolClear(MonsterPool *pool)
+{
+    EntityPoolClear(&pool->handles);
+    pool->count = 0;
+}
+
+EntityHandle MonsterPoolSpawn(MonsterPool *pool, Vector2 position, MonsterType type,
+                              int health, float speed)
+{
+    if (pool->count == pool->capacity &&
+        !MonsterPoolGrow(pool, pool->capacity ? pool->capacity * 2 : 64))
+        return (EntityHandle){0};
+    EntityHandle handle = EntityPoolAcquire(&pool->handles);
+    int i = pool->count++;
+    pool->posX[i] = position.x;
+    pool->posY[i] = position.y;
+    pool->speed[i] = speed;
+    pool->hitTimer[i] = 0.0f;
+    pool->knockX[i] = 0.0f;
+    pool->knockY[i] = 0.0f;
+    pool->health[i] = health;
+    pool->type[i] = (unsigned char)type;
+    pool->prevX[i] = position.x;
+    pool->prevY[i] = position.y;
+    return handle;
+}
+
+void MonsterPoolDespawn(MonsterPool *pool, EntityHandle handle)
+{
+    int hole = EntityPoolRelease(&pool->handles, handle);
+    if (hole < 0)
+        return;
+    int last = --pool->count;
+    if (hole == last)
+        return;
+    pool->posX[hole] = pool->posX[last];
+    pool->posY[hole] = pool->posY[last];
+    pool->speed[hole] = pool->speed[last];
+    pool->hitTimer[hole] = pool->hitTimer[last];
+    pool->knockX[hole] = pool->knockX[last];
+    pool->knockY[hole] = pool->knockY[last];
+    pool->health[hole] = pool->health[last];
+    pool->type[hole] = pool->type[last];
+    pool->prevX[hole] = pool->prevX[last];
+    pool->prevY[hole] = pool->prevY[last];
+}
+
+void MonsterPoolSnapshot(MonsterPool *pool)
+{
+    memcpy(pool->prevX, pool->posX, pool->count * sizeof(float));
+    memcpy(pool->prevY, pool->posY, pool->count * sizeof(float));
+}
+
+void MonsterPoolSeekScalar(MonsterPool *pool, int begin, int end, Vector2 target,
+                           float knockbackSpeed, float delta,
+                           const SpatialGrid *grid, int *keys)
+{
+    float kd = knockbackSpeed * delta;
+    for (int i = begin; i < end; i++)
+    {
+        float dx = target.x - pool->posX[i];
+        float dy = target.y - pool->posY[i];
+        float len = sqrtf(dx * dx + dy * dy);
+        float s = len > 0 ? pool->speed[i] * delta / len : 0.0f;
+        float x = pool->posX[i] + dx * s;
+        float y = pool->posY[i] + dy * s;
+        float t = pool->hitTimer[i];
+        if (t > 0)
+        {
+            x += pool->knockX[i] * kd;
+            y += pool->knockY[i] * kd;
+            pool->hitTimer[i] = t - delta;
+        }
+        pool->posX[i] = x;
+        pool->posY[i] = y;
+        if (keys)
+            keys[i] = SpatialGridCell(grid, x, y);
+    }
+}
+
+// Векторные версии считают то же самое, что скалярная, без ветвлений:
+// нулевая длина и неактивное отбрасывание гасятся масками. Ключ ячейки
+// считается во float, как SpatialGridCell: номера ячеек меньше 2^24.
+void MonsterPoolSeek(MonsterPool *pool, Vector2 target,
+                     float knockbackSpeed, float delta, SpatialGrid *grid)
+{
+    int i = 0;
+    int n = pool->count;
+    float *px = pool->posX;
+    float *py = pool->posY;
+    float *ht = pool->hitTimer;
+    int *keys = grid ? SpatialGridKeys(grid, n) : NULL;
+    if (grid && !keys)
+        grid = NULL; // без памяти под ключи сетка остаётся пустой
+    float inv = grid ? grid->invCellSize : 0.0f;
+    float maxX = grid ? (float)(grid->cols - 1) : 0.0f;
+    float maxY = grid ? (float)(grid->rows - 1) : 0.0f;
+    float cols = grid ? (float)grid->cols : 0.0f;
+#if defined(MONSTER_SIMD_AVX)
+    __m256 tx = _mm256_set1_ps(target.x);
+    __m256 ty = _mm256_set1_ps(target.y);
+    __m256 vd = _mm256_set1_ps(delta);
+    __m256 kd = _mm256_set1_ps(knockbackSpeed * delta);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 vInv = _mm256_set1_ps(inv);
+    __m256 vMaxX = _mm256_set1_ps(maxX);
+    __m256 vMaxY = _mm256_set1_ps(maxY);
+    __m256 vCols = _mm256_set1_ps(cols);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(px + i);
+        __m256 y = _mm256_loadu_ps(py + i);
+        __m256 dx = _mm256_sub_ps(tx, x);
+        __m256 dy = _mm256_sub_ps(ty, y);
+        __m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx),
+                                                  _mm256_mul_ps(dy, dy)));
+        __m256 s = _mm256_div_ps(_mm256_mul_ps(_mm256_loadu_ps(pool->speed + i), vd), len);
+        s = _mm256_and_ps(s, _mm256_cmp_ps(len, zero, _CMP_GT_OQ));
+        x = _mm256_add_ps(x, _mm256_mul_ps(dx, s));
+        y = _mm256_add_ps(y, _mm256_mul_ps(dy, s));
+
+        __m256 t = _mm256_loadu_ps(ht + i);
+        __m256 hit = _mm256_cmp_ps(t, zero, _CMP_GT_OQ);
+        x = _mm256_add_ps(x, _mm256_and_ps(hit, _mm256_mul_ps(_mm256_loadu_ps(pool->knockX + i), kd)));
+        y = _mm256_add_ps(y, _mm256_and_ps(hit, _mm256_mul_ps(_mm256_loadu_ps(pool->knockY + i), kd)));
+        _mm256_storeu_ps(ht + i, _mm256_sub_ps(t, _mm256_and_ps(hit, vd)));
+        _mm256_storeu_ps(px + i, x);
+        _mm256_storeu_ps(py + i, y);
+        if (keys)
+        {
+            __m256 cx = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(x, vInv), zero), vMaxX);
+            __m256 cy = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(y, vInv), zero), vMaxY);
+            __m256 key = _mm256_add_ps(_mm256_mul_ps(_mm256_round_ps(cy, _MM_FROUND_TO_ZERO), vCols),
+                                       _mm256_round_ps(cx, _MM_FROUND_TO_ZERO));
+            _mm256_storeu_si256((__m256i *)(keys + i), _mm256_cvttps_epi32(key));
+        }
+    }
+#elif defined(MONSTER_SIMD_SSE)
+    __m128 tx = _mm_set1_ps(target.x);
+    __m128 ty = _mm_set1_ps(target.y);
+    __m128 vd = _mm_set1_ps(delta);
+    __m128 kd = _mm_set1_ps(knockbackSpeed * delta);
+    __m128 zero = _mm_setzero_ps();
+    __m128 vInv = _mm_set1_ps(inv);
+    __m128 vMaxX = _mm_set1_ps(maxX);
+    __m128 vMaxY = _mm_set1_ps(maxY);
+    __m128 vCols = _mm_set1_ps(cols);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(px + i);
+        __m128 y = _mm_loadu_ps(py + i);
+        __m128 dx = _mm_sub_ps(tx, x);
+        __m128 dy = _mm_sub_ps(ty, y);
+        __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 s = _mm_div_ps(_mm_mul_ps(_mm_loadu_ps(pool->speed + i), vd), len);
+        s = _mm_and_ps(s, _mm_cmpgt_ps(len, zero));
+        x = _mm_add_ps(x, _mm_mul_ps(dx, s));
+        y = _mm_add_ps(y, _mm_mul_ps(dy, s));
+
+        __m128 t = _mm_loadu_ps(ht + i);
+        __m128 hit = _mm_cmpgt_ps(t, zero);
+        x = _mm_add_ps(x, _mm_and_ps(hit, _mm_mul_ps(_mm_loadu_ps(pool->knockX + i), kd)));
+        y = _mm_add_ps(y, _mm_and_ps(hit, _mm_mul_ps(_mm_loadu_ps(pool->knockY + i), kd)));
+        _mm_storeu_ps(ht + i, _mm_sub_ps(t, _mm_and_ps(hit, vd)));
+        _mm_storeu_ps(px + i, x);
+        _mm_storeu_ps(py + i, y);
+        if (keys)
+        {
+            // отрицательных после зажима нет, так что усечение — это floor
+            __m128 cx = _mm_min_ps(_mm_max_ps(_mm_mul_ps(x, vInv), zero), vMaxX);
+            __m128 cy = _mm_min_ps(_mm_max_ps(_mm_mul_ps(y, vInv), zero), vMaxY);
+            __m128 key = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(cy)), vCols),
+                                    _mm_cvtepi32_ps(_mm_cvttps_epi32(cx)));
+            _mm_storeu_si128((__m128i *)(keys + i), _mm_cvttps_epi32(key));
+        }
+    }
+#endif
+    // хвост (или весь массив без SIMD)
+    MonsterPoolSeekScalar(pool, i, n, target, knockbackSpeed, delta, grid, keys);
+}
+
+// Группа, где никто не попал в радиус, стоит одного сравнения маски.
+int MonsterPoolNear(const MonsterPool *pool, Vector2 center, float radius, int *out)
+{
+    int i = 0;
+    int found = 0;
+    int n = pool->count;
+    const float *px = pool->posX;
+    const float *py = pool->posY;
+    float r2 = radius * radius;
+#if defined(MONSTER_SIMD_AVX)
+    __m256 cx = _mm256_set1_ps(center.x);
+    __m256 cy = _mm256_set1_ps(center.y);
+    __m256 vr2 = _mm256_set1_ps(r2);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(px + i), cx);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(py + i), cy);
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(d2, vr2, _CMP_LE_OQ));
+        for (int k = 0; mask; k++, mask >>= 1)
+        {
+            out[found] = i + k; // без ветвления: found <= i + k, запись в пределах
+            found += mask & 1;
+        }
+    }
+#elif defined(MONSTER_SIMD_SSE)
+    __m128 cx = _mm_set1_ps(center.x);
+    __m128 cy = _mm_set1_ps(center.y);
+    __m128 vr2 = _mm_set1_ps(r2);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(px + i), cx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(py + i), cy);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        int mask = _mm_movemask_ps(_mm_cmple_ps(d2, vr2));
+        for (int k = 0; mask; k++, mask >>= 1)
+        {
+            out[found] = i + k;
+            found += mask & 1;
+        }
+    }
+#endif
+    for (; i < n; i++)
+    {
+        float dx = px[i] - center.x;
+        float dy = py[i] - center.y;
+        out[found] = i;
+        found += dx * dx + dy * dy <= r2;
+    }
+    return found;
+}
@@ -0,0 +1,81 @@
+#ifndef MONSTER_POOL_H
+#define MONSTER_POOL_H
+
+#include "raylib.h"
+#include "entity_pool.h"
+#include "spatial_grid.h"
+#include <stdbool.h>
+
+//==============================================
+//        ХРАНИЛИЩЕ МОНСТРОВ (SoA)
+//==============================================
+// Каждое поле лежит в своём непрерывном массиве, чтобы цикл
+// движения читал только координаты, скорость и таймер удара.
+// Монстр «отброшен», пока hitTimer > 0.
+// В [0, count) только живые монстры: убитый сразу замещается
+// последним, поэтому плотные индексы меняются при удалении —
+// между кадрами монстра держат через EntityHandle.
+
+typedef enum
+{
+    MONSTER_TYPE_BASIC,
+    MONSTER_TYPE_FAST,
+    MONSTER_TYPE_TANK,
+    MONSTER_TYPE_COUNT
+} MonsterType;
+
+typedef struct
+{
+    // горячие данные: читаются каждый кадр
+    float *posX;
+    float *posY;
+    float *speed;
+    float *hitTimer;
+    // холодные данные: нужны только при ударе
+    float *knockX;
+    float *knockY;
+    int *health;
+    unsigned char *type;
+    // положение на прошлом шаге, только для интерполяции при отрисовке
+    float *prevX;
+    float *prevY;
+
+    EntityPool handles;
+    int count;
+    int capacity; // растёт вдвое при заполнении
+} MonsterPool;
+
+bool MonsterPoolInit(MonsterPool *pool, int capacity);
+void MonsterPoolFree(MonsterPool *pool);
+void MonsterPoolClear(MonsterPool *pool);
+EntityHandle MonsterPoolSpawn(MonsterPool *pool, Vector2 position, MonsterType type,
+                              int health, float speed);
+void MonsterPoolDespawn(MonsterPool *pool, EntityHandle handle);
+void MonsterPoolSnapshot(MonsterPool *pool);
+
+// плотный индекс или -1, если монстр уже удалён
+static inline int MonsterPoolIndex(const MonsterPool *pool, EntityHandle handle)
+{
+    return EntityPoolIndex(&pool->handles, handle);
+}
+
+static inline Vector2 MonsterPosition(const MonsterPool *pool, int index)
+{
+    return (Vector2){pool->posX[index], pool->posY[index]};
+}
+
+// движение к цели и отбрасывание для всех монстров сразу;
+// SSE/AVX, если доступны при компиляции, иначе скалярный цикл.
+// grid != NULL — тем же проходом пишет ключи ячеек новых позиций
+// (SpatialGridKeys), остаётся только SpatialGridCommit
+void MonsterPoolSeek(MonsterPool *pool, Vector2 target,
+                     float knockbackSpeed, float delta, SpatialGrid *grid);
+void MonsterPoolSeekScalar(MonsterPool *pool, int begin, int end, Vector2 target,
+                           float knockbackSpeed, float delta,
+                           const SpatialGrid *grid, int *keys);
+
+// номера монстров ближе radius к center по возрастанию — перебор
+// SoA-массивов без сетки; out вмещает count номеров
+int MonsterPoolNear(const MonsterPool *pool, Vector2 center, float radius, int *out);
+
+#endif // MONSTER_POOL_H
@@ -0,0 +1,70 @@
+#ifndef PLATFORM_THREAD_H
+#define PLATFORM_THREAD_H
+
+//==============================================
+//        ПОТОКИ: WIN32 ИЛИ PTHREADS
+//==============================================
+// Только для .c без raylib.h: windows.h конфликтует с ним
+// (Rectangle, DrawText...).
+// Функция потока объявляется как
+//     static ThreadResult THREAD_CALL Main(void *arg)
+
+#include <stdbool.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+typedef HANDLE Thread;
+typedef CRITICAL_SECTION Mutex;
+typedef CONDITION_VARIABLE Cond;
+typedef DWORD ThreadResult;
+#define THREAD_CALL WINAPI
+#define MutexInit(m) InitializeCriticalSection(m)
+#define MutexDestroy(m) DeleteCriticalSection(m)
+#define MutexLock(m) EnterCriticalSection(m)
+#define MutexUnlock(m) LeaveCriticalSection(m)
+#define CondInit(c) InitializeConditionVariable(c)
+#define CondDestroy(c) ((void)(c))
+#define CondWait(c, m) SleepConditionVariableCS(c, m, INFINITE)
+#define CondBroadcast(c) WakeAllConditionVariable(c)
+
+static inline bool ThreadStart(Thread *thread, ThreadResult(THREAD_CALL *main)(void *), void *arg)
+{
+    *thread = CreateThread(NULL, 0, main, arg, 0, NULL);
+    return *thread != NULL;
+}
+
+static inline void ThreadJoin(Thread thread)
+{
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_t Thread;
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t Cond;
+typedef void *ThreadResult;
+#define THREAD_CALL
+#define MutexInit(m) pthread_mutex_init(m, NULL)
+#define MutexDestroy(m) pthread_mutex_destroy(m)
+#define MutexLock(m) pthread_mutex_lock(m)
+#define MutexUnlock(m) pthread_mutex_unlock(m)
+#define CondInit(c) pthread_cond_init(c, NULL)
+#define CondDestroy(c) pthread_cond_destroy(c)
+#define CondWait(c, m) pthread_cond_wait(c, m)
+#define CondBroadcast(c) pthread_cond_broadcast(c)
+
+static inline bool ThreadStart(Thread *thread, ThreadResult (*main)(void *), void *arg)
+{
+    return pthread_create(thread, NULL, main, arg) == 0;
+}
+
+static inline void ThreadJoin(Thread thread)
+{
+    pthread_join(thread, NULL);
+}
+#endif
+
+#endif // PLATFORM_THREAD_H
@@ -0,0 +1,261 @@
+#include "replay.h"
+#include "file_replace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_MAGIC "P7RP"
+#define REPLAY_VERSION 4 // 2: SimulationHash покрывает скорость, отбрасывание и тип монстров
+                         // 3: столкновения с монстрами по возрастанию номера
+                         // 4: SimulationHash покрывает пакетные потоки rng.lanes
+#define REPLAY_MAX_RUN 0xFFFF // длина серии хранится в 2 байтах
+
+//==============================================
+//                  ЗАПИСЬ
+//==============================================
+void ReplayInit(Replay *replay)
+{
+    memset(replay, 0, sizeof(*replay));
+    replay->config = SimDefaultConfig();
+}
+
+void ReplayFree(Replay *replay)
+{
+    free(replay->buttons);
+    free(replay->hashes);
+    memset(replay, 0, sizeof(*replay));
+}
+
+void ReplayBegin(Replay *replay, unsigned long long seed, const SimConfig *config)
+{
+    replay->seed = seed;
+    replay->config = config ? *config : SimDefaultConfig();
+    replay->tickCount = 0;
+}
+
+static bool ReplayReserve(Replay *replay, int capacity)
+{
+    if (capacity <= replay->capacity)
+        return true;
+    int cap = replay->capacity ? replay->capacity : 60 * 60; // минута игры
+    while (cap < capacity)
+        cap *= 2;
+    unsigned char *buttons = realloc(replay->buttons, cap);
+    if (buttons)
+        replay->buttons = buttons;
+    unsigned int *hashes = realloc(replay->hashes, cap * sizeof(unsigned int));
+    if (hashes)
+        replay->hashes = hashes;
+    if (!buttons || !hashes)
+        return false;
+    replay->capacity = cap;
+    return true;
+}
+
+bool ReplayRecord(Replay *replay, SimInput input, unsigned int hash)
+{
+    if (!ReplayReserve(replay, replay->tickCount + 1))
+        return false;
+    replay->buttons[replay->tickCount] = (unsigned char)input.buttons;
+    replay->hashes[replay->tickCount] = hash;
+    replay->tickCount++;
+    return true;
+}
+
+//==============================================
+//                   ФАЙЛ
+//==============================================
+// запись идёт в буфер нужного размера, *p сдвигается за записанным
+static void PutU16(unsigned char **p, unsigned int v)
+{
+    unsigned char *b = *p;
+    b[0] = v & 0xFF;
+    b[1] = (v >> 8) & 0xFF;
+    *p += 2;
+}
+
+static void PutU32(unsigned char **p, unsigned int v)
+{
+    unsigned char *b = *p;
+    b[0] = v & 0xFF;
+    b[1] = (v >> 8) & 0xFF;
+    b[2] = (v >> 16) & 0xFF;
+    b[3] = v >> 24;
+    *p += 4;
+}
+
+static void PutF32(unsigned char **p, float v)
+{
+    unsigned int u;
+    memcpy(&u, &v, 4);
+    PutU32(p, u);
+}
+
+static bool GetU16(FILE *f, unsigned int *v)
+{
+    unsigned char b[2];
+    if (fread(b, 1, 2, f) != 2)
+        return false;
+    *v = b[0] | (unsigned int)b[1] << 8;
+    return true;
+}
+
+static bool GetU32(FILE *f, unsigned int *v)
+{
+    unsigned char b[4];
+    if (fread(b, 1, 4, f) != 4)
+        return false;
+    *v = b[0] | (unsigned int)b[1] << 8 | (unsigned int)b[2] << 16 | (unsigned int)b[3] << 24;
+    return true;
+}
+
+static bool GetF32(FILE *f, float *v)
+{
+    unsigned int u;
+    if (!GetU32(f, &u))
+        return false;
+    memcpy(v, &u, 4);
+    return true;
+}
+
+static bool GetI32(FILE *f, int *v)
+{
+    unsigned int u;
+    if (!GetU32(f, &u))
+        return false;
+    *v = (int)u;
+    return true;
+}
+
+// длина серии одинаковых кнопок, начиная с шага i
+static int RunLength(const Replay *replay, int i)
+{
+    int len = 1;
+    while (i + len < replay->tickCount && len < REPLAY_MAX_RUN &&
+           replay->buttons[i + len] == replay->buttons[i])
+        len++;
+    return len;
+}
+
+unsigned char *ReplayEncode(const Replay *replay, size_t *size)
+{
+    unsigned int runs = 0;
+    for (int i = 0; i < replay->tickCount; i += RunLength(replay, i))
+        runs++;
+    *size = 4 + 4 + 8 + 4 + 4 + 4 + MONSTER_TYPE_COUNT * 12 + 4 + 4 +
+            (size_t)runs * 3 + (size_t)replay->tickCount * 4;
+    unsigned char *data = malloc(*size);
+    if (!data)
+        return NULL;
+
+    unsigned char *p = data;
+    memcpy(p, REPLAY_MAGIC, 4);
+    p += 4;
+    PutU32(&p, REPLAY_VERSION);
+    PutU32(&p, (unsigned int)replay->seed);
+    PutU32(&p, (unsigned int)(replay->seed >> 32));
+    PutF32(&p, replay->config.spawnInterval);
+    PutF32(&p, replay->config.spawnGrowthRate);
+    PutU32(&p, MONSTER_TYPE_COUNT);
+    for (int t = 0; t < MONSTER_TYPE_COUNT; t++)
+    {
+        PutU32(&p, (unsigned int)replay->config.monsters[t].health);
+        PutF32(&p, replay->config.monsters[t].speed);
+        PutU32(&p, (unsigned int)replay->config.monsters[t].spawnWeight);
+    }
+    PutU32(&p, (unsigned int)replay->tickCount);
+
+    PutU32(&p, runs);
+    for (int i = 0; i < replay->tickCount;)
+    {
+        int len = RunLength(replay, i);
+        PutU16(&p, (unsigned int)len);
+        *p++ = replay->buttons[i];
+        i += len;
+    }
+    for (int i = 0; i < replay->tickCount; i++)
+        PutU32(&p, replay->hashes[i]);
+    return data;
+}
+
+bool ReplaySave(const Replay *replay, const char *path)
+{
+    size_t size;
+    unsigned char *data = ReplayEncode(replay, &size);
+    char *tmpPath = malloc(strlen(path) + 5);
+    bool ok = data && tmpPath;
+    if (ok)
+    {
+        sprintf(tmpPath, "%s.tmp", path);
+        ok = FileWriteReplace(path, tmpPath, data, size);
+    }
+    free(tmpPath);
+    free(data);
+    return ok;
+}
+
+bool ReplayLoad(Replay *replay, const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    char magic[4];
+    unsigned int version, seedLo = 0, seedHi = 0, typeCount, ticks = 0, runs = 0;
+    bool ok = fread(magic, 1, 4, f) == 4 && memcmp(magic, REPLAY_MAGIC, 4) == 0 &&
+              GetU32(f, &version) && version == REPLAY_VERSION &&
+              GetU32(f, &seedLo) && GetU32(f, &seedHi) &&
+              GetF32(f, &replay->config.spawnInterval) &&
+              GetF32(f, &replay->config.spawnGrowthRate) &&
+              GetU32(f, &typeCount) && typeCount == MONSTER_TYPE_COUNT;
+    for (int t = 0; ok && t < MONSTER_TYPE_COUNT; t++)
+    {
+        MonsterStats *stats = &replay->config.monsters[t];
+        ok = GetI32(f, &stats->health) && GetF32(f, &stats->speed) &&
+             GetI32(f, &stats->spawnWeight);
+    }
+    ok = ok && GetU32(f, &ticks) && ticks <= 0x7FFFFFFF &&
+         GetU32(f, &runs) && ReplayReserve(replay, (int)ticks);
+    replay->seed = (unsigned long long)seedHi << 32 | seedLo;
+    replay->tickCount = 0;
+
+    for (unsigned int r = 0; ok && r < runs; r++)
+    {
+        unsigned int len;
+        int buttons;
+        ok = GetU16(f, &len) && (buttons = fgetc(f)) != EOF &&
+             len <= ticks - (unsigned int)replay->tickCount;
+        if (ok)
+        {
+            memset(replay->buttons + replay->tickCount, buttons, len);
+            replay->tickCount += (int)len;
+        }
+    }
+    ok = ok && replay->tickCount == (int)ticks;
+    for (int i = 0; ok && i < replay->tickCount; i++)
+        ok = GetU32(f, &replay->hashes[i]);
+    fclose(f);
+    if (!ok)
+        replay->tickCount = 0;
+    return ok;
+}
+
+//==============================================
+//               ПРОИГРЫВАНИЕ
+//==============================================
+void ReplayStart(const Replay *replay, SimState *state)
+{
+    state->config = replay->config;
+    SimulationSeed(state, replay->seed);
+    SimulationReset(state);
+}
+
+int ReplayVerify(const Replay *replay, SimState *state)
+{
+    for (int t = 0; t < replay->tickCount; t++)
+    {
+        SimulationStep(state, ReplayInput(replay, t));
+        if (SimulationHash(state) != replay->hashes[t])
+            return t;
+    }
+    return -1;
+}
@@ -0,0 +1,55 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "simulation.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+//==============================================
+//                   РЕПЛЕИ
+//==============================================
+// Симуляция детерминирована, поэтому для повтора игры хватает
+// seed, параметров баланса и кнопок на каждом шаге. Вместе с
+// кнопками пишется SimulationHash после шага: при проигрывании
+// первый несовпавший шаг показывает, где поведение разошлось.
+//
+// В памяти кнопки лежат байтом на шаг, в файле — сериями
+// (длина, кнопки); все числа в файле little-endian.
+
+typedef struct
+{
+    unsigned long long seed;
+    SimConfig config;
+    unsigned char *buttons; // по шагам
+    unsigned int *hashes;   // SimulationHash после каждого шага
+    int tickCount;
+    int capacity;
+} Replay;
+
+void ReplayInit(Replay *replay);
+void ReplayFree(Replay *replay);
+// начинает запись заново; шаги от SimulationSeed(seed) + SimulationReset
+void ReplayBegin(Replay *replay, unsigned long long seed, const SimConfig *config);
+bool ReplayRecord(Replay *replay, SimInput input, unsigned int hash);
+
+// файл целиком в памяти (malloc), NULL без памяти; запись
+// на диск вне кадра — ReplayWriter из replay_writer.h
+unsigned char *ReplayEncode(const Replay *replay, size_t *size);
+// синхронно, через path.tmp и переименование
+bool ReplaySave(const Replay *replay, const char *path);
+bool ReplayLoad(Replay *replay, const char *path);
+
+// переводит уже инициализированный state в начало реплея:
+// параметры баланса из реплея, его seed, SimulationReset
+void ReplayStart(const Replay *replay, SimState *state);
+static inline SimInput ReplayInput(const Replay *replay, int tick)
+{
+    SimInput input = {replay->buttons[tick]};
+    return input;
+}
+
+// прогоняет весь реплей на state после ReplayStart;
+// возвращает номер первого разошедшегося шага или -1
+int ReplayVerify(const Replay *replay, SimState *state);
+
+#endif // REPLAY_H
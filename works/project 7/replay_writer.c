@@ -0,0 +1,110 @@
+#include "replay_writer.h"
+#include "file_replace.h"
+#include "platform_thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct ReplayWriter
+{
+    char *path;
+    char *tmpPath;
+    unsigned char *pending; // ждёт записи, NULL — нечего писать
+    size_t pendingSize;
+
+    Thread writer;
+    Mutex lock;
+    Cond wake; // есть что писать или пора выходить
+    bool quit;
+    bool writerStarted;
+};
+
+// забирает буфер под lock; сам файл пишет уже без него
+static ThreadResult THREAD_CALL WriterMain(void *arg)
+{
+    ReplayWriter *writer = arg;
+
+    MutexLock(&writer->lock);
+    for (;;)
+    {
+        while (!writer->pending && !writer->quit)
+            CondWait(&writer->wake, &writer->lock);
+        if (!writer->pending)
+            break;
+        unsigned char *data = writer->pending;
+        size_t size = writer->pendingSize;
+        writer->pending = NULL;
+        MutexUnlock(&writer->lock);
+
+        FileWriteReplace(writer->path, writer->tmpPath, data, size);
+        free(data);
+
+        MutexLock(&writer->lock);
+    }
+    MutexUnlock(&writer->lock);
+    return 0;
+}
+
+ReplayWriter *ReplayWriterOpen(const char *path)
+{
+    ReplayWriter *writer = calloc(1, sizeof(ReplayWriter));
+    if (!writer)
+        return NULL;
+    size_t n = strlen(path) + 1;
+    writer->path = malloc(n);
+    writer->tmpPath = malloc(n + 4);
+    if (!writer->path || !writer->tmpPath)
+    {
+        free(writer->path);
+        free(writer->tmpPath);
+        free(writer);
+        return NULL;
+    }
+    memcpy(writer->path, path, n);
+    sprintf(writer->tmpPath, "%s.tmp", path);
+
+    MutexInit(&writer->lock);
+    CondInit(&writer->wake);
+    // без потока Submit пишет сам, как ReplaySave
+    writer->writerStarted = ThreadStart(&writer->writer, WriterMain, writer);
+    return writer;
+}
+
+void ReplayWriterClose(ReplayWriter *writer)
+{
+    if (!writer)
+        return;
+    if (writer->writerStarted)
+    {
+        MutexLock(&writer->lock);
+        writer->quit = true;
+        CondBroadcast(&writer->wake);
+        MutexUnlock(&writer->lock);
+        ThreadJoin(writer->writer);
+    }
+    CondDestroy(&writer->wake);
+    MutexDestroy(&writer->lock);
+    free(writer->pending);
+    free(writer->path);
+    free(writer->tmpPath);
+    free(writer);
+}
+
+void ReplayWriterSubmit(ReplayWriter *writer, unsigned char *data, size_t size)
+{
+    if (!data)
+        return;
+    if (!writer->writerStarted)
+    {
+        FileWriteReplace(writer->path, writer->tmpPath, data, size);
+        free(data);
+        return;
+    }
+    MutexLock(&writer->lock);
+    unsigned char *dropped = writer->pending;
+    writer->pending = data;
+    writer->pendingSize = size;
+    CondBroadcast(&writer->wake);
+    MutexUnlock(&writer->lock);
+    free(dropped);
+}
@@ -0,0 +1,28 @@
+#ifndef REPLAY_WRITER_H
+#define REPLAY_WRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+//==============================================
+//          ЗАПИСЬ РЕПЛЕЯ В ФОНЕ
+//==============================================
+// Реплей двухминутной игры — сотни килобайт; конец игры не должен
+// ждать диска. ReplayWriterSubmit только отдаёт готовый буфер
+// (ReplayEncode) потоку записи. Поток пишет path.tmp, сбрасывает
+// его на диск и переименовывает поверх старого файла, как таблица
+// рекордов: прошлый реплей не обрезается раньше, чем готов новый.
+// Если буфер ещё не записан, следующий его вытесняет — на диске
+// нужен только последний.
+
+typedef struct ReplayWriter ReplayWriter;
+
+// запускает поток записи; NULL, если не хватило памяти
+ReplayWriter *ReplayWriterOpen(const char *path);
+// дописывает отданный буфер и останавливает поток
+void ReplayWriterClose(ReplayWriter *writer);
+
+// забирает data (из malloc) себе, в том числе при ошибке
+void ReplayWriterSubmit(ReplayWriter *writer, unsigned char *data, size_t size);
+
+#endif // REPLAY_WRITER_H
@@ -0,0 +1,89 @@
+#include "sim_random.h"
+
+static unsigned int Rotl(unsigned int x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+static unsigned long long SplitMix64(unsigned long long *state)
+{
+    unsigned long long z = (*state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+void SimRandomSeed(SimRandom *rng, unsigned long long seed)
+{
+    unsigned long long sm = seed;
+    for (int i = 0; i < 4; i += 2)
+    {
+        unsigned long long z = SplitMix64(&sm);
+        rng->s[i] = (unsigned int)z;
+        rng->s[i + 1] = (unsigned int)(z >> 32);
+    }
+    for (int k = 0; k < 4; k++)
+        for (int l = 0; l < SIM_RANDOM_LANES; l++)
+            rng->lanes[k][l] = (unsigned int)(SplitMix64(&sm) >> 32);
+    // splitmix64 не даёт четыре нуля подряд, но нулевое состояние
+    // xoshiro вырождено, поэтому проверка дешевле сомнений
+    if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0)
+        rng->s[0] = 1;
+    for (int l = 0; l < SIM_RANDOM_LANES; l++)
+        if ((rng->lanes[0][l] | rng->lanes[1][l] | rng->lanes[2][l] | rng->lanes[3][l]) == 0)
+            rng->lanes[0][l] = 1;
+}
+
+unsigned int SimRandomNext(SimRandom *rng)
+{
+    unsigned int *s = rng->s;
+    unsigned int result = Rotl(s[1] * 5, 7) * 9;
+    unsigned int t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = Rotl(s[3], 11);
+    return result;
+}
+
+int SimRandomRange(SimRandom *rng, int bound)
+{
+    // умножение вместо %, смещение не больше bound / 2^32
+    return (int)(((unsigned long long)SimRandomNext(rng) * (unsigned int)bound) >> 32);
+}
+
+// один шаг xoshiro128+ во всех потоках; старшие 24 бита -> [0, 1)
+static void NextLanes(unsigned int (*s)[SIM_RANDOM_LANES], float *out)
+{
+    for (int l = 0; l < SIM_RANDOM_LANES; l++)
+    {
+        unsigned int result = s[0][l] + s[3][l];
+        unsigned int t = s[1][l] << 9;
+        s[2][l] ^= s[0][l];
+        s[3][l] ^= s[1][l];
+        s[1][l] ^= s[2][l];
+        s[0][l] ^= s[3][l];
+        s[2][l] ^= t;
+        s[3][l] = Rotl(s[3][l], 11);
+        out[l] = (float)(result >> 8) * (1.0f / 16777216.0f);
+    }
+}
+
+void SimRandomFillPoints(SimRandom *rng, float *x, float *y, int count,
+                         float width, float height)
+{
+    float u[SIM_RANDOM_LANES], v[SIM_RANDOM_LANES];
+    for (int i = 0; i < count; i += SIM_RANDOM_LANES)
+    {
+        NextLanes(rng->lanes, u);
+        NextLanes(rng->lanes, v);
+        int n = count - i < SIM_RANDOM_LANES ? count - i : SIM_RANDOM_LANES;
+        for (int l = 0; l < n; l++)
+        {
+            x[i + l] = u[l] * width;
+            y[i + l] = v[l] * height;
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef SIM_RANDOM_H
+#define SIM_RANDOM_H
+
+//==============================================
+//          ГЕНЕРАТОР СЛУЧАЙНЫХ ЧИСЕЛ
+//==============================================
+// xoshiro128** со своим состоянием у каждой игры: один и тот же
+// seed даёт одну и ту же последовательность, игры в разных
+// потоках друг другу не мешают. Состояние заполняется из seed
+// через splitmix64, как советуют авторы xoshiro (и как в rprand.h).
+//
+// Для пакетных запросов есть SIM_RANDOM_LANES независимых потоков
+// xoshiro128+: цикл по ним компилятор разворачивает в SIMD.
+
+#define SIM_RANDOM_LANES 8
+
+typedef struct
+{
+    unsigned int s[4];
+    unsigned int lanes[4][SIM_RANDOM_LANES];
+} SimRandom;
+
+void SimRandomSeed(SimRandom *rng, unsigned long long seed);
+unsigned int SimRandomNext(SimRandom *rng);
+
+// равномерно в [0, bound), bound > 0
+int SimRandomRange(SimRandom *rng, int bound);
+
+// count точек, равномерно в [0, width) x [0, height), в массивы x и y
+void SimRandomFillPoints(SimRandom *rng, float *x, float *y, int count,
+                         float width, float height);
+
+#endif // SIM_RANDOM_H
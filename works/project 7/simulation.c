@@ -0,0 +1,430 @@
+#include "simulation.h"
+#include "raymath.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MONSTER_CAPACITY 1024 // начальные ёмкости, дальше хранилища растут сами
+#define BONUS_CAPACITY 64
+
+// С одним запросом за кадр сетка монстров — лишний O(n) проход: ключи
+// в MonsterPoolSeek + Commit дороже, чем MonsterPoolNear по SoA. По
+// bench_grid перебор выигрывает на всём замеренном диапазоне до 100000
+// (SSE2/SSE4.1/AVX), поэтому сетка включается только выше него
+#define SIM_GRID_MIN_MONSTERS (1 << 17)
+
+//==============================================
+//                   СПАВН
+//==============================================
+// тип по весам spawnWeight; -1, если все веса нулевые
+static int RandomMonsterType(SimState *state)
+{
+    const MonsterStats *stats = state->config.monsters;
+    int totalWeight = 0;
+    for (int t = 0; t < MONSTER_TYPE_COUNT; t++)
+        totalWeight += stats[t].spawnWeight;
+    if (totalWeight <= 0)
+        return -1;
+    int r = SimRandomRange(&state->rng, totalWeight);
+    int type = 0;
+    while (r >= stats[type].spawnWeight)
+        r -= stats[type++].spawnWeight;
+    return type;
+}
+
+static void SpawnMonsterAt(SimState *state, Vector2 position, int type)
+{
+    const MonsterStats *stats = &state->config.monsters[type];
+    MonsterPoolSpawn(&state->monsters, position, (MonsterType)type,
+                     stats->health, stats->speed);
+}
+
+static void SpawnMonster(SimState *state)
+{
+    int type = RandomMonsterType(state);
+    if (type < 0)
+        return;
+    Vector2 position = {(float)SimRandomRange(&state->rng, SIM_WORLD_WIDTH),
+                        (float)SimRandomRange(&state->rng, SIM_WORLD_HEIGHT)};
+    SpawnMonsterAt(state, position, type);
+}
+
+static void SpawnBonus(SimState *state, Vector2 position)
+{
+    EntityPool *handles = &state->bonusHandles;
+    if (handles->count == handles->capacity)
+    {
+        int cap = handles->capacity ? handles->capacity * 2 : BONUS_CAPACITY;
+        Bonus *grown = realloc(state->bonuses, cap * sizeof(Bonus));
+        if (!grown)
+            return;
+        state->bonuses = grown;
+        if (!EntityPoolReserve(handles, cap))
+            return;
+    }
+    EntityPoolAcquire(handles);
+    state->bonuses[handles->count - 1] = (Bonus){
+        .position = position,
+        .timer = 5.0f};
+}
+
+static void DespawnBonus(SimState *state, EntityHandle handle)
+{
+    int hole = EntityPoolRelease(&state->bonusHandles, handle);
+    if (hole >= 0 && hole != state->bonusHandles.count)
+        state->bonuses[hole] = state->bonuses[state->bonusHandles.count];
+}
+
+static void MaybeSpawnBonusRandom(SimState *state, float delta)
+{
+    state->bonusTimer += delta;
+    if (state->bonusTimer >= 10.0f)
+    {
+        state->bonusTimer = 0.0f;
+        SpawnBonus(state, (Vector2){
+                              (float)SimRandomRange(&state->rng, SIM_WORLD_WIDTH),
+                              (float)SimRandomRange(&state->rng, SIM_WORLD_HEIGHT)});
+    }
+}
+
+// запрос к сетке может вернуть все сущности сразу
+static bool EnsureScratch(SimState *state, int n)
+{
+    if (n <= state->scratchCapacity)
+        return true;
+    int cap = state->scratchCapacity ? state->scratchCapacity : 256;
+    while (cap < n)
+        cap *= 2;
+    int *query = realloc(state->gridQuery, cap * sizeof(int));
+    if (query)
+        state->gridQuery = query;
+    EntityHandle *queue = realloc(state->despawnQueue, cap * sizeof(EntityHandle));
+    if (queue)
+        state->despawnQueue = queue;
+    if (!query || !queue)
+        return false;
+    state->scratchCapacity = cap;
+    return true;
+}
+
+//==============================================
+//                 СОСТОЯНИЕ
+//==============================================
+SimConfig SimDefaultConfig(void)
+{
+    SimConfig config = {
+        .spawnInterval = 2.0f,
+        .spawnGrowthRate = 0.02f,
+        .monsters = {
+            [MONSTER_TYPE_BASIC] = {.health = 25, .speed = 100, .spawnWeight = 6},
+            [MONSTER_TYPE_FAST] = {.health = 15, .speed = 150, .spawnWeight = 3},
+            [MONSTER_TYPE_TANK] = {.health = 40, .speed = 80, .spawnWeight = 1}}};
+    return config;
+}
+
+bool SimulationInit(SimState *state, const SimConfig *config)
+{
+    memset(state, 0, sizeof(*state));
+    state->config = config ? *config : SimDefaultConfig();
+    bool ok = MonsterPoolInit(&state->monsters, MONSTER_CAPACITY) &&
+              EntityPoolInit(&state->bonusHandles, BONUS_CAPACITY) &&
+              (state->bonuses = malloc(BONUS_CAPACITY * sizeof(Bonus))) != NULL &&
+              // ячейка сетки не меньше диаметра сущности
+              SpatialGridInit(&state->monsterGrid, SIM_WORLD_WIDTH, SIM_WORLD_HEIGHT,
+                              fmaxf(2 * SIM_MONSTER_RADIUS, 32.0f)) &&
+              SpatialGridInit(&state->bonusGrid, SIM_WORLD_WIDTH, SIM_WORLD_HEIGHT,
+                              fmaxf(2 * SIM_BONUS_RADIUS, 32.0f));
+    if (!ok)
+    {
+        SimulationFree(state);
+        return false;
+    }
+    SimulationReset(state);
+    return true;
+}
+
+void SimulationFree(SimState *state)
+{
+    MonsterPoolFree(&state->monsters);
+    EntityPoolFree(&state->bonusHandles);
+    SpatialGridFree(&state->monsterGrid);
+    SpatialGridFree(&state->bonusGrid);
+    free(state->bonuses);
+    free(state->gridQuery);
+    free(state->despawnQueue);
+    memset(state, 0, sizeof(*state));
+}
+
+void SimulationSeed(SimState *state, unsigned long long seed)
+{
+    state->seed = seed;
+    SimRandomSeed(&state->rng, seed);
+}
+
+void SimulationReset(SimState *state)
+{
+    SimRandomSeed(&state->rng, state->seed);
+
+    Player *player = &state->player;
+    player->position = (Vector2){SIM_WORLD_WIDTH / 2, SIM_WORLD_HEIGHT / 2};
+    player->prevPosition = player->position;
+    player->health = 100;
+    player->isAlive = true;
+
+    MonsterPoolClear(&state->monsters);
+    EntityPoolClear(&state->bonusHandles);
+    state->score = 0;
+    state->attackCooldown = 0.0f;
+    state->monsterAttackCooldown = 1.0f;
+    state->spawnTimer = 0.0f;
+    state->spawnInterval = state->config.spawnInterval;
+    state->bonusTimer = 0.0f;
+    state->playerHitTimer = 0.0f;
+    state->flashTimer = 0.0f;
+    state->tick = 0;
+    state->events = 0;
+    state->gameOver = false;
+}
+
+void SimulationSpawnWave(SimState *state, int count)
+{
+    float x[256], y[256];
+    for (int i = 0; i < count; i += 256)
+    {
+        int n = count - i < 256 ? count - i : 256;
+        SimRandomFillPoints(&state->rng, x, y, n, SIM_WORLD_WIDTH, SIM_WORLD_HEIGHT);
+        for (int k = 0; k < n; k++)
+        {
+            int type = RandomMonsterType(state);
+            if (type < 0)
+                return;
+            SpawnMonsterAt(state, (Vector2){x[k], y[k]}, type);
+        }
+    }
+}
+
+//==============================================
+//                    ШАГ
+//==============================================
+static int CompareIndex(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+void SimulationStep(SimState *state, SimInput input)
+{
+    const float delta = SIM_DT;
+    Player *player = &state->player;
+    MonsterPool *monsters = &state->monsters;
+    state->events = 0;
+
+    // эффекты
+    if (state->playerHitTimer > 0)
+        state->playerHitTimer -= delta;
+    if (state->flashTimer > 0)
+        state->flashTimer -= delta;
+
+    if (state->gameOver)
+        return;
+    state->tick++;
+
+    if (player->health <= 0)
+    {
+        player->isAlive = false;
+        state->gameOver = true;
+        state->events |= SIM_EVENT_GAME_OVER;
+        return;
+    }
+
+    player->prevPosition = player->position;
+    MonsterPoolSnapshot(monsters);
+
+    // движение игрока
+    if (input.buttons & SIM_INPUT_UP)
+        player->position.y -= 200 * delta;
+    if (input.buttons & SIM_INPUT_DOWN)
+        player->position.y += 200 * delta;
+    if (input.buttons & SIM_INPUT_LEFT)
+        player->position.x -= 200 * delta;
+    if (input.buttons & SIM_INPUT_RIGHT)
+        player->position.x += 200 * delta;
+
+    // таймеры
+    state->attackCooldown = fmaxf(0, state->attackCooldown - delta);
+    state->monsterAttackCooldown = fmaxf(0, state->monsterAttackCooldown - delta);
+    state->spawnTimer += delta;
+    state->spawnInterval += state->config.spawnGrowthRate * delta;
+
+    // спавн
+    if (state->spawnTimer >= state->spawnInterval)
+    {
+        state->spawnTimer = 0;
+        SpawnMonster(state);
+    }
+    MaybeSpawnBonusRandom(state, delta);
+
+    const float rPlayer = SIM_PLAYER_RADIUS;
+    const float rMonster = SIM_MONSTER_RADIUS;
+    const float rBonus = SIM_BONUS_RADIUS;
+
+    int bonusCount = state->bonusHandles.count;
+    if (!EnsureScratch(state, monsters->count > bonusCount ? monsters->count : bonusCount))
+        return;
+    int *gridQuery = state->gridQuery;
+    EntityHandle *despawnQueue = state->despawnQueue;
+    Bonus *bonuses = state->bonuses;
+
+    // бонусы: обратный обход, удалённый замещается уже пройденным
+    for (int i = state->bonusHandles.count - 1; i >= 0; i--)
+    {
+        bonuses[i].timer -= delta;
+        if (bonuses[i].timer <= 0)
+            DespawnBonus(state, EntityPoolHandleAt(&state->bonusHandles, i));
+    }
+    SpatialGridClear(&state->bonusGrid);
+    for (int i = 0; i < state->bonusHandles.count; i++)
+        SpatialGridInsert(&state->bonusGrid, i, bonuses[i].position);
+    SpatialGridCommit(&state->bonusGrid);
+    int found = SpatialGridQuery(&state->bonusGrid, player->position, rPlayer + rBonus,
+                                 gridQuery, state->scratchCapacity);
+    int pending = 0;
+    for (int k = 0; k < found; k++)
+    {
+        Bonus *b = &bonuses[gridQuery[k]];
+        if (CheckCollisionCircles(player->position, rPlayer,
+                                  b->position, rBonus))
+        {
+            player->health = (int)fmin(player->health + 20, 100);
+            despawnQueue[pending++] = EntityPoolHandleAt(&state->bonusHandles, gridQuery[k]);
+            state->flashTimer = 0.1f;
+            state->events |= SIM_EVENT_BONUS_TAKEN;
+        }
+    }
+    // удаляем после обхода: индексы из запроса ещё нужны
+    for (int k = 0; k < pending; k++)
+        DespawnBonus(state, despawnQueue[k]);
+
+    // монстры: движение и отбрасывание одним проходом,
+    // ключи ячеек сетки (если она нужна) — тем же проходом
+    bool useGrid = monsters->count >= SIM_GRID_MIN_MONSTERS;
+    MonsterPoolSeek(monsters, player->position, 200, delta,
+                    useGrid ? &state->monsterGrid : NULL);
+
+    // монстры: столкновения только с соседями игрока, по возрастанию
+    // номера — от порядка зависят удары и бонусы
+    if (useGrid)
+    {
+        SpatialGridCommit(&state->monsterGrid);
+        found = SpatialGridQuery(&state->monsterGrid, player->position, rPlayer + rMonster,
+                                 gridQuery, state->scratchCapacity);
+        qsort(gridQuery, found, sizeof(int), CompareIndex);
+    }
+    else
+    {
+        // запас в 1 px: точная проверка — CheckCollisionCircles ниже
+        found = MonsterPoolNear(monsters, player->position, rPlayer + rMonster + 1, gridQuery);
+    }
+    pending = 0;
+    for (int k = 0; k < found; k++)
+    {
+        int m = gridQuery[k];
+        Vector2 mPos = MonsterPosition(monsters, m);
+        if (!CheckCollisionCircles(player->position, rPlayer, mPos, rMonster))
+            continue;
+        // атака на игрока
+        if (state->monsterAttackCooldown <= 0)
+        {
+            player->health -= 10;
+            state->monsterAttackCooldown = 1.0f;
+            state->playerHitTimer = 0.2f;
+            state->events |= SIM_EVENT_PLAYER_HURT;
+        }
+        // удар игроком
+        if ((input.buttons & SIM_INPUT_ATTACK) && state->attackCooldown <= 0)
+        {
+            monsters->health[m] -= 10;
+            state->attackCooldown = 0.5f;
+            state->events |= SIM_EVENT_PLAYER_ATTACK;
+            // эффект knockback от игрока
+            Vector2 knock = Vector2Normalize(Vector2Subtract(mPos, player->position));
+            monsters->hitTimer[m] = 0.2f;
+            monsters->knockX[m] = knock.x;
+            monsters->knockY[m] = knock.y;
+        }
+        // смерть
+        if (monsters->health[m] <= 0)
+        {
+            despawnQueue[pending++] = EntityPoolHandleAt(&monsters->handles, m);
+            state->score += 10;
+            SpawnBonus(state, mPos);
+        }
+    }
+    for (int k = 0; k < pending; k++)
+        MonsterPoolDespawn(monsters, despawnQueue[k]);
+}
+
+//==============================================
+//                  ОТПЕЧАТОК
+//==============================================
+// FNV-1a по 32-битным словам: вчетверо меньше умножений, чем по байтам
+static unsigned int HashWords(unsigned int h, const void *data, int words)
+{
+    const unsigned char *bytes = data;
+    for (int i = 0; i < words; i++)
+    {
+        unsigned int w;
+        memcpy(&w, bytes + i * 4, 4); // float читаем как слово без нарушения алиасинга
+        h = (h ^ w) * 16777619u;
+    }
+    return h;
+}
+
+static unsigned int HashFloat(unsigned int h, float f)
+{
+    return HashWords(h, &f, 1);
+}
+
+static unsigned int HashInt(unsigned int h, int i)
+{
+    return HashWords(h, &i, 1);
+}
+
+unsigned int SimulationHash(const SimState *state)
+{
+    unsigned int h = 2166136261u;
+    h = HashWords(h, state->rng.s, 4);
+    h = HashWords(h, state->rng.lanes, 4 * SIM_RANDOM_LANES);
+    h = HashInt(h, (int)state->tick);
+    h = HashFloat(h, state->player.position.x);
+    h = HashFloat(h, state->player.position.y);
+    h = HashInt(h, state->player.health);
+    h = HashInt(h, state->gameOver);
+    h = HashInt(h, state->score);
+    h = HashFloat(h, state->attackCooldown);
+    h = HashFloat(h, state->monsterAttackCooldown);
+    h = HashFloat(h, state->spawnTimer);
+    h = HashFloat(h, state->spawnInterval);
+    h = HashFloat(h, state->bonusTimer);
+
+    const MonsterPool *monsters = &state->monsters;
+    h = HashInt(h, monsters->count);
+    h = HashWords(h, monsters->posX, monsters->count);
+    h = HashWords(h, monsters->posY, monsters->count);
+    h = HashWords(h, monsters->speed, monsters->count);
+    h = HashWords(h, monsters->hitTimer, monsters->count);
+    h = HashWords(h, monsters->knockX, monsters->count);
+    h = HashWords(h, monsters->knockY, monsters->count);
+    h = HashWords(h, monsters->health, monsters->count);
+    for (int i = 0; i < monsters->count; i++)
+        h = HashInt(h, monsters->type[i]);
+
+    h = HashInt(h, state->bonusHandles.count);
+    for (int i = 0; i < state->bonusHandles.count; i++)
+    {
+        h = HashFloat(h, state->bonuses[i].position.x);
+        h = HashFloat(h, state->bonuses[i].position.y);
+        h = HashFloat(h, state->bonuses[i].timer);
+    }
+    return h;
+}
@@ -0,0 +1,131 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "raylib.h"
+#include "monster_pool.h"
+#include "entity_pool.h"
+#include "spatial_grid.h"
+#include "sim_random.h"
+#include <stdbool.h>
+
+//==============================================
+//        СИМУЛЯЦИЯ С ФИКСИРОВАННЫМ ШАГОМ
+//==============================================
+// SimulationStep продвигает игру ровно на SIM_DT и ничего не
+// рисует и не проигрывает: всё, что должен заметить внешний код
+// (звук удара, конец игры), сообщается флагами events.
+// Одинаковые состояние и ввод дают одинаковый результат, поэтому
+// шаги можно крутить без окна с любой скоростью.
+
+#define SIM_DT (1.0f / 60.0f)
+#define SIM_WORLD_WIDTH 800
+#define SIM_WORLD_HEIGHT 600
+
+// масштаб отрисовки спрайтов и радиусы столкновений из него
+// (player.png 308px, monster.png 150px, bonus.png 80px)
+#define SIM_PLAYER_SCALE 0.6f
+#define SIM_MONSTER_SCALE 0.5f
+#define SIM_BONUS_SCALE 0.5f
+#define SIM_PLAYER_RADIUS (308 * SIM_PLAYER_SCALE / 2.0f)
+#define SIM_MONSTER_RADIUS (150 * SIM_MONSTER_SCALE / 2.0f)
+#define SIM_BONUS_RADIUS (80 * SIM_BONUS_SCALE / 2.0f)
+
+// ввод за один шаг — битовая маска
+typedef enum
+{
+    SIM_INPUT_UP = 1 << 0,
+    SIM_INPUT_DOWN = 1 << 1,
+    SIM_INPUT_LEFT = 1 << 2,
+    SIM_INPUT_RIGHT = 1 << 3,
+    SIM_INPUT_ATTACK = 1 << 4
+} SimInputFlags;
+
+typedef struct
+{
+    unsigned int buttons;
+} SimInput;
+
+// что случилось за последний шаг
+typedef enum
+{
+    SIM_EVENT_PLAYER_ATTACK = 1 << 0,
+    SIM_EVENT_PLAYER_HURT = 1 << 1,
+    SIM_EVENT_BONUS_TAKEN = 1 << 2,
+    SIM_EVENT_GAME_OVER = 1 << 3
+} SimEventFlags;
+
+// параметры баланса; SimDefaultConfig — значения из игры
+typedef struct
+{
+    int health;
+    float speed;
+    int spawnWeight; // относительная частота появления
+} MonsterStats;
+
+typedef struct
+{
+    float spawnInterval;   // начальный интервал спавна, с
+    float spawnGrowthRate; // прирост интервала за секунду
+    MonsterStats monsters[MONSTER_TYPE_COUNT];
+} SimConfig;
+
+typedef struct
+{
+    Vector2 position;
+    Vector2 prevPosition; // для интерполяции
+    int health;
+    bool isAlive;
+} Player;
+
+typedef struct
+{
+    Vector2 position;
+    float timer;
+} Bonus;
+
+typedef struct
+{
+    SimConfig config;
+    SimRandom rng;           // весь случайный спавн идёт отсюда
+    unsigned long long seed; // с него rng начинает после SimulationReset
+    Player player;
+    MonsterPool monsters;
+    Bonus *bonuses; // плотно, bonusHandles.count штук
+    EntityPool bonusHandles;
+
+    // broadphase, перестраивается каждый шаг
+    SpatialGrid monsterGrid;
+    SpatialGrid bonusGrid;
+    // буферы запросов к сетке и отложенного удаления
+    int *gridQuery;
+    EntityHandle *despawnQueue;
+    int scratchCapacity;
+
+    int score;
+    float attackCooldown;
+    float monsterAttackCooldown;
+    float spawnTimer;
+    float spawnInterval;
+    float bonusTimer;
+    float playerHitTimer; // подсветка игрока
+    float flashTimer;     // вспышка при подборе бонуса
+
+    unsigned long long tick;
+    unsigned int events;
+    bool gameOver;
+} SimState;
+
+SimConfig SimDefaultConfig(void);
+// config == NULL — параметры по умолчанию
+bool SimulationInit(SimState *state, const SimConfig *config);
+void SimulationFree(SimState *state);
+// новый seed вступает в силу сразу и после каждого SimulationReset
+void SimulationSeed(SimState *state, unsigned long long seed);
+void SimulationReset(SimState *state);
+// count монстров в случайных точках разом (волна арены)
+void SimulationSpawnWave(SimState *state, int count);
+void SimulationStep(SimState *state, SimInput input);
+// отпечаток всего, что влияет на следующие шаги, для проверки реплеев
+unsigned int SimulationHash(const SimState *state);
+
+#endif // SIMULATION_H
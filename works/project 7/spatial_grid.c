@@ -0,0 +1,123 @@
+#include "spatial_grid.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int ClampCell(int v, int maxV)
+{
+    if (v < 0)
+        return 0;
+    if (v > maxV)
+        return maxV;
+    return v;
+}
+
+bool SpatialGridInit(SpatialGrid *grid, float worldWidth, float worldHeight, float cellSize)
+{
+    memset(grid, 0, sizeof(*grid));
+    grid->cellSize = cellSize;
+    grid->invCellSize = 1.0f / cellSize;
+    grid->cols = (int)(worldWidth / cellSize) + 1;
+    grid->rows = (int)(worldHeight / cellSize) + 1;
+    grid->cellStart = calloc((size_t)(grid->cols * grid->rows + 1), sizeof(int));
+    return grid->cellStart != NULL;
+}
+
+void SpatialGridFree(SpatialGrid *grid)
+{
+    free(grid->cellStart);
+    free(grid->cellItems);
+    free(grid->itemCell);
+    free(grid->itemId);
+    memset(grid, 0, sizeof(*grid));
+}
+
+void SpatialGridClear(SpatialGrid *grid)
+{
+    grid->itemCount = 0;
+    grid->denseIds = false;
+}
+
+static bool SpatialGridReserve(SpatialGrid *grid, int count)
+{
+    if (count > grid->itemCapacity)
+    {
+        int cap = grid->itemCapacity ? grid->itemCapacity : 256;
+        while (cap < count)
+            cap *= 2;
+        int *cells = realloc(grid->itemCell, cap * sizeof(int));
+        if (cells)
+            grid->itemCell = cells;
+        int *ids = realloc(grid->itemId, cap * sizeof(int));
+        if (ids)
+            grid->itemId = ids;
+        int *items = realloc(grid->cellItems, cap * sizeof(int));
+        if (items)
+            grid->cellItems = items;
+        if (!cells || !ids || !items)
+            return false;
+        grid->itemCapacity = cap;
+    }
+    return true;
+}
+
+void SpatialGridInsert(SpatialGrid *grid, int id, Vector2 position)
+{
+    if (!SpatialGridReserve(grid, grid->itemCount + 1))
+        return;
+    grid->itemCell[grid->itemCount] = SpatialGridCell(grid, position.x, position.y);
+    grid->itemId[grid->itemCount] = id;
+    grid->itemCount++;
+}
+
+int *SpatialGridKeys(SpatialGrid *grid, int count)
+{
+    grid->itemCount = 0;
+    if (!SpatialGridReserve(grid, count))
+        return NULL;
+    grid->itemCount = count;
+    grid->denseIds = true;
+    return grid->itemCell;
+}
+
+void SpatialGridCommit(SpatialGrid *grid)
+{
+    int cellCount = grid->cols * grid->rows;
+    int *start = grid->cellStart;
+    memset(start, 0, (cellCount + 1) * sizeof(int));
+
+    // гистограмма, затем префиксная сумма
+    for (int i = 0; i < grid->itemCount; i++)
+        start[grid->itemCell[i] + 1]++;
+    for (int c = 0; c < cellCount; c++)
+        start[c + 1] += start[c];
+
+    // раскладка; start[c] временно сдвигается к концу ячейки
+    for (int i = 0; i < grid->itemCount; i++)
+        grid->cellItems[start[grid->itemCell[i]]++] = grid->denseIds ? i : grid->itemId[i];
+    // возвращаем начала ячеек на место
+    for (int c = cellCount; c > 0; c--)
+        start[c] = start[c - 1];
+    start[0] = 0;
+}
+
+int SpatialGridQuery(const SpatialGrid *grid, Vector2 center, float radius,
+                     int *out, int maxOut)
+{
+    if (grid->itemCount == 0)
+        return 0;
+    int x0 = ClampCell((int)((center.x - radius) * grid->invCellSize), grid->cols - 1);
+    int x1 = ClampCell((int)((center.x + radius) * grid->invCellSize), grid->cols - 1);
+    int y0 = ClampCell((int)((center.y - radius) * grid->invCellSize), grid->rows - 1);
+    int y1 = ClampCell((int)((center.y + radius) * grid->invCellSize), grid->rows - 1);
+
+    int n = 0;
+    for (int cy = y0; cy <= y1; cy++)
+    {
+        // ячейки одной строки лежат подряд
+        int first = grid->cellStart[cy * grid->cols + x0];
+        int last = grid->cellStart[cy * grid->cols + x1 + 1];
+        for (int k = first; k < last && n < maxOut; k++)
+            out[n++] = grid->cellItems[k];
+    }
+    return n;
+}
@@ -0,0 +1,53 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "raylib.h"
+#include <math.h>
+#include <stdbool.h>
+
+//==============================================
+//        РАВНОМЕРНАЯ СЕТКА (BROADPHASE)
+//==============================================
+// Сетка перестраивается каждый кадр: сначала все объекты
+// добавляются через SpatialGridInsert (или их ключи ячеек разом
+// пишутся в буфер SpatialGridKeys), затем SpatialGridCommit
+// раскладывает их по ячейкам подсчётной сортировкой за O(n).
+// Запрос возвращает только кандидатов из ячеек, которые
+// пересекает окружность, точную проверку делает вызывающий код.
+// Объекты за пределами мира попадают в крайние ячейки.
+
+typedef struct
+{
+    float cellSize;
+    float invCellSize;
+    int cols;
+    int rows;
+    int *cellStart; // cols*rows + 1 смещений в cellItems
+    int *cellItems; // id объектов, упорядоченные по ячейкам
+    int *itemCell;  // ячейка каждого добавленного объекта
+    int *itemId;
+    int itemCount;
+    int itemCapacity;
+    bool denseIds; // id объекта — его номер, itemId не заполнен
+} SpatialGrid;
+
+bool SpatialGridInit(SpatialGrid *grid, float worldWidth, float worldHeight, float cellSize);
+void SpatialGridFree(SpatialGrid *grid);
+void SpatialGridClear(SpatialGrid *grid);
+void SpatialGridInsert(SpatialGrid *grid, int id, Vector2 position);
+// буфер ключей для объектов с id 0..count-1 вместо count вставок;
+// NULL, если не хватило памяти
+int *SpatialGridKeys(SpatialGrid *grid, int count);
+void SpatialGridCommit(SpatialGrid *grid);
+int SpatialGridQuery(const SpatialGrid *grid, Vector2 center, float radius,
+                     int *out, int maxOut);
+
+// ячейка точки; зажим во float, как в векторном расчёте MonsterPoolSeek
+static inline int SpatialGridCell(const SpatialGrid *grid, float x, float y)
+{
+    float cx = fminf(fmaxf(x * grid->invCellSize, 0.0f), (float)(grid->cols - 1));
+    float cy = fminf(fmaxf(y * grid->invCellSize, 0.0f), (float)(grid->rows - 1));
+    return (int)cy * grid->cols + (int)cx;
+}
+
+#endif // SPATIAL_GRID_H
@@ -0,0 +1,187 @@
+#include "sprite_batch.h"
+#include "rlgl.h"
+#include "raymath.h"
+#include <stdlib.h>
+#include <string.h>
+
+// тот же тип индексов, что передаёт в glDrawElements rlgl
+#if defined(GRAPHICS_API_OPENGL_ES2)
+typedef unsigned short SpriteIndex;
+#define SPRITE_BATCH_MAX_CAPACITY (65536 / 4)
+#else
+typedef unsigned int SpriteIndex;
+#define SPRITE_BATCH_MAX_CAPACITY (1 << 20)
+#endif
+
+bool SpriteBatchInit(SpriteBatch *batch, int capacity)
+{
+    memset(batch, 0, sizeof(*batch));
+    if (capacity > SPRITE_BATCH_MAX_CAPACITY)
+        capacity = SPRITE_BATCH_MAX_CAPACITY;
+    batch->capacity = capacity;
+    batch->vertices = malloc(capacity * 4 * 3 * sizeof(float));
+    batch->texcoords = malloc(capacity * 4 * 2 * sizeof(float));
+    batch->colors = malloc(capacity * 4 * 4);
+    SpriteIndex *indices = malloc(capacity * 6 * sizeof(SpriteIndex));
+    if (!batch->vertices || !batch->texcoords || !batch->colors || !indices)
+    {
+        free(indices);
+        SpriteBatchFree(batch);
+        return false;
+    }
+
+    // z, текстурные координаты и индексы не меняются — заполняем один раз
+    memset(batch->vertices, 0, capacity * 4 * 3 * sizeof(float));
+    for (int i = 0; i < capacity; i++)
+    {
+        float *uv = &batch->texcoords[i * 8];
+        uv[0] = 0, uv[1] = 0;
+        uv[2] = 0, uv[3] = 1;
+        uv[4] = 1, uv[5] = 1;
+        uv[6] = 1, uv[7] = 0;
+
+        SpriteIndex *q = &indices[i * 6];
+        SpriteIndex v = (SpriteIndex)(i * 4);
+        q[0] = v;
+        q[1] = v + 1;
+        q[2] = v + 2;
+        q[3] = v;
+        q[4] = v + 2;
+        q[5] = v + 3;
+    }
+
+    batch->vaoId = rlLoadVertexArray();
+    if (batch->vaoId == 0)
+    {
+        free(indices);
+        return true; // без VAO работает запасной путь
+    }
+    rlEnableVertexArray(batch->vaoId);
+    batch->vboId[0] = rlLoadVertexBuffer(batch->vertices, capacity * 4 * 3 * sizeof(float), true);
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, 3, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+    batch->vboId[1] = rlLoadVertexBuffer(batch->texcoords, capacity * 4 * 2 * sizeof(float), false);
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD, 2, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD);
+    batch->vboId[2] = rlLoadVertexBuffer(batch->colors, capacity * 4 * 4, true);
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR, 4, RL_UNSIGNED_BYTE, true, 0, 0);
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR);
+    batch->eboId = rlLoadVertexBufferElement(indices, capacity * 6 * sizeof(SpriteIndex), false);
+    rlDisableVertexArray();
+    free(indices);
+    return true;
+}
+
+void SpriteBatchFree(SpriteBatch *batch)
+{
+    if (batch->vaoId)
+    {
+        for (int i = 0; i < 3; i++)
+            rlUnloadVertexBuffer(batch->vboId[i]);
+        rlUnloadVertexBuffer(batch->eboId);
+        rlUnloadVertexArray(batch->vaoId);
+    }
+    free(batch->vertices);
+    free(batch->texcoords);
+    free(batch->colors);
+    memset(batch, 0, sizeof(*batch));
+}
+
+// вершины порции: обход квадрата как в DrawTexturePro
+// (левый верх, левый низ, правый низ, правый верх)
+static void FillQuads(SpriteBatch *batch, Texture2D texture,
+                      const float *x, const float *y,
+                      const Color *tints, const float *scales, float scale,
+                      int count)
+{
+    float *v = batch->vertices;
+    unsigned char *c = batch->colors;
+    const float halfW = texture.width * 0.5f;
+    const float halfH = texture.height * 0.5f;
+    for (int i = 0; i < count; i++)
+    {
+        float s = scales ? scales[i] : scale;
+        float x0 = x[i] - halfW * s, x1 = x[i] + halfW * s;
+        float y0 = y[i] - halfH * s, y1 = y[i] + halfH * s;
+        float *q = &v[i * 12];
+        q[0] = x0, q[1] = y0;
+        q[3] = x0, q[4] = y1;
+        q[6] = x1, q[7] = y1;
+        q[9] = x1, q[10] = y0;
+
+        Color tint = tints ? tints[i] : WHITE;
+        for (int k = 0; k < 4; k++)
+            memcpy(&c[i * 16 + k * 4], &tint, 4);
+    }
+}
+
+// запасной путь без VAO: те же квадраты через внутренний пакет rlgl
+static void DrawImmediate(Texture2D texture, const float *x, const float *y,
+                          const Color *tints, const float *scales, float scale,
+                          int count)
+{
+    const float halfW = texture.width * 0.5f;
+    const float halfH = texture.height * 0.5f;
+    rlSetTexture(texture.id);
+    rlBegin(RL_QUADS);
+    for (int i = 0; i < count; i++)
+    {
+        rlCheckRenderBatchLimit(4);
+        float s = scales ? scales[i] : scale;
+        Color tint = tints ? tints[i] : WHITE;
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        rlTexCoord2f(0, 0);
+        rlVertex2f(x[i] - halfW * s, y[i] - halfH * s);
+        rlTexCoord2f(0, 1);
+        rlVertex2f(x[i] - halfW * s, y[i] + halfH * s);
+        rlTexCoord2f(1, 1);
+        rlVertex2f(x[i] + halfW * s, y[i] + halfH * s);
+        rlTexCoord2f(1, 0);
+        rlVertex2f(x[i] + halfW * s, y[i] - halfH * s);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void SpriteBatchDraw(SpriteBatch *batch, Texture2D texture,
+                     const float *x, const float *y,
+                     const Color *tints, const float *scales, float scale,
+                     int count)
+{
+    if (count <= 0)
+        return;
+    if (batch->vaoId == 0)
+    {
+        DrawImmediate(texture, x, y, tints, scales, scale, count);
+        return;
+    }
+
+    // всё, что уже нарисовано через rlgl, должно лечь под спрайты
+    rlDrawRenderBatchActive();
+
+    int *locs = rlGetShaderLocsDefault();
+    float white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    int slot = 0;
+    rlEnableShader(rlGetShaderIdDefault());
+    rlSetUniformMatrix(locs[RL_SHADER_LOC_MATRIX_MVP],
+                       MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    rlSetUniform(locs[RL_SHADER_LOC_COLOR_DIFFUSE], white, RL_SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(locs[RL_SHADER_LOC_MAP_DIFFUSE], &slot, RL_SHADER_UNIFORM_SAMPLER2D, 1);
+    rlActiveTextureSlot(0);
+    rlEnableTexture(texture.id);
+    rlEnableVertexArray(batch->vaoId);
+
+    for (int begin = 0; begin < count; begin += batch->capacity)
+    {
+        int n = count - begin < batch->capacity ? count - begin : batch->capacity;
+        FillQuads(batch, texture, x + begin, y + begin,
+                  tints ? tints + begin : NULL, scales ? scales + begin : NULL, scale, n);
+        rlUpdateVertexBuffer(batch->vboId[0], batch->vertices, n * 4 * 3 * sizeof(float), 0);
+        rlUpdateVertexBuffer(batch->vboId[2], batch->colors, n * 4 * 4, 0);
+        rlDrawVertexArrayElements(0, n * 6, NULL);
+    }
+
+    rlDisableVertexArray();
+    rlDisableTexture();
+    rlDisableShader();
+}
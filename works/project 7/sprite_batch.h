@@ -0,0 +1,43 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+//==============================================
+//            ПАКЕТНАЯ ОТРИСОВКА СПРАЙТОВ
+//==============================================
+// Один вызов рисует много копий одной текстуры: вершины всех
+// квадратов пишутся одним проходом в собственные массивы, затем
+// один glBufferSubData и один glDrawElements на порцию из
+// capacity спрайтов. Внутренний пакет rlgl (его лимиты и
+// промежуточные сбросы) не используется, перед отрисовкой он
+// сбрасывается, чтобы не нарушить порядок наложения.
+//
+// Нужен VAO (OpenGL 3.3 или расширение на ES2); без него
+// спрайты идут по одному через rlBegin/rlVertex.
+// Матрица rlPushMatrix/rlTranslatef не учитывается.
+
+typedef struct
+{
+    unsigned int vaoId;
+    unsigned int vboId[3]; // позиции, текстурные координаты, цвета
+    unsigned int eboId;
+    float *vertices;       // xyz, 4 вершины на спрайт
+    float *texcoords;      // uv, одинаковые у всех спрайтов
+    unsigned char *colors; // rgba
+    int capacity;          // спрайтов в одной порции
+} SpriteBatch;
+
+// вызывать после InitWindow
+bool SpriteBatchInit(SpriteBatch *batch, int capacity);
+void SpriteBatchFree(SpriteBatch *batch);
+
+// count спрайтов с центрами в (x[i], y[i]);
+// tints == NULL — все WHITE, scales == NULL — у всех scale
+void SpriteBatchDraw(SpriteBatch *batch, Texture2D texture,
+                     const float *x, const float *y,
+                     const Color *tints, const float *scales, float scale,
+                     int count);
+
+#endif // SPRITE_BATCH_H
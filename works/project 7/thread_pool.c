@@ -0,0 +1,143 @@
+#include "thread_pool.h"
+#include "platform_thread.h"
+#include <stdlib.h>
+
+struct ThreadPool
+{
+    Thread *threads;
+    int threadCount;
+
+    Mutex lock;
+    Cond workReady; // появилась работа или пора выходить
+    Cond workDone;  // последняя задача завершена
+
+    ThreadPoolTask task;
+    void *userData;
+    int next;    // следующий невыданный индекс
+    int count;   // индексов в текущей раздаче
+    int running; // выданных, но не завершённых
+    unsigned int generation;
+    bool quit;
+};
+
+int ThreadPoolCpuCount(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+// берёт индексы текущей раздачи, пока они есть; вызывается под lock
+static void DrainTasks(ThreadPool *pool)
+{
+    while (pool->next < pool->count)
+    {
+        int index = pool->next++;
+        pool->running++;
+        ThreadPoolTask task = pool->task;
+        void *userData = pool->userData;
+        MutexUnlock(&pool->lock);
+        task(userData, index);
+        MutexLock(&pool->lock);
+        pool->running--;
+    }
+    if (pool->running == 0)
+        CondBroadcast(&pool->workDone);
+}
+
+static ThreadResult THREAD_CALL WorkerMain(void *arg)
+{
+    ThreadPool *pool = arg;
+    unsigned int seen = 0;
+    MutexLock(&pool->lock);
+    for (;;)
+    {
+        while (!pool->quit && pool->generation == seen)
+            CondWait(&pool->workReady, &pool->lock);
+        if (pool->quit)
+            break;
+        seen = pool->generation;
+        DrainTasks(pool);
+    }
+    MutexUnlock(&pool->lock);
+    return 0;
+}
+
+ThreadPool *ThreadPoolCreate(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = ThreadPoolCpuCount();
+    ThreadPool *pool = calloc(1, sizeof(ThreadPool));
+    if (!pool)
+        return NULL;
+    pool->threads = calloc(threadCount, sizeof(Thread));
+    if (!pool->threads)
+    {
+        free(pool);
+        return NULL;
+    }
+    MutexInit(&pool->lock);
+    CondInit(&pool->workReady);
+    CondInit(&pool->workDone);
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        if (!ThreadStart(&pool->threads[i], WorkerMain, pool))
+            break;
+        pool->threadCount++;
+    }
+    if (pool->threadCount == 0)
+    {
+        ThreadPoolDestroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void ThreadPoolDestroy(ThreadPool *pool)
+{
+    if (!pool)
+        return;
+    MutexLock(&pool->lock);
+    pool->quit = true;
+    CondBroadcast(&pool->workReady);
+    MutexUnlock(&pool->lock);
+    for (int i = 0; i < pool->threadCount; i++)
+        ThreadJoin(pool->threads[i]);
+    CondDestroy(&pool->workReady);
+    CondDestroy(&pool->workDone);
+    MutexDestroy(&pool->lock);
+    free(pool->threads);
+    free(pool);
+}
+
+int ThreadPoolSize(const ThreadPool *pool)
+{
+    return pool->threadCount;
+}
+
+void ThreadPoolParallelFor(ThreadPool *pool, int count,
+                           ThreadPoolTask task, void *userData)
+{
+    if (count <= 0)
+        return;
+    MutexLock(&pool->lock);
+    pool->task = task;
+    pool->userData = userData;
+    pool->next = 0;
+    pool->count = count;
+    pool->running = 0;
+    pool->generation++;
+    CondBroadcast(&pool->workReady);
+
+    // вызывающий поток тоже работает, а затем ждёт остальных
+    DrainTasks(pool);
+    while (pool->next < pool->count || pool->running > 0)
+        CondWait(&pool->workDone, &pool->lock);
+    MutexUnlock(&pool->lock);
+}
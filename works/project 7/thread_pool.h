@@ -0,0 +1,26 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdbool.h>
+
+//==============================================
+//                 ПУЛ ПОТОКОВ
+//==============================================
+// Потоки создаются один раз. ThreadPoolParallelFor раздаёт
+// индексы [0, count) свободным потокам по одному и ждёт, пока
+// все задачи завершатся. Рассчитан на крупные задачи (целая
+// игра, полоса изображения), поэтому общий счётчик под мьютексом.
+
+typedef void (*ThreadPoolTask)(void *userData, int index);
+
+typedef struct ThreadPool ThreadPool;
+
+int ThreadPoolCpuCount(void);
+// threadCount <= 0 — по числу ядер
+ThreadPool *ThreadPoolCreate(int threadCount);
+void ThreadPoolDestroy(ThreadPool *pool);
+int ThreadPoolSize(const ThreadPool *pool);
+void ThreadPoolParallelFor(ThreadPool *pool, int count,
+                           ThreadPoolTask task, void *userData);
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,851 @@
+// image_bench.cpp
+// Headless timings of the CPU image functions of the vendored raylib
+// (rtextures.c). No window is opened; only Image calls are made.
+// --formats converts a noise image between every pair of uncompressed
+// pixel formats, once through ImageFormat and once through the float
+// path ImageFormat used for every pair before, and checks that both give
+// the same bytes.
+// --resize times ImageResizeNN and ImageResize on images from 512 pixels
+// up to --size, against the single threaded code they replaced. Linear
+// results must match the old ones; nearest-neighbor results must match a
+// plain pixel copy, which the old code missed for gray images (their
+// round trip through Color loses some levels).
+// --blur times ImageBlurGaussian against the float blur it replaced for
+// several radii, and measures how far each lands from the same blur done
+// in doubles and rounded once.
+// --convolve times ImageKernelConvolution against the float convolution it
+// replaced, for blur, sharpen, emboss and edge kernels from 3 x 3 to
+// 15 x 15, and checks it lands within one level of the same convolution
+// done in doubles (pixels outside the image counting as zero).
+// --draw times the ImageDraw* shape functions against the pixel by pixel
+// drawing they replaced, on several formats, and checks both draw the
+// same bytes. It also checks blended spans against ColorAlphaBlend and
+// that threads drawing on separate bands give the single thread image.
+#include "raylib.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// ========================
+// Options
+// ========================
+
+struct BenchOptions {
+	int size = 1024;          // width and height of the test images
+	int reps = 3;             // best of
+	bool formats = false;
+	bool resize = false;
+	bool blur = false;
+	bool convolve = false;
+	bool draw = false;
+};
+
+static void usage() {
+	printf("usage: image_bench [options] MODE\n"
+		"  --size N           test images are N x N pixels (1024)\n"
+		"  --reps N           report the best of N runs (3)\n"
+		"modes:\n"
+		"  --formats          ImageFormat between every pair of uncompressed formats\n"
+		"  --resize           ImageResizeNN and ImageResize, 512 pixels up to --size\n"
+		"  --blur             ImageBlurGaussian with radii 1 to 64\n"
+		"  --convolve         ImageKernelConvolution with kernels from 3 x 3 to 15 x 15\n"
+		"  --draw             ImageDraw* rectangles, circles, lines and triangles\n");
+}
+
+static bool parseOptions(int argc, char** argv, BenchOptions& o) {
+	for (int i = 1; i < argc; i++) {
+		const char* a = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		if (!strcmp(a, "--size") && value) o.size = atoi(argv[++i]);
+		else if (!strcmp(a, "--reps") && value) o.reps = atoi(argv[++i]);
+		else if (!strcmp(a, "--formats")) o.formats = true;
+		else if (!strcmp(a, "--resize")) o.resize = true;
+		else if (!strcmp(a, "--blur")) o.blur = true;
+		else if (!strcmp(a, "--convolve")) o.convolve = true;
+		else if (!strcmp(a, "--draw")) o.draw = true;
+		else return false;
+	}
+	return o.size > 0 && o.reps > 0 && (o.formats || o.resize || o.blur || o.convolve || o.draw);
+}
+
+static double nowMs() {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Best time of reps runs of f on a fresh copy of image; the last result is kept in out.
+template <typename F>
+static double timeOnCopy(const BenchOptions& o, Image image, Image& out, F f) {
+	double best = 1e30;
+	for (int rep = 0; rep < o.reps; rep++) {
+		if (rep > 0) UnloadImage(out);
+		out = ImageCopy(image);
+		double t0 = nowMs();
+		f(&out);
+		best = std::min(best, nowMs() - t0);
+	}
+	return best;
+}
+
+static bool sameImage(Image a, Image b) {
+	if (a.width != b.width || a.height != b.height || a.format != b.format) return false;
+	return memcmp(a.data, b.data, GetPixelDataSize(a.width, a.height, a.format)) == 0;
+}
+
+static Image noiseImage(int size, unsigned seed) {
+	Image image = GenImageColor(size, size, BLANK);
+	unsigned char* p = (unsigned char*)image.data;
+	for (int i = 0; i < size * size * 4; i++) {
+		seed = seed * 1664525u + 1013904223u;
+		p[i] = (unsigned char)(seed >> 24);
+	}
+	return image;
+}
+
+// ========================
+// Formats
+// ========================
+
+static const char* formatNames[] = { "", "gray", "gray+a", "r5g6b5", "rgb8", "r5g5b5a1", "rgba4", "rgba8",
+	"r32", "rgb32", "rgba32", "r16", "rgb16", "rgba16" };
+
+static float halfToFloat(unsigned short x) {
+	const unsigned int e = (x & 0x7C00) >> 10;
+	const unsigned int m = (x & 0x03FF) << 13;
+	float fm = (float)m;
+	unsigned int ui;
+	memcpy(&ui, &fm, 4);
+	const unsigned int v = ui >> 23;
+	ui = (x & 0x8000) << 16 | (e != 0) * ((e + 112) << 23 | m) | ((e == 0) & (m != 0)) * ((v - 37) << 23 | ((m << (150 - v)) & 0x007FE000));
+	memcpy(&fm, &ui, 4);
+	return fm;
+}
+
+static unsigned short floatToHalf(float x) {
+	unsigned int ui;
+	memcpy(&ui, &x, 4);
+	const unsigned int b = ui + 0x00001000;
+	const unsigned int e = (b & 0x7F800000) >> 23;
+	const unsigned int m = b & 0x007FFFFF;
+	return (unsigned short)((b & 0x80000000) >> 16 | (e > 112) * ((((e - 112) << 10) & 0x7C00) | m >> 13) | ((e < 113) & (e > 101)) * ((((0x007FF000 + m) >> (125 - e)) + 1) >> 1) | (e > 143) * 0x7FFF);
+}
+
+// Pixel i widened to normalized floats, as rtextures.c LoadImageDataNormalized does.
+static Vector4 loadNormalized(const void* data, int format, int i) {
+	const unsigned char* u8 = (const unsigned char*)data;
+	const unsigned short* u16 = (const unsigned short*)data;
+	const float* f32 = (const float*)data;
+	switch (format) {
+	case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: { float g = (float)u8[i] / 255.0f; return { g, g, g, 1.0f }; }
+	case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA: { float g = (float)u8[i * 2] / 255.0f; return { g, g, g, (float)u8[i * 2 + 1] / 255.0f }; }
+	case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
+		return { (float)(u16[i] >> 11) * (1.0f / 31), (float)((u16[i] >> 5) & 63) * (1.0f / 63), (float)(u16[i] & 31) * (1.0f / 31), 1.0f };
+	case PIXELFORMAT_UNCOMPRESSED_R8G8B8: return { (float)u8[i * 3] / 255.0f, (float)u8[i * 3 + 1] / 255.0f, (float)u8[i * 3 + 2] / 255.0f, 1.0f };
+	case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+		return { (float)(u16[i] >> 11) * (1.0f / 31), (float)((u16[i] >> 6) & 31) * (1.0f / 31), (float)((u16[i] >> 1) & 31) * (1.0f / 31), (u16[i] & 1) ? 1.0f : 0.0f };
+	case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
+		return { (float)(u16[i] >> 12) * (1.0f / 15), (float)((u16[i] >> 8) & 15) * (1.0f / 15), (float)((u16[i] >> 4) & 15) * (1.0f / 15), (float)(u16[i] & 15) * (1.0f / 15) };
+	case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8:
+		return { (float)u8[i * 4] / 255.0f, (float)u8[i * 4 + 1] / 255.0f, (float)u8[i * 4 + 2] / 255.0f, (float)u8[i * 4 + 3] / 255.0f };
+	case PIXELFORMAT_UNCOMPRESSED_R32: return { f32[i], 0.0f, 0.0f, 1.0f };
+	case PIXELFORMAT_UNCOMPRESSED_R32G32B32: return { f32[i * 3], f32[i * 3 + 1], f32[i * 3 + 2], 1.0f };
+	case PIXELFORMAT_UNCOMPRESSED_R32G32B32A32: return { f32[i * 4], f32[i * 4 + 1], f32[i * 4 + 2], f32[i * 4 + 3] };
+	case PIXELFORMAT_UNCOMPRESSED_R16: return { halfToFloat(u16[i]), 0.0f, 0.0f, 1.0f };
+	case PIXELFORMAT_UNCOMPRESSED_R16G16B16: return { halfToFloat(u16[i * 3]), halfToFloat(u16[i * 3 + 1]), halfToFloat(u16[i * 3 + 2]), 1.0f };
+	case PIXELFORMAT_UNCOMPRESSED_R16G16B16A16:
+		return { halfToFloat(u16[i * 4]), halfToFloat(u16[i * 4 + 1]), halfToFloat(u16[i * 4 + 2]), halfToFloat(u16[i * 4 + 3]) };
+	default: return { 0.0f, 0.0f, 0.0f, 0.0f };
+	}
+}
+
+// Pixel i narrowed from normalized floats, as the float path of ImageFormat does.
+static void storeNormalized(void* data, int format, int i, Vector4 p) {
+	unsigned char* u8 = (unsigned char*)data;
+	unsigned short* u16 = (unsigned short*)data;
+	float* f32 = (float*)data;
+	float gray = p.x * 0.299f + p.y * 0.587f + p.z * 0.114f;
+	switch (format) {
+	case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: u8[i] = (unsigned char)(gray * 255.0f); break;
+	case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA: u8[i * 2] = (unsigned char)(gray * 255.0f); u8[i * 2 + 1] = (unsigned char)(p.w * 255.0f); break;
+	case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
+		u16[i] = (unsigned short)((unsigned char)round(p.x * 31.0f) << 11 | (unsigned char)round(p.y * 63.0f) << 5 | (unsigned char)round(p.z * 31.0f));
+		break;
+	case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
+		u8[i * 3] = (unsigned char)(p.x * 255.0f); u8[i * 3 + 1] = (unsigned char)(p.y * 255.0f); u8[i * 3 + 2] = (unsigned char)(p.z * 255.0f);
+		break;
+	case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+		u16[i] = (unsigned short)((unsigned char)round(p.x * 31.0f) << 11 | (unsigned char)round(p.y * 31.0f) << 6 | (unsigned char)round(p.z * 31.0f) << 1
+			| (p.w > 50.0f / 255.0f ? 1 : 0));
+		break;
+	case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
+		u16[i] = (unsigned short)((unsigned char)round(p.x * 15.0f) << 12 | (unsigned char)round(p.y * 15.0f) << 8 | (unsigned char)round(p.z * 15.0f) << 4
+			| (unsigned char)round(p.w * 15.0f));
+		break;
+	case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8:
+		u8[i * 4] = (unsigned char)(p.x * 255.0f); u8[i * 4 + 1] = (unsigned char)(p.y * 255.0f);
+		u8[i * 4 + 2] = (unsigned char)(p.z * 255.0f); u8[i * 4 + 3] = (unsigned char)(p.w * 255.0f);
+		break;
+	case PIXELFORMAT_UNCOMPRESSED_R32: f32[i] = gray; break;
+	case PIXELFORMAT_UNCOMPRESSED_R32G32B32: f32[i * 3] = p.x; f32[i * 3 + 1] = p.y; f32[i * 3 + 2] = p.z; break;
+	case PIXELFORMAT_UNCOMPRESSED_R32G32B32A32: f32[i * 4] = p.x; f32[i * 4 + 1] = p.y; f32[i * 4 + 2] = p.z; f32[i * 4 + 3] = p.w; break;
+	case PIXELFORMAT_UNCOMPRESSED_R16: u16[i] = floatToHalf(gray); break;
+	case PIXELFORMAT_UNCOMPRESSED_R16G16B16: u16[i * 3] = floatToHalf(p.x); u16[i * 3 + 1] = floatToHalf(p.y); u16[i * 3 + 2] = floatToHalf(p.z); break;
+	case PIXELFORMAT_UNCOMPRESSED_R16G16B16A16:
+		u16[i * 4] = floatToHalf(p.x); u16[i * 4 + 1] = floatToHalf(p.y); u16[i * 4 + 2] = floatToHalf(p.z); u16[i * 4 + 3] = floatToHalf(p.w);
+		break;
+	default: break;
+	}
+}
+
+// The whole image through a normalized float copy, like ImageFormat before the direct converters.
+static void floatFormat(Image* image, int newFormat) {
+	int count = image->width * image->height;
+	Vector4* pixels = (Vector4*)malloc(count * sizeof(Vector4));
+	for (int i = 0; i < count; i++) pixels[i] = loadNormalized(image->data, image->format, i);
+	free(image->data);
+	image->data = malloc(GetPixelDataSize(image->width, image->height, newFormat));
+	image->format = newFormat;
+	for (int i = 0; i < count; i++) storeNormalized(image->data, newFormat, i, pixels[i]);
+	free(pixels);
+}
+
+static bool runFormatBench(const BenchOptions& o) {
+	printf("%d x %d pixels, best of %d\n%-9s %-9s %10s %10s %8s\n", o.size, o.size, o.reps, "from", "to", "float ms", "direct ms", "speedup");
+	Image noise = noiseImage(o.size, 1);
+	int differing = 0;
+	double floatTotal = 0, directTotal = 0;
+	for (int from = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE; from <= PIXELFORMAT_UNCOMPRESSED_R16G16B16A16; from++) {
+		Image source = ImageCopy(noise);
+		ImageFormat(&source, from);
+		for (int to = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE; to <= PIXELFORMAT_UNCOMPRESSED_R16G16B16A16; to++) {
+			if (to == from) continue;
+			Image expected, actual;
+			double floatMs = timeOnCopy(o, source, expected, [&](Image* image) { floatFormat(image, to); });
+			double directMs = timeOnCopy(o, source, actual, [&](Image* image) { ImageFormat(image, to); });
+			bool same = sameImage(expected, actual);
+			differing += !same;
+			floatTotal += floatMs;
+			directTotal += directMs;
+			printf("%-9s %-9s %10.2f %10.2f %7.1fx%s\n", formatNames[from], formatNames[to], floatMs, directMs, floatMs / directMs, same ? "" : "  DIFFERENT");
+			UnloadImage(expected);
+			UnloadImage(actual);
+		}
+		UnloadImage(source);
+	}
+	UnloadImage(noise);
+	printf("all pairs: float %.1f ms, ImageFormat %.1f ms; %d pairs with different results\n", floatTotal, directTotal, differing);
+	return differing == 0;
+}
+
+// ========================
+// Resize
+// ========================
+
+// stb_image_resize2 is compiled into raylib with external linkage; this
+// single call on the calling thread is what ImageResize used to make.
+extern "C" unsigned char* stbir_resize_uint8_linear(const unsigned char* input, int inputWidth, int inputHeight, int inputStride,
+	unsigned char* output, int outputWidth, int outputHeight, int outputStride, int layout);
+
+// ImageResizeNN before the direct copy: through a Color copy and back.
+static void oldResizeNN(Image* image, int newWidth, int newHeight) {
+	Color* pixels = LoadImageColors(*image);
+	Color* output = (Color*)malloc(newWidth * newHeight * sizeof(Color));
+	int xRatio = (int)((image->width << 16) / newWidth) + 1;
+	int yRatio = (int)((image->height << 16) / newHeight) + 1;
+	for (int y = 0; y < newHeight; y++)
+		for (int x = 0; x < newWidth; x++)
+			output[y * newWidth + x] = pixels[((y * yRatio) >> 16) * image->width + ((x * xRatio) >> 16)];
+	int format = image->format;
+	free(image->data);
+	image->data = output;
+	image->width = newWidth;
+	image->height = newHeight;
+	image->format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+	ImageFormat(image, format);
+	UnloadImageColors(pixels);
+}
+
+// Nearest-neighbor sampling copying pixel bytes, the result ImageResizeNN must give.
+static Image referenceResizeNN(Image image, int newWidth, int newHeight) {
+	int pixelSize = GetPixelDataSize(1, 1, image.format);
+	Image out = image;
+	out.data = malloc((size_t)newWidth * newHeight * pixelSize);
+	out.width = newWidth;
+	out.height = newHeight;
+	int xRatio = (int)((image.width << 16) / newWidth) + 1;
+	int yRatio = (int)((image.height << 16) / newHeight) + 1;
+	for (int y = 0; y < newHeight; y++)
+		for (int x = 0; x < newWidth; x++)
+			memcpy((unsigned char*)out.data + ((size_t)y * newWidth + x) * pixelSize,
+				(unsigned char*)image.data + ((size_t)((y * yRatio) >> 16) * image.width + ((x * xRatio) >> 16)) * pixelSize, pixelSize);
+	return out;
+}
+
+static void oldResize(Image* image, int newWidth, int newHeight) {
+	int channels = GetPixelDataSize(1, 1, image->format);
+	unsigned char* output = (unsigned char*)malloc(newWidth * newHeight * channels);
+	stbir_resize_uint8_linear((unsigned char*)image->data, image->width, image->height, 0, output, newWidth, newHeight, 0, channels);
+	free(image->data);
+	image->data = output;
+	image->width = newWidth;
+	image->height = newHeight;
+}
+
+static bool runResizeBench(const BenchOptions& o) {
+	printf("best of %d\n%-6s %-6s %-16s %10s %10s %8s\n", o.reps, "size", "format", "call", "old ms", "new ms", "speedup");
+	int differing = 0;
+	for (int size = 512; size <= o.size; size *= 2) {
+		for (int format : { PIXELFORMAT_UNCOMPRESSED_GRAYSCALE, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 }) {
+			Image source = noiseImage(size, 3);
+			ImageFormat(&source, format);
+			for (int scaled : { size / 2, size * 3 / 2 }) {
+				char call[32];
+				for (int nn = 1; nn >= 0; nn--) {
+					Image expected, actual;
+					double oldMs, newMs;
+					if (nn) {
+						oldMs = timeOnCopy(o, source, expected, [&](Image* image) { oldResizeNN(image, scaled, scaled); });
+						newMs = timeOnCopy(o, source, actual, [&](Image* image) { ImageResizeNN(image, scaled, scaled); });
+					} else {
+						oldMs = timeOnCopy(o, source, expected, [&](Image* image) { oldResize(image, scaled, scaled); });
+						newMs = timeOnCopy(o, source, actual, [&](Image* image) { ImageResize(image, scaled, scaled); });
+					}
+					if (nn) {
+						UnloadImage(expected);
+						expected = referenceResizeNN(source, scaled, scaled);
+					}
+					bool same = sameImage(expected, actual);
+					differing += !same;
+					snprintf(call, sizeof(call), "%s to %d", nn ? "NN" : "linear", scaled);
+					printf("%-6d %-6s %-16s %10.2f %10.2f %7.1fx%s\n", size, formatNames[format], call, oldMs, newMs, oldMs / newMs, same ? "" : "  DIFFERENT");
+					UnloadImage(expected);
+					UnloadImage(actual);
+				}
+			}
+			UnloadImage(source);
+		}
+	}
+	printf("%d resizes with different results\n", differing);
+	return differing == 0;
+}
+
+// ========================
+// Blur
+// ========================
+
+// ImageBlurGaussian before the integer blur: box passes over two float
+// copies of the image, GAUSSIAN_BLUR_ITERATIONS (4) times.
+static void oldBlurGaussian(Image* image, int blurSize) {
+	ImageAlphaPremultiply(image);
+	Color* pixels = LoadImageColors(*image);
+	int w = image->width, h = image->height;
+	std::vector<Vector4> copy1(w * h), copy2(w * h);
+	for (int i = 0; i < w * h; i++) copy1[i] = { (float)pixels[i].r, (float)pixels[i].g, (float)pixels[i].b, (float)pixels[i].a };
+	auto add = [](Vector4& sum, const Vector4& v, float sign) {
+		sum.x += sign * v.x; sum.y += sign * v.y; sum.z += sign * v.z; sum.w += sign * v.w;
+	};
+	for (int j = 0; j < 4; j++) {
+		for (int row = 0; row < h; row++) {
+			Vector4 avg = { 0, 0, 0, 0 };
+			int n = blurSize;
+			for (int i = 0; i < blurSize; i++) add(avg, copy1[row * w + i], 1);
+			for (int x = 0; x < w; x++) {
+				if (x - blurSize - 1 >= 0) { add(avg, copy1[row * w + x - blurSize - 1], -1); n--; }
+				if (x + blurSize < w) { add(avg, copy1[row * w + x + blurSize], 1); n++; }
+				copy2[row * w + x] = { avg.x / n, avg.y / n, avg.z / n, avg.w / n };
+			}
+		}
+		for (int col = 0; col < w; col++) {
+			Vector4 avg = { 0, 0, 0, 0 };
+			int n = blurSize;
+			for (int i = 0; i < blurSize; i++) add(avg, copy2[i * w + col], 1);
+			for (int y = 0; y < h; y++) {
+				if (y - blurSize - 1 >= 0) { add(avg, copy2[(y - blurSize - 1) * w + col], -1); n--; }
+				if (y + blurSize < h) { add(avg, copy2[(y + blurSize) * w + col], 1); n++; }
+				copy1[y * w + col] = { (float)(unsigned char)(avg.x / n), (float)(unsigned char)(avg.y / n),
+					(float)(unsigned char)(avg.z / n), (float)(unsigned char)(avg.w / n) };
+			}
+		}
+	}
+	for (int i = 0; i < w * h; i++) {
+		if (copy1[i].w == 0.0f) pixels[i] = { 0, 0, 0, 0 };
+		else {
+			float alpha = copy1[i].w / 255.0f;
+			pixels[i] = { (unsigned char)(copy1[i].x / alpha), (unsigned char)(copy1[i].y / alpha), (unsigned char)(copy1[i].z / alpha), (unsigned char)copy1[i].w };
+		}
+	}
+	int format = image->format;
+	free(image->data);
+	image->data = pixels;
+	image->format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+	ImageFormat(image, format);
+}
+
+// The blur ImageBlurGaussian approximates, in doubles with one rounding at the end.
+static std::vector<unsigned char> exactBlur(Image image, int blurSize) {
+	int w = image.width, h = image.height;
+	const unsigned char* p = (const unsigned char*)image.data;
+	std::vector<double> a(w * h * 4), b(w * h * 4);
+	for (int i = 0; i < w * h; i++) {
+		for (int c = 0; c < 3; c++) a[i * 4 + c] = p[i * 4 + c] * (p[i * 4 + 3] / 255.0);
+		a[i * 4 + 3] = p[i * 4 + 3];
+	}
+	// Window [i - r, i + r] cut at the ends, over count elements step apart.
+	std::vector<double> prefix;
+	auto box = [&](const double* src, double* dst, int count, int step) {
+		for (int c = 0; c < 4; c++) {
+			prefix.assign(count + 1, 0.0);
+			for (int i = 0; i < count; i++) prefix[i + 1] = prefix[i] + src[i * step + c];
+			for (int i = 0; i < count; i++) {
+				int first = std::max(0, i - blurSize), last = std::min(count - 1, i + blurSize);
+				dst[i * step + c] = (prefix[last + 1] - prefix[first]) / (last - first + 1);
+			}
+		}
+	};
+	for (int pass = 0; pass < 4; pass++) {
+		for (int y = 0; y < h; y++) box(&a[y * w * 4], &b[y * w * 4], w, 4);
+		for (int x = 0; x < w; x++) box(&b[x * 4], &a[x * 4], h, w * 4);
+	}
+	std::vector<unsigned char> out(w * h * 4);
+	for (int i = 0; i < w * h; i++) {
+		double alpha = a[i * 4 + 3];
+		for (int c = 0; c < 3; c++) out[i * 4 + c] = alpha < 0.5 ? 0 : (unsigned char)std::min(255.0, std::lround(a[i * 4 + c] * 255.0 / alpha) * 1.0);
+		out[i * 4 + 3] = (unsigned char)std::lround(alpha);
+	}
+	return out;
+}
+
+// Largest and mean channel difference from reference.
+static void blurError(Image image, const std::vector<unsigned char>& reference, int& maxDiff, double& meanDiff) {
+	const unsigned char* p = (const unsigned char*)image.data;
+	maxDiff = 0;
+	meanDiff = 0;
+	for (size_t i = 0; i < reference.size(); i++) {
+		int d = abs((int)p[i] - (int)reference[i]);
+		maxDiff = std::max(maxDiff, d);
+		meanDiff += d;
+	}
+	meanDiff /= (double)reference.size();
+}
+
+// Noise under a smooth gradient with alpha, closer to real images than noise alone.
+static Image blurTestImage(int size) {
+	Image image = noiseImage(size, 5);
+	unsigned char* p = (unsigned char*)image.data;
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			unsigned char* q = p + ((size_t)y * size + x) * 4;
+			q[0] = (unsigned char)((x * 255 / size + q[0] / 8) & 255);
+			q[1] = (unsigned char)((y * 255 / size + q[1] / 8) & 255);
+			q[2] = (unsigned char)(q[2] / 2 + 64);
+			q[3] = (unsigned char)(128 + (x + y) * 127 / (2 * size) - q[3] / 32);
+		}
+	}
+	return image;
+}
+
+static bool runBlurBench(const BenchOptions& o) {
+	printf("%d x %d pixels, best of %d; max and mean difference from the exact blur\n%-6s %10s %10s %8s %14s %14s\n",
+		o.size, o.size, o.reps, "radius", "old ms", "new ms", "speedup", "old error", "new error");
+	Image source = blurTestImage(o.size);
+	bool ok = true;
+	for (int radius : { 1, 2, 4, 8, 16, 32, 64 }) {
+		Image expected, actual;
+		double oldMs = timeOnCopy(o, source, expected, [&](Image* image) { oldBlurGaussian(image, radius); });
+		double newMs = timeOnCopy(o, source, actual, [&](Image* image) { ImageBlurGaussian(image, radius); });
+		std::vector<unsigned char> exact = exactBlur(source, radius);
+		int oldMax, newMax;
+		double oldMean, newMean;
+		blurError(expected, exact, oldMax, oldMean);
+		blurError(actual, exact, newMax, newMean);
+		ok = ok && newMax <= oldMax && newMean <= oldMean;
+		printf("%-6d %10.2f %10.2f %7.1fx %5d / %6.3f %5d / %6.3f\n", radius, oldMs, newMs, oldMs / newMs, oldMax, oldMean, newMax, newMean);
+		UnloadImage(expected);
+		UnloadImage(actual);
+	}
+	UnloadImage(source);
+	printf(ok ? "ImageBlurGaussian is at least as close as the float blur\n" : "ImageBlurGaussian is further from the exact blur than the float one\n");
+	return ok;
+}
+
+// ========================
+// Convolution
+// ========================
+
+// ImageKernelConvolution before tiling, separable and fixed point passes, as it was in rtextures.c.
+static void oldKernelConvolution(Image* image, const float* kernel, int kernelSize) {
+	int kernelWidth = (int)sqrtf((float)kernelSize);
+	Color* pixels = LoadImageColors(*image);
+	std::vector<Vector4> result(image->width * image->height);
+	int startRange = -kernelWidth / 2;
+	int endRange = kernelWidth % 2 == 0 ? kernelWidth / 2 : kernelWidth / 2 + 1;
+	for (int x = 0; x < image->height; x++) {
+		for (int y = 0; y < image->width; y++) {
+			Vector4 sum = { 0.0f, 0.0f, 0.0f, 0.0f };
+			for (int xk = startRange; xk < endRange; xk++) {
+				for (int yk = startRange; yk < endRange; yk++) {
+					unsigned int index = image->width * (x + xk) + (y + yk);
+					if (index >= (unsigned int)(image->width * image->height)) continue;
+					float k = kernel[kernelWidth * (xk + kernelWidth / 2) + yk + kernelWidth / 2];
+					sum.x += pixels[index].r / 255.0f * k;
+					sum.y += pixels[index].g / 255.0f * k;
+					sum.z += pixels[index].b / 255.0f * k;
+					sum.w += pixels[index].a / 255.0f * k;
+				}
+			}
+			result[image->width * x + y] = { std::clamp(sum.x, 0.0f, 1.0f), std::clamp(sum.y, 0.0f, 1.0f), std::clamp(sum.z, 0.0f, 1.0f), sum.w };
+		}
+	}
+	for (int i = 0; i < image->width * image->height; i++) {
+		pixels[i] = { (unsigned char)(result[i].x * 255.0f), (unsigned char)(result[i].y * 255.0f),
+			(unsigned char)(result[i].z * 255.0f), (unsigned char)(int)(result[i].w * 255.0f) };
+	}
+	int format = image->format;
+	free(image->data);
+	image->data = pixels;
+	image->format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+	ImageFormat(image, format);
+}
+
+// The convolution in doubles, zero outside the image, rounded and clamped once.
+static std::vector<unsigned char> exactConvolution(Image image, const std::vector<float>& kernel, int kernelWidth) {
+	int w = image.width, h = image.height, before = kernelWidth / 2;
+	const unsigned char* p = (const unsigned char*)image.data;
+	std::vector<unsigned char> out(w * h * 4);
+	for (int y = 0; y < h; y++) {
+		for (int x = 0; x < w; x++) {
+			double sum[4] = { 0.0, 0.0, 0.0, 0.0 };
+			for (int i = 0; i < kernelWidth; i++) {
+				int sy = y + i - before;
+				if (sy < 0 || sy >= h) continue;
+				for (int j = 0; j < kernelWidth; j++) {
+					int sx = x + j - before;
+					if (sx < 0 || sx >= w) continue;
+					for (int c = 0; c < 4; c++) sum[c] += (double)kernel[i * kernelWidth + j] * p[((size_t)sy * w + sx) * 4 + c];
+				}
+			}
+			for (int c = 0; c < 4; c++) out[((size_t)y * w + x) * 4 + c] = (unsigned char)std::clamp(std::floor(sum[c] + 0.5), 0.0, 255.0);
+		}
+	}
+	return out;
+}
+
+// Largest channel difference from reference, leaving out border pixels at each edge.
+static int convolutionError(Image image, const std::vector<unsigned char>& reference, int border) {
+	const unsigned char* p = (const unsigned char*)image.data;
+	int maxDiff = 0;
+	for (int y = border; y < image.height - border; y++) {
+		for (int i = border * 4; i < (image.width - border) * 4; i++) {
+			size_t at = (size_t)y * image.width * 4 + i;
+			maxDiff = std::max(maxDiff, abs((int)p[at] - (int)reference[at]));
+		}
+	}
+	return maxDiff;
+}
+
+// Binomial blur (separable), sharpen, emboss and edge kernels of width k.
+static std::vector<float> benchKernel(const char* name, int k) {
+	std::vector<float> kernel(k * k, 0.0f);
+	int center = k / 2;
+	if (!strcmp(name, "blur")) {
+		std::vector<double> row(k, 1.0);
+		for (int n = 1; n < k; n++) for (int i = n - 1; i > 0; i--) row[i] += row[i - 1];
+		double total = std::pow(2.0, 2 * (k - 1));
+		for (int i = 0; i < k * k; i++) kernel[i] = (float)(row[i / k] * row[i % k] / total);
+	} else if (!strcmp(name, "sharpen")) {
+		for (float& v : kernel) v = -1.0f / (float)(k * k - 1);
+		kernel[center * k + center] = 2.0f;
+	} else if (!strcmp(name, "emboss")) {
+		for (int i = 0; i < k * k; i++) kernel[i] = (float)(i / k + i % k - 2 * center) / (float)center;
+		kernel[center * k + center] = 1.0f;
+	} else {
+		for (float& v : kernel) v = -1.0f;
+		kernel[center * k + center] = (float)(k * k - 1);
+	}
+	return kernel;
+}
+
+static bool runConvolveBench(const BenchOptions& o) {
+	printf("%d x %d pixels, best of %d; max difference from the exact convolution (old one away from the edges)\n%-8s %6s %10s %10s %8s %10s %10s\n",
+		o.size, o.size, o.reps, "kernel", "width", "old ms", "new ms", "speedup", "old error", "new error");
+	Image source = blurTestImage(o.size);
+	bool ok = true;
+	for (const char* name : { "blur", "sharpen", "emboss", "edge" }) {
+		for (int k : { 3, 5, 9, 15 }) {
+			std::vector<float> kernel = benchKernel(name, k);
+			Image expected, actual;
+			double oldMs = timeOnCopy(o, source, expected, [&](Image* image) { oldKernelConvolution(image, kernel.data(), k * k); });
+			double newMs = timeOnCopy(o, source, actual, [&](Image* image) { ImageKernelConvolution(image, kernel.data(), k * k); });
+			std::vector<unsigned char> exact = exactConvolution(source, kernel, k);
+			int oldError = convolutionError(expected, exact, k);
+			int newError = convolutionError(actual, exact, 0);
+			ok = ok && newError <= 1;
+			printf("%-8s %6d %10.2f %10.2f %7.1fx %10d %10d\n", name, k, oldMs, newMs, oldMs / newMs, oldError, newError);
+			UnloadImage(expected);
+			UnloadImage(actual);
+		}
+	}
+	UnloadImage(source);
+	printf(ok ? "ImageKernelConvolution is within one level of the exact convolution\n" : "ImageKernelConvolution is off the exact convolution by more than one level\n");
+	return ok;
+}
+
+// ========================
+// Drawing
+// ========================
+
+// ImageDraw* shape functions before spans, as they were in rtextures.c: every
+// pixel goes through ImageDrawPixel, rectangle rows copy their first pixel.
+static void oldClearBackground(Image* dst, Color color) {
+	ImageDrawPixel(dst, 0, 0, color);
+	unsigned char* first = (unsigned char*)dst->data;
+	int bytesPerPixel = GetPixelDataSize(1, 1, dst->format);
+	for (int i = 1; i < dst->width * dst->height; i++) memcpy(first + i * bytesPerPixel, first, bytesPerPixel);
+}
+
+static void oldDrawRectangle(Image* dst, int posX, int posY, int width, int height, Color color) {
+	Rectangle rec = { (float)posX, (float)posY, (float)width, (float)height };
+	if (rec.x < 0) { rec.width += rec.x; rec.x = 0; }
+	if (rec.y < 0) { rec.height += rec.y; rec.y = 0; }
+	if (rec.width < 0) rec.width = 0;
+	if (rec.height < 0) rec.height = 0;
+	if (rec.x + rec.width >= dst->width) rec.width = dst->width - rec.x;
+	if (rec.y + rec.height >= dst->height) rec.height = dst->height - rec.y;
+	if (rec.x >= dst->width || rec.y >= dst->height) return;
+	if (rec.x + rec.width <= 0 || rec.y + rec.height <= 0) return;
+	int sx = (int)rec.x, sy = (int)rec.y;
+	int bytesPerPixel = GetPixelDataSize(1, 1, dst->format);
+	ImageDrawPixel(dst, sx, sy, color);
+	unsigned char* first = (unsigned char*)dst->data + (sy * dst->width + sx) * bytesPerPixel;
+	for (int x = 1; x < (int)rec.width; x++) memcpy(first + x * bytesPerPixel, first, bytesPerPixel);
+	for (int y = 1; y < (int)rec.height; y++) memcpy(first + y * dst->width * bytesPerPixel, first, bytesPerPixel * (int)rec.width);
+}
+
+static void oldDrawCircle(Image* dst, int centerX, int centerY, int radius, Color color) {
+	int x = 0, y = radius, decision = 3 - 2 * radius;
+	while (y >= x) {
+		oldDrawRectangle(dst, centerX - x, centerY + y, x * 2, 1, color);
+		oldDrawRectangle(dst, centerX - x, centerY - y, x * 2, 1, color);
+		oldDrawRectangle(dst, centerX - y, centerY + x, y * 2, 1, color);
+		oldDrawRectangle(dst, centerX - y, centerY - x, y * 2, 1, color);
+		x++;
+		if (decision > 0) {
+			y--;
+			decision += 4 * (x - y) + 10;
+		} else {
+			decision += 4 * x + 6;
+		}
+	}
+}
+
+static void oldDrawLine(Image* dst, int startPosX, int startPosY, int endPosX, int endPosY, Color color) {
+	int shortLen = endPosY - startPosY, longLen = endPosX - startPosX;
+	bool yLonger = abs(shortLen) > abs(longLen);
+	if (yLonger) std::swap(shortLen, longLen);
+	int endVal = longLen, sgnInc = 1;
+	if (longLen < 0) {
+		longLen = -longLen;
+		sgnInc = -1;
+	}
+	int decInc = longLen == 0 ? 0 : (shortLen << 16) / longLen;
+	for (int i = 0, j = 0; i != endVal; i += sgnInc, j += decInc) {
+		if (yLonger) ImageDrawPixel(dst, startPosX + (j >> 16), startPosY + i, color);
+		else ImageDrawPixel(dst, startPosX + i, startPosY + (j >> 16), color);
+	}
+}
+
+static void oldDrawLineEx(Image* dst, Vector2 start, Vector2 end, int thick, Color color) {
+	int x1 = (int)(start.x + 0.5f), y1 = (int)(start.y + 0.5f), x2 = (int)(end.x + 0.5f), y2 = (int)(end.y + 0.5f);
+	int dx = x2 - x1, dy = y2 - y1;
+	oldDrawLine(dst, x1, y1, x2, y2, color);
+	if (dx != 0 && abs(dy / dx) < 1) {
+		int wy = (thick - 1) * (int)sqrtf((float)(dx * dx + dy * dy)) / (2 * abs(dx));
+		for (int i = 1; i <= wy; i++) {
+			oldDrawLine(dst, x1, y1 - i, x2, y2 - i, color);
+			oldDrawLine(dst, x1, y1 + i, x2, y2 + i, color);
+		}
+	} else if (dy != 0) {
+		int wx = (thick - 1) * (int)sqrtf((float)(dx * dx + dy * dy)) / (2 * abs(dy));
+		for (int i = 1; i <= wx; i++) {
+			oldDrawLine(dst, x1 - i, y1, x2 - i, y2, color);
+			oldDrawLine(dst, x1 + i, y1, x2 + i, y2, color);
+		}
+	}
+}
+
+static void oldDrawTriangle(Image* dst, Vector2 v1, Vector2 v2, Vector2 v3, Color color) {
+	int xMin = (int)std::min({ v1.x, v2.x, v3.x }), yMin = (int)std::min({ v1.y, v2.y, v3.y });
+	int xMax = (int)std::max({ v1.x, v2.x, v3.x }), yMax = (int)std::max({ v1.y, v2.y, v3.y });
+	xMin = std::max(xMin, 0);
+	yMin = std::max(yMin, 0);
+	xMax = std::min(xMax, dst->width);
+	yMax = std::min(yMax, dst->height);
+	bool isBackFace = (v2.x - v1.x) * (v3.y - v1.y) - (v3.x - v1.x) * (v2.y - v1.y) > 0;
+	int w1XStep = (int)(v3.y - v2.y), w1YStep = (int)(v2.x - v3.x);
+	int w2XStep = (int)(v1.y - v3.y), w2YStep = (int)(v3.x - v1.x);
+	int w3XStep = (int)(v2.y - v1.y), w3YStep = (int)(v1.x - v2.x);
+	if (isBackFace) {
+		w1XStep = -w1XStep, w1YStep = -w1YStep;
+		w2XStep = -w2XStep, w2YStep = -w2YStep;
+		w3XStep = -w3XStep, w3YStep = -w3YStep;
+	}
+	int w1Row = (int)((xMin - v2.x) * w1XStep + w1YStep * (yMin - v2.y));
+	int w2Row = (int)((xMin - v3.x) * w2XStep + w2YStep * (yMin - v3.y));
+	int w3Row = (int)((xMin - v1.x) * w3XStep + w3YStep * (yMin - v1.y));
+	for (int y = yMin; y <= yMax; y++) {
+		int w1 = w1Row, w2 = w2Row, w3 = w3Row;
+		for (int x = xMin; x <= xMax; x++) {
+			if ((w1 | w2 | w3) >= 0) ImageDrawPixel(dst, x, y, color);
+			w1 += w1XStep;
+			w2 += w2XStep;
+			w3 += w3XStep;
+		}
+		w1Row += w1YStep;
+		w2Row += w2YStep;
+		w3Row += w3YStep;
+	}
+}
+
+// Random shapes, some reaching past the image edges.
+struct DrawScene {
+	std::vector<Rectangle> rects;
+	std::vector<Vector3> circles;             // x, y, radius
+	std::vector<Vector2> lines;               // start and end pairs
+	std::vector<Vector2> triangles;           // vertex triples
+	std::vector<Color> colors;
+};
+
+static DrawScene drawScene(int size, int count) {
+	DrawScene scene;
+	unsigned seed = 11;
+	auto next = [&](int range) {
+		seed = seed * 1664525u + 1013904223u;
+		return (int)((seed >> 8) % (unsigned)range);
+	};
+	auto point = [&]() { return Vector2{ (float)(next(size + 64) - 32), (float)(next(size + 64) - 32) }; };
+	for (int i = 0; i < count; i++) {
+		scene.rects.push_back({ (float)(next(size + 64) - 64), (float)(next(size + 64) - 64), (float)(1 + next(size / 4)), (float)(1 + next(size / 4)) });
+		scene.circles.push_back({ (float)(1 + next(size)), (float)(1 + next(size)), (float)next(size / 8) });
+		for (int v = 0; v < 2; v++) scene.lines.push_back(point());
+		for (int v = 0; v < 3; v++) scene.triangles.push_back(point());
+		scene.colors.push_back({ (unsigned char)next(256), (unsigned char)next(256), (unsigned char)next(256), (unsigned char)next(256) });
+	}
+	return scene;
+}
+
+template <typename Rect, typename Circle, typename LineEx, typename Triangle>
+static void drawShapes(Image* image, const DrawScene& scene, Rect rect, Circle circle, LineEx lineEx, Triangle triangle) {
+	for (size_t i = 0; i < scene.colors.size(); i++) {
+		const Rectangle& r = scene.rects[i];
+		rect(image, (int)r.x, (int)r.y, (int)r.width, (int)r.height, scene.colors[i]);
+		circle(image, (int)scene.circles[i].x, (int)scene.circles[i].y, (int)scene.circles[i].z, scene.colors[i]);
+		lineEx(image, scene.lines[i * 2], scene.lines[i * 2 + 1], 1 + (int)(i % 5), scene.colors[i]);
+		triangle(image, scene.triangles[i * 3], scene.triangles[i * 3 + 1], scene.triangles[i * 3 + 2], scene.colors[i]);
+	}
+}
+
+// Spans blended with ImageDrawSpanBlend must match ColorAlphaBlend pixel by pixel,
+// pixels read with GetPixelColor as ImageDraw does.
+static bool checkBlendedSpans(int format) {
+	Image expected = noiseImage(256, 3), actual;
+	ImageFormat(&expected, format);
+	actual = ImageCopy(expected);
+	int bytesPerPixel = GetPixelDataSize(1, 1, format);
+	for (int y = 0; y < 256; y++) {
+		Color color = { (unsigned char)(y * 7), (unsigned char)(255 - y), (unsigned char)(y * 3), (unsigned char)y };
+		ImageDrawSpanBlend(&actual, y / 2 - 32, y, 200, color);
+		// transparent spans leave pixels as they are, GetPixelColor does not round trip every format
+		if (color.a == 0) continue;
+		for (int x = std::max(0, y / 2 - 32); x < y / 2 + 168 && x < 256; x++) {
+			Color below = GetPixelColor((unsigned char*)expected.data + (y * 256 + x) * bytesPerPixel, format);
+			ImageDrawPixel(&expected, x, y, ColorAlphaBlend(below, color, WHITE));
+		}
+	}
+	bool same = sameImage(expected, actual);
+	UnloadImage(expected);
+	UnloadImage(actual);
+	return same;
+}
+
+// Threads drawing shapes inside their own band of rows give the single thread image.
+static bool checkThreadedBands(int size, int format) {
+	const int bands = 4;
+	Image single = GenImageColor(size, size, BLACK);
+	ImageFormat(&single, format);
+	Image threaded = ImageCopy(single);
+	auto drawBand = [size](Image* image, int band) {
+		int top = band * size / bands, height = size / bands;
+		for (int i = 0; i < 200; i++) {
+			Color color = { (unsigned char)(band * 60 + i), (unsigned char)(i * 3), (unsigned char)(255 - i), (unsigned char)(128 + i / 2) };
+			int x = (i * 37) % size, y = top + (i * 13) % (height / 2);
+			ImageDrawRectangle(image, x - 20, y, 40, height / 2, color);
+			ImageDrawSpanBlend(image, x - 30, top + (i * 7) % height, 60, color);
+			ImageDrawTriangle(image, { (float)x, (float)top }, { (float)(x - 30), (float)(top + height - 1) }, { (float)(x + 30), (float)(top + height - 1) }, color);
+		}
+	};
+	for (int band = 0; band < bands; band++) drawBand(&single, band);
+	std::vector<std::thread> threads;
+	for (int band = 0; band < bands; band++) threads.emplace_back(drawBand, &threaded, band);
+	for (std::thread& t : threads) t.join();
+	bool same = sameImage(single, threaded);
+	UnloadImage(single);
+	UnloadImage(threaded);
+	return same;
+}
+
+static bool runDrawBench(const BenchOptions& o) {
+	const int shapes = 200;
+	printf("%d x %d pixels, %d rectangles, circles, thick lines and triangles, best of %d\n%-8s %10s %10s %8s %6s\n",
+		o.size, o.size, shapes, o.reps, "format", "old ms", "new ms", "speedup", "same");
+	DrawScene scene = drawScene(o.size, shapes);
+	bool ok = true;
+	for (int format : { PIXELFORMAT_UNCOMPRESSED_GRAYSCALE, PIXELFORMAT_UNCOMPRESSED_R5G6B5, PIXELFORMAT_UNCOMPRESSED_R8G8B8,
+			PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, PIXELFORMAT_UNCOMPRESSED_R32G32B32A32 }) {
+		Image source = GenImageColor(o.size, o.size, BLANK);
+		ImageFormat(&source, format);
+		Image expected, actual;
+		double oldMs = timeOnCopy(o, source, expected, [&](Image* image) {
+			oldClearBackground(image, DARKBLUE);
+			drawShapes(image, scene, oldDrawRectangle, oldDrawCircle, oldDrawLineEx, oldDrawTriangle);
+		});
+		double newMs = timeOnCopy(o, source, actual, [&](Image* image) {
+			ImageClearBackground(image, DARKBLUE);
+			drawShapes(image, scene, ImageDrawRectangle, ImageDrawCircle, ImageDrawLineEx, ImageDrawTriangle);
+		});
+		bool same = sameImage(expected, actual);
+		ok = ok && same;
+		printf("%-8s %10.2f %10.2f %7.1fx %6s\n", formatNames[format], oldMs, newMs, oldMs / newMs, same ? "yes" : "NO");
+		UnloadImage(source);
+		UnloadImage(expected);
+		UnloadImage(actual);
+	}
+	for (int format : { PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, PIXELFORMAT_UNCOMPRESSED_R8G8B8, PIXELFORMAT_UNCOMPRESSED_R5G5B5A1 }) {
+		bool blended = checkBlendedSpans(format);
+		bool threaded = checkThreadedBands(std::max(o.size, 256), format);
+		ok = ok && blended && threaded;
+		printf("%-8s blended spans %s ColorAlphaBlend, threads drawing bands %s one thread\n", formatNames[format],
+			blended ? "match" : "DIFFER from", threaded ? "match" : "DIFFER from");
+	}
+	printf(ok ? "ImageDraw* draws the same pixels as before\n" : "ImageDraw* draws different pixels than before\n");
+	return ok;
+}
+
+int main(int argc, char** argv) {
+	BenchOptions o;
+	if (!parseOptions(argc, argv, o)) {
+		usage();
+		return 1;
+	}
+	SetTraceLogLevel(LOG_WARNING);
+	bool ok = true;
+	if (o.formats) ok = runFormatBench(o) && ok;
+	if (o.resize) ok = runResizeBench(o) && ok;
+	if (o.blur) ok = runBlurBench(o) && ok;
+	if (o.convolve) ok = runConvolveBench(o) && ok;
+	if (o.draw) ok = runDrawBench(o) && ok;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,600 @@
+// pizzeria_bench.cpp
+// Headless load generator for the pizzeria library. Random order streams
+// (category mix, toppings, sizes, delivery share) go through order entry
+// and optionally the journal and the kitchen, on one or more threads.
+// Prints orders per second, p50/p99 latency of every operation and heap
+// allocations per order. Without -j it runs once on one thread and once
+// on every core. --sales fills a sales store instead and times its queries;
+// --dispatch runs an hour of delivery dispatching; --terminals sends the
+// orders through an order server from that many tills; --lookups times
+// menu lookups by name against a linear scan.
+#include "pizzeria.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ========================
+// Allocation counting
+// ========================
+
+// Every plain operator new in the process lands here (new[] forwards to it).
+static thread_local uint64_t threadAllocations = 0;
+
+#if defined(__GNUC__) && !defined(__clang__)
+// the replaced new does use malloc, so free is the right match
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size) {
+	threadAllocations++;
+	if (void* p = malloc(size ? size : 1)) return p;
+	throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// ========================
+// Options
+// ========================
+
+struct BenchOptions {
+	int orders = 1000000;
+	int threads = 0;          // 0 - one thread, then every core
+	unsigned seed = 1;
+	double deliveryShare = 0.3;
+	double meanLines = 3.0;
+	double toppingChance = 0.3;
+	const char* journalPath = nullptr;
+	bool fsync = false;
+	bool kitchen = false;
+	long long salesLines = 0; // > 0 - sales queries instead of order entry
+	int dispatchRate = 0;     // > 0 - delivery orders per minute for the dispatch run
+	int couriers = 0;         // 0 - enough for the rate
+	int terminals = 0;        // > 0 - tills talking to an in-process order server
+	const char* unixPath = nullptr;
+	int lookupItems = 0;      // > 0 - menu lookups on the built-in menu and one this large
+};
+
+static void usage() {
+	printf("usage: pizzeria_bench [options]\n"
+		"  -n ORDERS          orders in total (1000000)\n"
+		"  -j THREADS         order entry threads (default: 1, then all cores)\n"
+		"  --seed N           random seed (1)\n"
+		"  --delivery SHARE   share of delivery orders, 0..1 (0.3)\n"
+		"  --lines MEAN       mean lines per order (3)\n"
+		"  --toppings P       chance of each topping on a pizza (0.3)\n"
+		"  --journal FILE     log every order to FILE\n"
+		"  --fsync            sync the journal (group commit) instead of only writing it\n"
+		"  --kitchen          submit every order to a kitchen with zero service times\n"
+		"  --sales LINES      time sales queries over LINES random completed lines instead\n"
+		"  --dispatch RATE    simulate an hour of RATE delivery orders per minute instead\n"
+		"  --couriers N       couriers for --dispatch (default: enough for the rate)\n"
+		"  --terminals N      send the orders from N tills through an order server instead\n"
+		"  --unix PATH        tills connect over a Unix socket at PATH instead of TCP\n"
+		"  --lookups ITEMS    time -n menu lookups by name, also on a menu of ITEMS items, instead\n");
+}
+
+static bool parseOptions(int argc, char** argv, BenchOptions& o) {
+	for (int i = 1; i < argc; i++) {
+		const char* a = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		bool takesValue = true;
+		if (!strcmp(a, "-n") && value) o.orders = atoi(value);
+		else if (!strcmp(a, "-j") && value) o.threads = atoi(value);
+		else if (!strcmp(a, "--seed") && value) o.seed = (unsigned)strtoul(value, nullptr, 10);
+		else if (!strcmp(a, "--delivery") && value) o.deliveryShare = atof(value);
+		else if (!strcmp(a, "--lines") && value) o.meanLines = atof(value);
+		else if (!strcmp(a, "--toppings") && value) o.toppingChance = atof(value);
+		else if (!strcmp(a, "--journal") && value) o.journalPath = value;
+		else if (!strcmp(a, "--sales") && value) o.salesLines = atoll(value);
+		else if (!strcmp(a, "--dispatch") && value) o.dispatchRate = atoi(value);
+		else if (!strcmp(a, "--couriers") && value) o.couriers = atoi(value);
+		else if (!strcmp(a, "--terminals") && value) o.terminals = atoi(value);
+		else if (!strcmp(a, "--unix") && value) o.unixPath = value;
+		else if (!strcmp(a, "--lookups") && value) o.lookupItems = atoi(value);
+		else {
+			takesValue = false;
+			if (!strcmp(a, "--fsync")) o.fsync = true;
+			else if (!strcmp(a, "--kitchen")) o.kitchen = true;
+			else return false;
+		}
+		if (takesValue) i++;
+	}
+	return o.orders > 0 && o.meanLines >= 1.0 && o.salesLines >= 0 && o.dispatchRate >= 0 && o.terminals >= 0 && o.lookupItems >= 0;
+}
+
+// ========================
+// Load
+// ========================
+
+enum Operation { OP_CREATE, OP_ADD_LINE, OP_JOURNAL, OP_SUBMIT, OP_COUNT };
+static const char* operationNames[OP_COUNT] = { "create order", "add line", "journal event", "kitchen submit" };
+
+struct ThreadResult {
+	std::vector<uint32_t> samples[OP_COUNT]; // nanoseconds
+	uint64_t allocations = 0;
+	uint64_t lines = 0;
+	uint64_t rejected = 0;
+};
+
+struct Shared {
+	const BenchOptions& options;
+	const Menu& menu;
+	OrderLog* log;
+	Kitchen* kitchen;
+	std::atomic<int> nextOrderId{1};
+};
+
+static int64_t nowNs() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// One journal append, timed; nothing when the journal is off.
+template <typename F>
+static void logEvent(Shared& shared, ThreadResult& result, F append) {
+	if (!shared.log) return;
+	int64_t t0 = nowNs();
+	append();
+	result.samples[OP_JOURNAL].push_back((uint32_t)(nowNs() - t0));
+}
+
+static void runThread(Shared& shared, int orderCount, unsigned seed, ThreadResult& result) {
+	static const char* names[] = { "Anna", "Boris", "Chen", "Dmitri", "Eve", "Farida", "Gustav", "Hana" };
+	static const char* addresses[] = {
+		"12 Baker Street, flat 34", "7 Riverside Avenue, 2nd floor", "221 Elm Road, office 5", "3 Harbour Lane",
+	};
+	const BenchOptions& o = shared.options;
+	const Menu& menu = shared.menu;
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> chance(0.0, 1.0);
+	std::geometric_distribution<int> extraLines(1.0 / o.meanLines);
+	std::uniform_int_distribution<int> pizza(0, (int)menu.availablePizzas.size() - 1);
+	std::uniform_int_distribution<int> drink(0, (int)menu.availableDrinks.size() - 1);
+	std::uniform_int_distribution<int> side(0, (int)menu.availableSides.size() - 1);
+	std::uniform_int_distribution<int> size(0, SIZE_COUNT - 1);
+	std::uniform_int_distribution<int> base(0, 2);
+
+	// reserved up front so that the loop below only counts the library's allocations
+	OrderArena arena;
+	std::vector<Order> orders;
+	orders.reserve(orderCount);
+	size_t lineBudget = (size_t)(orderCount * o.meanLines * 1.5);
+	result.samples[OP_CREATE].reserve(orderCount);
+	result.samples[OP_ADD_LINE].reserve(lineBudget);
+	result.samples[OP_SUBMIT].reserve(orderCount);
+	if (shared.log) result.samples[OP_JOURNAL].reserve(lineBudget + 2 * orderCount);
+	uint64_t allocationsBefore = threadAllocations;
+
+	for (int n = 0; n < orderCount; n++) {
+		int64_t t0 = nowNs();
+		Order order(shared.nextOrderId.fetch_add(1, std::memory_order_relaxed), &arena);
+		order.customerName = names[rng() % 8];
+		if (chance(rng) < o.deliveryShare) {
+			order.orderType = OrderType::DELIVERY;
+			order.deliveryAddress = addresses[rng() % 4];
+			order.deliveryFee = 250;
+		} else {
+			order.orderType = rng() % 2 ? OrderType::DINE_IN : OrderType::TAKEAWAY;
+		}
+		result.samples[OP_CREATE].push_back((uint32_t)(nowNs() - t0));
+		logEvent(shared, result, [&] { shared.log->created(order); });
+
+		int lines = 1 + extraLines(rng);
+		for (int k = 0; k < lines; k++) {
+			double category = chance(rng);
+			ToppingSet toppings;
+			if (category < 0.5)
+				for (int t = 0; t < (int)menu.availableToppings.size(); t++)
+					if (chance(rng) < o.toppingChance) toppings.add((ToppingId)t);
+			PizzaSize pizzaSize = (PizzaSize)size(rng);
+			BaseType baseType = (BaseType)base(rng);
+			int drinkIndex = drink(rng), sideIndex = side(rng), pizzaIndex = pizza(rng);
+
+			t0 = nowNs();
+			if (category < 0.5) order.addPizza(menu, menu.pizzaId(pizzaIndex), pizzaSize, baseType, toppings);
+			else if (category < 0.8) order.addItem(menu, menu.drinkId(drinkIndex));
+			else order.addItem(menu, menu.sideId(sideIndex));
+			result.samples[OP_ADD_LINE].push_back((uint32_t)(nowNs() - t0));
+			logEvent(shared, result, [&] { shared.log->lineAdded(order); });
+		}
+		result.lines += order.lineCount();
+		logEvent(shared, result, [&] { shared.log->statusChanged(order); });
+
+		if (shared.kitchen) {
+			t0 = nowNs();
+			order.kitchenTicket = shared.kitchen->submit();
+			result.samples[OP_SUBMIT].push_back((uint32_t)(nowNs() - t0));
+			if (!order.kitchenTicket) result.rejected++;
+		}
+		orders.push_back(std::move(order));
+	}
+	result.allocations = threadAllocations - allocationsBefore;
+}
+
+// ========================
+// Report
+// ========================
+
+static uint32_t percentile(std::vector<uint32_t>& v, double p) {
+	if (v.empty()) return 0;
+	size_t k = std::min(v.size() - 1, (size_t)(p * v.size()));
+	std::nth_element(v.begin(), v.begin() + k, v.end());
+	return v[k];
+}
+
+static void runBench(const BenchOptions& o, int threads) {
+	Menu menu;
+	OrderLog log;
+	std::unique_ptr<Kitchen> kitchen;
+	if (o.journalPath) {
+		remove(o.journalPath);
+		OrderArena arena;
+		std::vector<Order> none;
+		int next = 1;
+		JournalOptions jo;
+		jo.sync = o.fsync;
+		if (!log.open(o.journalPath, menu, arena, none, next, jo)) {
+			fprintf(stderr, "cannot open journal %s\n", o.journalPath);
+			return;
+		}
+	}
+	if (o.kitchen) {
+		KitchenConfig kc;
+		kc.timeScale = 0.0;
+		kc.ticketCapacity = 1 << 20;
+		kitchen.reset(new Kitchen(kc));
+	}
+	Shared shared{o, menu, o.journalPath ? &log : nullptr, kitchen.get()};
+
+	std::vector<ThreadResult> results(threads);
+	std::vector<std::thread> pool;
+	int64_t start = nowNs();
+	for (int t = 0; t < threads; t++) {
+		int count = o.orders / threads + (t < o.orders % threads ? 1 : 0);
+		pool.emplace_back(runThread, std::ref(shared), count, o.seed + 7919u * t, std::ref(results[t]));
+	}
+	for (auto& t : pool) t.join();
+	double seconds = (nowNs() - start) / 1e9;
+
+	ThreadResult total;
+	for (auto& r : results) {
+		for (int op = 0; op < OP_COUNT; op++)
+			total.samples[op].insert(total.samples[op].end(), r.samples[op].begin(), r.samples[op].end());
+		total.allocations += r.allocations;
+		total.lines += r.lines;
+		total.rejected += r.rejected;
+	}
+
+	printf("\n%d orders, %d thread%s: %.3f s, %.0f orders/s, %.2f lines/order, %.3f allocations/order\n",
+		o.orders, threads, threads == 1 ? "" : "s", seconds, o.orders / seconds,
+		(double)total.lines / o.orders, (double)total.allocations / o.orders);
+	printf("%-16s %10s %10s %10s\n", "operation", "count", "p50 ns", "p99 ns");
+	for (int op = 0; op < OP_COUNT; op++) {
+		auto& s = total.samples[op];
+		if (s.empty()) continue;
+		size_t count = s.size();
+		uint32_t p50 = percentile(s, 0.50), p99 = percentile(s, 0.99);
+		printf("%-16s %10zu %10u %10u\n", operationNames[op], count, p50, p99);
+	}
+	if (kitchen) {
+		KitchenStats ks = kitchen->stats();
+		printf("kitchen: %llu submitted, %llu rejected as full, %llu ready so far\n",
+			(unsigned long long)ks.submitted, (unsigned long long)total.rejected, (unsigned long long)ks.ready);
+	}
+}
+
+// ========================
+// Sales queries
+// ========================
+
+static void runSalesBench(const BenchOptions& o, int cores) {
+	Menu menu;
+	SalesStore store;
+	store.reserve((size_t)o.salesLines);
+	std::mt19937 rng(o.seed);
+	std::uniform_real_distribution<double> chance(0.0, 1.0);
+	const int64_t day = 86400, start = 1700000000;
+	int64_t t0 = nowNs();
+	for (long long i = 0; i < o.salesLines; i++) {
+		OrderLine l;
+		double category = chance(rng);
+		if (category < 0.5) {
+			l.item = menu.pizzaId(rng() % menu.availablePizzas.size());
+			l.size = (PizzaSize)(rng() % SIZE_COUNT);
+			l.baseType = (BaseType)(rng() % 3);
+			for (int t = 0; t < (int)menu.availableToppings.size(); t++)
+				if (chance(rng) < o.toppingChance) l.toppings.add((ToppingId)t);
+		} else {
+			l.item = category < 0.8 ? menu.drinkId(rng() % menu.availableDrinks.size()) : menu.sideId(rng() % menu.availableSides.size());
+		}
+		l.priceCents = (int32_t)menu.linePrice(l.item, l.size, l.toppings);
+		OrderType type = chance(rng) < o.deliveryShare ? OrderType::DELIVERY : (OrderType)(rng() % 2);
+		store.addLine(l, category < 0.5, type, start + (int64_t)(i * (7.0 * day / o.salesLines)));
+	}
+	printf("%lld lines over 7 days, filled in %.2f s\n", o.salesLines, (nowNs() - t0) / 1e9);
+
+	static const SalesGroup groups[] = { SalesGroup::ITEM, SalesGroup::SIZE, SalesGroup::HOUR, SalesGroup::ORDER_TYPE };
+	static const char* groupNames[] = { "item", "size", "hour", "order type" };
+	std::vector<int> threadCounts = { 1 };
+	if (o.threads > 0) threadCounts = { o.threads };
+	else if (cores > 1) threadCounts.push_back(cores);
+	for (int threads : threadCounts) {
+		printf("\n%d thread%s\n%-12s %12s %12s\n", threads, threads == 1 ? "" : "s", "group by", "all ms", "one day ms");
+		for (int g = 0; g < 4; g++) {
+			int keys = SalesStore::groupKeyCount(groups[g], menu);
+			double all = 1e9, oneDay = 1e9;
+			for (int rep = 0; rep < 5; rep++) {
+				all = std::min(all, store.query(groups[g], keys, INT64_MIN, INT64_MAX, threads).milliseconds);
+				oneDay = std::min(oneDay, store.query(groups[g], keys, start + 3 * day, start + 4 * day, threads).milliseconds);
+			}
+			printf("%-12s %12.2f %12.2f\n", groupNames[g], all, oneDay);
+		}
+		t0 = nowNs();
+		store.toppingCounts(INT64_MIN, INT64_MAX, threads);
+		printf("%-12s %12.2f\n", "toppings", (nowNs() - t0) / 1e6);
+	}
+}
+
+// ========================
+// Dispatch
+// ========================
+
+// Simulated seconds, one update per second as the UI would run it.
+static void runDispatchBench(const BenchOptions& o) {
+	DispatchConfig config;
+	// a trip of four drops takes about 23 minutes
+	config.couriers = o.couriers > 0 ? o.couriers : std::max(1, o.dispatchRate * 6);
+	Dispatcher dispatcher(config);
+	std::mt19937 rng(o.seed);
+	std::poisson_distribution<int> arrivals(o.dispatchRate / 60.0);
+	std::vector<DispatchEvent> events;
+	std::vector<uint32_t> samples; // nanoseconds per simulated second
+	samples.reserve(3600);
+	int nextOrder = 1;
+	uint64_t departed = 0, delivered = 0;
+	Cents fees = 0;
+	char address[48];
+
+	for (int second = 0; second < 3600 + 3600; second++) {
+		int64_t t0 = nowNs();
+		if (second < 3600) {
+			for (int n = arrivals(rng); n > 0; n--) {
+				snprintf(address, sizeof(address), "%u Street %u", (unsigned)(rng() % 400), (unsigned)(rng() % 100));
+				dispatcher.add(nextOrder++, dispatcher.locate(address), second);
+			}
+		}
+		events.clear();
+		dispatcher.update(second, events);
+		samples.push_back((uint32_t)(nowNs() - t0));
+		for (const auto& e : events) {
+			if (e.kind == DispatchEvent::DEPARTED) {
+				departed++;
+				fees += e.fee;
+			} else {
+				delivered++;
+			}
+		}
+	}
+
+	DispatchStats ds = dispatcher.stats();
+	uint64_t total = 0;
+	for (uint32_t ns : samples) total += ns;
+	printf("%d orders in an hour, %d couriers: %llu departed, %llu delivered, %llu still waiting\n",
+		nextOrder - 1, config.couriers, (unsigned long long)departed, (unsigned long long)delivered, (unsigned long long)ds.waiting);
+	printf("%.2f orders/trip, %.2f km/order, %.0f s from ready to departure, fee $%s on average\n",
+		ds.ordersPerTrip, ds.kmPerOrder, ds.avgHoldSeconds, formatCents(departed ? fees / (Cents)departed : 0).c_str());
+	printf("dispatcher time: %.1f ms in total, %.1f us per order, p50 %u us, p99 %u us per simulated second\n",
+		total / 1e6, nextOrder > 1 ? total / 1e3 / (nextOrder - 1) : 0.0, percentile(samples, 0.50) / 1000, percentile(samples, 0.99) / 1000);
+}
+
+// ========================
+// Tills
+// ========================
+
+struct TillResult {
+	std::vector<uint32_t> roundTrips; // nanoseconds per order
+	std::vector<int32_t> orderIds;
+	uint64_t failed = 0;
+};
+
+// Every order goes out as one pipelined batch: NEW_ORDER, its lines, SEND.
+static void runTill(const BenchOptions& o, const Menu& menu, uint16_t port, int orderCount, unsigned seed, TillResult& result) {
+	OrderClient client;
+	bool connected = o.unixPath ? client.connectUnix(o.unixPath) : client.connectTcp("127.0.0.1", port);
+	if (!connected) {
+		result.failed = orderCount;
+		return;
+	}
+	std::mt19937 rng(seed);
+	std::geometric_distribution<int> extraLines(1.0 / o.meanLines);
+	std::uniform_real_distribution<double> chance(0.0, 1.0);
+	result.roundTrips.reserve(orderCount);
+	result.orderIds.reserve(orderCount);
+	for (int n = 0; n < orderCount; n++) {
+		bool delivery = chance(rng) < o.deliveryShare;
+		client.newOrder(delivery ? OrderType::DELIVERY : OrderType::TAKEAWAY, "Till", delivery ? "12 Baker Street" : "");
+		int lines = 1 + extraLines(rng);
+		for (int k = 0; k < lines; k++) {
+			if (chance(rng) < 0.5) client.addPizza(0, menu.pizzaId(rng() % menu.availablePizzas.size()), (PizzaSize)(rng() % SIZE_COUNT), BaseType::THIN, ToppingSet{});
+			else client.addItem(0, menu.drinkId(rng() % menu.availableDrinks.size()));
+		}
+		client.send(0);
+
+		int64_t t0 = nowNs();
+		if (!client.flush()) {
+			result.failed += orderCount - n;
+			return;
+		}
+		Response r;
+		bool ok = true;
+		for (int k = 0; k < lines + 2; k++) {
+			if (!client.receive(r)) {
+				result.failed += orderCount - n;
+				return;
+			}
+			if (r.request == Request::NEW_ORDER) result.orderIds.push_back(r.orderId);
+			ok &= r.result == Result::OK;
+		}
+		result.roundTrips.push_back((uint32_t)(nowNs() - t0));
+		if (!ok) result.failed++;
+	}
+}
+
+static void runTerminalsBench(const BenchOptions& o) {
+	ServerOptions so;
+	so.port = 0;
+	if (o.unixPath) so.unixPath = o.unixPath;
+	if (o.journalPath) {
+		remove(o.journalPath);
+		so.journalPath = o.journalPath;
+		so.journal.sync = o.fsync;
+	}
+	so.kitchen.timeScale = 0.0;
+	so.kitchen.ticketCapacity = 1 << 20;
+	OrderServer server(so);
+	if (!server.start()) {
+		fprintf(stderr, "cannot start the order server\n");
+		return;
+	}
+	std::thread serving([&] { server.run(); });
+
+	Menu menu;
+	std::vector<TillResult> results(o.terminals);
+	std::vector<std::thread> tills;
+	int64_t start = nowNs();
+	for (int t = 0; t < o.terminals; t++) {
+		int count = o.orders / o.terminals + (t < o.orders % o.terminals ? 1 : 0);
+		tills.emplace_back(runTill, std::cref(o), std::cref(menu), server.port(), count, o.seed + 7919u * t, std::ref(results[t]));
+	}
+	for (auto& t : tills) t.join();
+	double seconds = (nowNs() - start) / 1e9;
+	ServerStats ss = server.stats();
+	server.stop();
+	serving.join();
+
+	TillResult total;
+	for (auto& r : results) {
+		total.roundTrips.insert(total.roundTrips.end(), r.roundTrips.begin(), r.roundTrips.end());
+		total.orderIds.insert(total.orderIds.end(), r.orderIds.begin(), r.orderIds.end());
+		total.failed += r.failed;
+	}
+	std::sort(total.orderIds.begin(), total.orderIds.end());
+	size_t duplicates = total.orderIds.size() - (std::unique(total.orderIds.begin(), total.orderIds.end()) - total.orderIds.begin());
+
+	printf("%d orders from %d tills over %s: %.3f s, %.0f orders/s, %.0f requests/s\n", o.orders, o.terminals,
+		o.unixPath ? "a Unix socket" : "TCP", seconds, o.orders / seconds, ss.requests / seconds);
+	printf("round trip per order p50 %u us, p99 %u us; %.1f requests per read; %llu failed, %zu duplicate order IDs\n",
+		percentile(total.roundTrips, 0.50) / 1000, percentile(total.roundTrips, 0.99) / 1000,
+		ss.reads ? (double)ss.requests / ss.reads : 0.0, (unsigned long long)total.failed, duplicates);
+}
+
+// ========================
+// Menu lookups
+// ========================
+
+// What finding an item by name cost before the index: every list in turn.
+static int scanItem(const Menu& menu, const std::string& name) {
+	for (size_t i = 0; i < menu.availablePizzas.size(); i++)
+		if (menu.availablePizzas[i].getName() == name) return menu.pizzaId((int)i);
+	for (size_t i = 0; i < menu.availableDrinks.size(); i++)
+		if (menu.availableDrinks[i].getName() == name) return menu.drinkId((int)i);
+	for (size_t i = 0; i < menu.availableSides.size(); i++)
+		if (menu.availableSides[i].getName() == name) return menu.sideId((int)i);
+	return -1;
+}
+
+static volatile int64_t lookupSink; // keeps the timed loops
+
+static void timeLookups(const BenchOptions& o, const char* title, const Menu& menu) {
+	// every tenth name is not on the menu
+	std::mt19937 rng(o.seed);
+	std::vector<std::string> names(4096);
+	for (std::string& name : names) {
+		ItemId id = (ItemId)(rng() % menu.itemCount());
+		name = rng() % 10 == 0 || !menu.offered(id) ? "Nothing " + std::to_string(rng()) : menu.name(id);
+	}
+	// keeps the scan under a few seconds on big menus
+	int scans = (int)std::min<long long>(o.orders, 200000000LL / (long long)menu.itemCount() + 1);
+	int64_t found = 0;
+	int64_t t0 = nowNs();
+	for (int i = 0; i < scans; i++) found += scanItem(menu, names[i & 4095]);
+	double scanNs = (double)(nowNs() - t0) / scans;
+	t0 = nowNs();
+	for (int i = 0; i < o.orders; i++) found -= menu.findItem(names[i & 4095]);
+	double indexNs = (double)(nowNs() - t0) / o.orders;
+	t0 = nowNs();
+	for (int i = 0; i < o.orders; i++) found += menu.findTopping(menu.topping((ToppingId)(i % menu.availableToppings.size())).name);
+	double toppingNs = (double)(nowNs() - t0) / o.orders;
+	lookupSink = found;
+	printf("%-22s %8zu %12.1f %12.1f %12.1f\n", title, menu.itemCount(), scanNs, indexNs, toppingNs);
+}
+
+static void runLookupBench(const BenchOptions& o) {
+	std::string text;
+	for (int t = 0; t < ToppingSet::CAPACITY; t++) text += "topping | " + std::to_string(t) + " | Topping " + std::to_string(t) + " | 0.5\n";
+	for (int i = 0; i < o.lookupItems; i++) {
+		std::string name = " | Item " + std::to_string(i) + " | 4.5";
+		if (i % 3 == 0) text += "pizza | " + std::to_string(i) + name + "\n";
+		else if (i % 3 == 1) text += "drink | " + std::to_string(i) + name + " | 0.5 | still\n";
+		else text += "side | " + std::to_string(i) + name + " | 1 bowl\n";
+	}
+	std::string error;
+	std::shared_ptr<const Menu> large = MenuCatalog::parse(text, error);
+	if (!large) {
+		printf("%s\n", error.c_str());
+		return;
+	}
+	printf("%-22s %8s %12s %12s %12s\n", "menu", "items", "scan ns", "index ns", "topping ns");
+	timeLookups(o, "built-in", Menu());
+	timeLookups(o, "generated", *large);
+
+	// readers take a snapshot per operation while a reload publishes new ones
+	MenuCatalog catalog;
+	std::atomic<bool> reloading{true};
+	std::thread publisher([&] {
+		while (reloading) {
+			catalog.publish(std::make_shared<const Menu>());
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	int64_t t0 = nowNs();
+	size_t held = 0;
+	for (int i = 0; i < o.orders; i++) held += catalog.current()->itemCount();
+	double snapshotNs = (double)(nowNs() - t0) / o.orders;
+	reloading = false;
+	publisher.join();
+	lookupSink = (int64_t)held;
+	printf("snapshot per operation %.1f ns over %llu reloads\n", snapshotNs, (unsigned long long)catalog.version() - 1);
+}
+
+int main(int argc, char** argv) {
+	BenchOptions o;
+	if (!parseOptions(argc, argv, o)) {
+		usage();
+		return 1;
+	}
+	int cores = (int)std::max(1u, std::thread::hardware_concurrency());
+	if (o.salesLines > 0) {
+		runSalesBench(o, cores);
+	} else if (o.dispatchRate > 0) {
+		runDispatchBench(o);
+	} else if (o.terminals > 0) {
+		runTerminalsBench(o);
+	} else if (o.lookupItems > 0) {
+		runLookupBench(o);
+	} else if (o.threads > 0) {
+		runBench(o, o.threads);
+	} else {
+		runBench(o, 1);
+		if (cores > 1) runBench(o, cores);
+	}
+	return 0;
+}
@@ -212,6 +212,8 @@
 // Support multiple image editing functions to scale, adjust colors, flip, draw on images, crop...
 // If not defined, still some functions are supported: ImageFormat(), ImageCrop(), ImageToPOT()
 #define SUPPORT_IMAGE_MANIPULATION      1
+// Support worker threads (one per core) to split big image operations: resize, blur, convolution...
+#define SUPPORT_IMAGE_THREADS           1
 
 
 //------------------------------------------------------------------------------------
@@ -1392,6 +1392,8 @@ RLAPI Color GetImageColor(Image image, int x, int y);
 RLAPI void ImageClearBackground(Image *dst, Color color);                                                // Clear image background with given color
 RLAPI void ImageDrawPixel(Image *dst, int posX, int posY, Color color);                                  // Draw pixel within an image
 RLAPI void ImageDrawPixelV(Image *dst, Vector2 position, Color color);                                   // Draw pixel within an image (Vector version)
+RLAPI void ImageDrawSpan(Image *dst, int posX, int posY, int width, Color color);                         // Draw horizontal span of pixels within an image
+RLAPI void ImageDrawSpanBlend(Image *dst, int posX, int posY, int width, Color color);                    // Draw horizontal span of pixels alpha-blended within an image
 RLAPI void ImageDrawLine(Image *dst, int startPosX, int startPosY, int endPosX, int endPosY, Color color); // Draw line within an image
 RLAPI void ImageDrawLineV(Image *dst, Vector2 start, Vector2 end, Color color);                          // Draw line within an image (Vector version)
 RLAPI void ImageDrawLineEx(Image *dst, Vector2 start, Vector2 end, int thick, Color color);              // Draw a line defining thickness within an image
@@ -222,12 +222,45 @@
     #define STBIR_NO_SIMD
 #endif
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
-#include "external/stb_image_resize2.h"     // Required for: stbir_resize_uint8_linear() [ImageResize()]
+#include "external/stb_image_resize2.h"     // Required for: stbir_resize_extended_split() [ImageResize()]
 
 #if defined(__GNUC__) // GCC and Clang
     #pragma GCC diagnostic pop
 #endif
 
+// SIMD pixel loops, selected at compile time like stb_image_resize2 does
+#if !defined(__TINYC__) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+    #define RTEXTURES_SSE2
+    #include <emmintrin.h>                  // Required for: SSE2 intrinsics [Used in ConvertPixelsDirect()]
+    #if defined(__SSSE3__) || defined(__AVX2__)
+        #define RTEXTURES_SSSE3
+        #include <tmmintrin.h>              // Required for: _mm_shuffle_epi8()
+    #endif
+    #if defined(__AVX2__)
+        #define RTEXTURES_AVX2
+        #include <immintrin.h>              // Required for: AVX2 intrinsics
+    #endif
+#endif
+
+// Worker threads for big image operations, see RunImageTasks()
+#if defined(SUPPORT_IMAGE_THREADS) && !defined(__EMSCRIPTEN__)
+    #define RTEXTURES_THREADS
+    #if defined(_WIN32)
+        #include <process.h>                // Required for: _beginthreadex()
+// Declared here to avoid including windows.h, SRWLOCK and CONDITION_VARIABLE are a single pointer
+typedef struct ImagePoolSync { void *ptr; } ImagePoolSync;
+__declspec(dllimport) void __stdcall AcquireSRWLockExclusive(ImagePoolSync *lock);
+__declspec(dllimport) void __stdcall ReleaseSRWLockExclusive(ImagePoolSync *lock);
+__declspec(dllimport) int __stdcall SleepConditionVariableSRW(ImagePoolSync *condition, ImagePoolSync *lock, unsigned long milliseconds, unsigned long flags);
+__declspec(dllimport) void __stdcall WakeAllConditionVariable(ImagePoolSync *condition);
+__declspec(dllimport) unsigned long __stdcall GetActiveProcessorCount(unsigned short groupNumber);
+__declspec(dllimport) int __stdcall CloseHandle(void *handle);
+    #else
+        #include <pthread.h>                // Required for: pthread_create(), pthread_mutex_lock(), pthread_cond_wait()
+        #include <unistd.h>                 // Required for: sysconf()
+    #endif
+#endif
+
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
@@ -239,15 +272,95 @@
     #define GAUSSIAN_BLUR_ITERATIONS  4    // Number of box blur iterations to approximate gaussian blur
 #endif
 
+#ifndef IMAGE_MAX_THREADS
+    #define IMAGE_MAX_THREADS        16    // Maximum threads sharing an image operation, calling thread included
+#endif
+#ifndef IMAGE_TASK_MIN_PIXELS
+    #define IMAGE_TASK_MIN_PIXELS 65536    // Minimum pixels processed by a worker thread task
+#endif
+
+#define BLUR_STRIP_PIXELS          16    // Rows or columns blurred together by ImageBlurGaussian() passes
+#define BLUR_STRIP_LANES (BLUR_STRIP_PIXELS*4)   // Channels blurred together
+#define BLUR_MAX_RADIUS         32767    // Largest box radius, keeps window sums in 31 bits
+#define CONVOLUTION_TILE           64    // Tile width and height of ImageKernelConvolution()
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-// ...
+// Image task function, processes items [start, end) of a job, see RunImageTasks()
+typedef void (*ImageTaskFunc)(void *data, int start, int end);
+
+#if defined(RTEXTURES_THREADS)
+// Image worker threads pool, started on first use
+typedef struct ImageWorkerPool {
+    int threadCount;            // Threads sharing a job (workers plus calling thread), 0 before start
+    bool busy;                  // A job is running, new jobs run on their calling thread
+    unsigned int job;           // Job counter, workers wake up when it changes
+    int working;                // Workers still running the current job
+    ImageTaskFunc func;         // Current job task function
+    void *data;                 // Current job data
+    int count;                  // Current job items count
+    int chunk;                  // Items taken by a thread at once
+    int next;                   // Next item to take
+} ImageWorkerPool;
+#endif
+
+// Nearest-neighbor resize rows job, see ImageResizeNN()
+typedef struct ResizeNNTask {
+    const unsigned char *src;   // Source pixels
+    unsigned char *dst;         // Resized pixels
+    int srcWidth;               // Source width
+    int dstWidth;               // Resized width
+    int pixelSize;              // Bytes per pixel
+    int yRatio;                 // Source rows per resized row, 16.16 fixed point
+    const int *srcX;            // Source column of every resized column
+} ResizeNNTask;
+
+// Gaussian blur rows or column strips job, see ImageBlurGaussian()
+typedef struct BlurTask {
+    unsigned char *pixels;      // RGBA8 pixels, blurred in place
+    int width;                  // Image width
+    int height;                 // Image height
+    int radius;                 // Box radius along the blurred axis
+} BlurTask;
+
+// Kernel convolution tiles job, see ImageKernelConvolution()
+typedef struct ConvolutionTask {
+    const unsigned char *src;   // RGBA8 source pixels
+    unsigned char *dst;         // RGBA8 convolved pixels
+    int width;                  // Image width
+    int height;                 // Image height
+    int kernelWidth;            // Kernel width and height
+    const float *rowWeights;    // Separable kernel horizontal weights
+    const float *columnWeights; // Separable kernel vertical weights
+    const int *fixedWeights;    // Other kernels weights in fixed point, 16 bit pairs per kernel row
+    int fixedShift;             // Other kernels weights fraction bits
+} ConvolutionTask;
+
+// Color prepared once for drawing spans on one pixel format, see LoadPixelPen()
+typedef struct PixelPen {
+    unsigned int pixel[4];      // Color in the destination format, up to 16 bytes
+    int bytesPerPixel;          // Destination bytes per pixel, 0 for formats that can not be drawn on
+    int format;                 // Destination pixel format
+    Color color;                // Color blended over pixels
+    bool blend;                 // Blend color over pixels instead of replacing them
+} PixelPen;
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
-// It's lonely here...
+#if defined(RTEXTURES_THREADS)
+static ImageWorkerPool imagePool = { 0 };
+#if defined(_WIN32)
+static ImagePoolSync imagePoolLock = { 0 };
+static ImagePoolSync imagePoolWake = { 0 };     // Signaled when a job starts
+static ImagePoolSync imagePoolDone = { 0 };     // Signaled when the last worker finishes a job
+#else
+static pthread_mutex_t imagePoolLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t imagePoolWake = PTHREAD_COND_INITIALIZER;     // Signaled when a job starts
+static pthread_cond_t imagePoolDone = PTHREAD_COND_INITIALIZER;     // Signaled when the last worker finishes a job
+#endif
+#endif
 
 //----------------------------------------------------------------------------------
 // Other Modules Functions Declaration (required by text)
@@ -260,6 +373,19 @@ extern void LoadFontDefault(void);          // [Module: text] Loads default font
 static float HalfToFloat(unsigned short x);
 static unsigned short FloatToHalf(float x);
 static Vector4 *LoadImageDataNormalized(Image image);       // Load pixel data from image as Vector4 array (float normalized)
+static void *ConvertPixelsDirect(const void *data, int count, int format, int newFormat);   // Convert pixels between 8 bit and packed 16 bit formats
+static int GetImageThreadCount(void);                        // Get threads sharing image tasks, starts the worker threads
+static void RunImageTasks(ImageTaskFunc func, void *data, int count, int minChunk);    // Run func over items [0, count) on the worker threads
+static void ResizeNNRows(void *data, int start, int end);   // Copy rows of a nearest-neighbor resize
+static void ResizePixels8(const unsigned char *pixels, int width, int height, unsigned char *output, int newWidth, int newHeight, int channels);  // Resize 8 bit channels on the worker threads
+static void BlurRows(void *data, int start, int end);       // Blur RGBA8 row strips horizontally, premultiplying alpha
+static void BlurColumns(void *data, int start, int end);    // Blur RGBA8 column strips vertically, reversing alpha premultiply
+static void ConvolveSeparableTiles(void *data, int start, int end);    // Convolve RGBA8 tiles with a separable kernel
+static void ConvolveFixedTiles(void *data, int start, int end);        // Convolve RGBA8 tiles with a fixed point kernel
+static void StorePixelColor(unsigned char *pixel, Color color, int format);    // Store color in any uncompressed pixel format
+static PixelPen LoadPixelPen(int format, Color color, bool blend);      // Convert color once for spans drawn on a pixel format
+static void FillPixelSpan(unsigned char *dst, const void *pixel, int bytesPerPixel, int count);   // Repeat one pixel count times
+static void DrawPenSpan(Image *dst, const PixelPen *pen, int x, int y, int width);    // Draw span of pixels, clipped to the image
 
 //----------------------------------------------------------------------------------
 // Module Functions Definition
@@ -1262,189 +1388,201 @@ void ImageFormat(Image *image, int newFormat)
     {
         if ((image->format < PIXELFORMAT_COMPRESSED_DXT1_RGB) && (newFormat < PIXELFORMAT_COMPRESSED_DXT1_RGB))
         {
-            Vector4 *pixels = LoadImageDataNormalized(*image);     // Supports 8 to 32 bit per channel
+            // 8 bit and packed 16 bit formats convert directly, the rest through normalized floats
+            void *converted = ConvertPixelsDirect(image->data, image->width*image->height, image->format, newFormat);
 
-            RL_FREE(image->data);      // WARNING! We loose mipmaps data --> Regenerated at the end...
-            image->data = NULL;
-            image->format = newFormat;
-
-            switch (image->format)
+            if (converted != NULL)
             {
-                case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE:
-                {
-                    image->data = (unsigned char *)RL_MALLOC(image->width*image->height*sizeof(unsigned char));
+                RL_FREE(image->data);
+                image->data = converted;
+                image->format = newFormat;
+            }
+            else
+            {
+                Vector4 *pixels = LoadImageDataNormalized(*image);     // Supports 8 to 32 bit per channel
 
-                    for (int i = 0; i < image->width*image->height; i++)
-                    {
-                        ((unsigned char *)image->data)[i] = (unsigned char)((pixels[i].x*0.299f + pixels[i].y*0.587f + pixels[i].z*0.114f)*255.0f);
-                    }
+                RL_FREE(image->data);      // WARNING! We loose mipmaps data --> Regenerated at the end...
+                image->data = NULL;
+                image->format = newFormat;
 
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+                switch (image->format)
                 {
-                    image->data = (unsigned char *)RL_MALLOC(image->width*image->height*2*sizeof(unsigned char));
-
-                    for (int i = 0, k = 0; i < image->width*image->height*2; i += 2, k++)
+                    case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE:
                     {
-                        ((unsigned char *)image->data)[i] = (unsigned char)((pixels[k].x*0.299f + (float)pixels[k].y*0.587f + (float)pixels[k].z*0.114f)*255.0f);
-                        ((unsigned char *)image->data)[i + 1] = (unsigned char)(pixels[k].w*255.0f);
-                    }
+                        image->data = (unsigned char *)RL_MALLOC(image->width*image->height*sizeof(unsigned char));
 
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
-                {
-                    image->data = (unsigned short *)RL_MALLOC(image->width*image->height*sizeof(unsigned short));
+                        for (int i = 0; i < image->width*image->height; i++)
+                        {
+                            ((unsigned char *)image->data)[i] = (unsigned char)((pixels[i].x*0.299f + pixels[i].y*0.587f + pixels[i].z*0.114f)*255.0f);
+                        }
+
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+                    {
+                        image->data = (unsigned char *)RL_MALLOC(image->width*image->height*2*sizeof(unsigned char));
 
-                    unsigned char r = 0;
-                    unsigned char g = 0;
-                    unsigned char b = 0;
+                        for (int i = 0, k = 0; i < image->width*image->height*2; i += 2, k++)
+                        {
+                            ((unsigned char *)image->data)[i] = (unsigned char)((pixels[k].x*0.299f + (float)pixels[k].y*0.587f + (float)pixels[k].z*0.114f)*255.0f);
+                            ((unsigned char *)image->data)[i + 1] = (unsigned char)(pixels[k].w*255.0f);
+                        }
 
-                    for (int i = 0; i < image->width*image->height; i++)
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
                     {
-                        r = (unsigned char)(round(pixels[i].x*31.0f));
-                        g = (unsigned char)(round(pixels[i].y*63.0f));
-                        b = (unsigned char)(round(pixels[i].z*31.0f));
+                        image->data = (unsigned short *)RL_MALLOC(image->width*image->height*sizeof(unsigned short));
 
-                        ((unsigned short *)image->data)[i] = (unsigned short)r << 11 | (unsigned short)g << 5 | (unsigned short)b;
-                    }
+                        unsigned char r = 0;
+                        unsigned char g = 0;
+                        unsigned char b = 0;
 
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
-                {
-                    image->data = (unsigned char *)RL_MALLOC(image->width*image->height*3*sizeof(unsigned char));
+                        for (int i = 0; i < image->width*image->height; i++)
+                        {
+                            r = (unsigned char)(round(pixels[i].x*31.0f));
+                            g = (unsigned char)(round(pixels[i].y*63.0f));
+                            b = (unsigned char)(round(pixels[i].z*31.0f));
 
-                    for (int i = 0, k = 0; i < image->width*image->height*3; i += 3, k++)
-                    {
-                        ((unsigned char *)image->data)[i] = (unsigned char)(pixels[k].x*255.0f);
-                        ((unsigned char *)image->data)[i + 1] = (unsigned char)(pixels[k].y*255.0f);
-                        ((unsigned char *)image->data)[i + 2] = (unsigned char)(pixels[k].z*255.0f);
-                    }
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
-                {
-                    image->data = (unsigned short *)RL_MALLOC(image->width*image->height*sizeof(unsigned short));
+                            ((unsigned short *)image->data)[i] = (unsigned short)r << 11 | (unsigned short)g << 5 | (unsigned short)b;
+                        }
 
-                    unsigned char r = 0;
-                    unsigned char g = 0;
-                    unsigned char b = 0;
-                    unsigned char a = 0;
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
+                    {
+                        image->data = (unsigned char *)RL_MALLOC(image->width*image->height*3*sizeof(unsigned char));
 
-                    for (int i = 0; i < image->width*image->height; i++)
+                        for (int i = 0, k = 0; i < image->width*image->height*3; i += 3, k++)
+                        {
+                            ((unsigned char *)image->data)[i] = (unsigned char)(pixels[k].x*255.0f);
+                            ((unsigned char *)image->data)[i + 1] = (unsigned char)(pixels[k].y*255.0f);
+                            ((unsigned char *)image->data)[i + 2] = (unsigned char)(pixels[k].z*255.0f);
+                        }
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
                     {
-                        r = (unsigned char)(round(pixels[i].x*31.0f));
-                        g = (unsigned char)(round(pixels[i].y*31.0f));
-                        b = (unsigned char)(round(pixels[i].z*31.0f));
-                        a = (pixels[i].w > ((float)PIXELFORMAT_UNCOMPRESSED_R5G5B5A1_ALPHA_THRESHOLD/255.0f))? 1 : 0;
+                        image->data = (unsigned short *)RL_MALLOC(image->width*image->height*sizeof(unsigned short));
 
-                        ((unsigned short *)image->data)[i] = (unsigned short)r << 11 | (unsigned short)g << 6 | (unsigned short)b << 1 | (unsigned short)a;
-                    }
+                        unsigned char r = 0;
+                        unsigned char g = 0;
+                        unsigned char b = 0;
+                        unsigned char a = 0;
 
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
-                {
-                    image->data = (unsigned short *)RL_MALLOC(image->width*image->height*sizeof(unsigned short));
+                        for (int i = 0; i < image->width*image->height; i++)
+                        {
+                            r = (unsigned char)(round(pixels[i].x*31.0f));
+                            g = (unsigned char)(round(pixels[i].y*31.0f));
+                            b = (unsigned char)(round(pixels[i].z*31.0f));
+                            a = (pixels[i].w > ((float)PIXELFORMAT_UNCOMPRESSED_R5G5B5A1_ALPHA_THRESHOLD/255.0f))? 1 : 0;
 
-                    unsigned char r = 0;
-                    unsigned char g = 0;
-                    unsigned char b = 0;
-                    unsigned char a = 0;
+                            ((unsigned short *)image->data)[i] = (unsigned short)r << 11 | (unsigned short)g << 6 | (unsigned short)b << 1 | (unsigned short)a;
+                        }
 
-                    for (int i = 0; i < image->width*image->height; i++)
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
                     {
-                        r = (unsigned char)(round(pixels[i].x*15.0f));
-                        g = (unsigned char)(round(pixels[i].y*15.0f));
-                        b = (unsigned char)(round(pixels[i].z*15.0f));
-                        a = (unsigned char)(round(pixels[i].w*15.0f));
+                        image->data = (unsigned short *)RL_MALLOC(image->width*image->height*sizeof(unsigned short));
 
-                        ((unsigned short *)image->data)[i] = (unsigned short)r << 12 | (unsigned short)g << 8 | (unsigned short)b << 4 | (unsigned short)a;
-                    }
+                        unsigned char r = 0;
+                        unsigned char g = 0;
+                        unsigned char b = 0;
+                        unsigned char a = 0;
 
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8:
-                {
-                    image->data = (unsigned char *)RL_MALLOC(image->width*image->height*4*sizeof(unsigned char));
+                        for (int i = 0; i < image->width*image->height; i++)
+                        {
+                            r = (unsigned char)(round(pixels[i].x*15.0f));
+                            g = (unsigned char)(round(pixels[i].y*15.0f));
+                            b = (unsigned char)(round(pixels[i].z*15.0f));
+                            a = (unsigned char)(round(pixels[i].w*15.0f));
 
-                    for (int i = 0, k = 0; i < image->width*image->height*4; i += 4, k++)
+                            ((unsigned short *)image->data)[i] = (unsigned short)r << 12 | (unsigned short)g << 8 | (unsigned short)b << 4 | (unsigned short)a;
+                        }
+
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8:
                     {
-                        ((unsigned char *)image->data)[i] = (unsigned char)(pixels[k].x*255.0f);
-                        ((unsigned char *)image->data)[i + 1] = (unsigned char)(pixels[k].y*255.0f);
-                        ((unsigned char *)image->data)[i + 2] = (unsigned char)(pixels[k].z*255.0f);
-                        ((unsigned char *)image->data)[i + 3] = (unsigned char)(pixels[k].w*255.0f);
-                    }
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_R32:
-                {
-                    // WARNING: Image is converted to GRAYSCALE equivalent 32bit
+                        image->data = (unsigned char *)RL_MALLOC(image->width*image->height*4*sizeof(unsigned char));
+
+                        for (int i = 0, k = 0; i < image->width*image->height*4; i += 4, k++)
+                        {
+                            ((unsigned char *)image->data)[i] = (unsigned char)(pixels[k].x*255.0f);
+                            ((unsigned char *)image->data)[i + 1] = (unsigned char)(pixels[k].y*255.0f);
+                            ((unsigned char *)image->data)[i + 2] = (unsigned char)(pixels[k].z*255.0f);
+                            ((unsigned char *)image->data)[i + 3] = (unsigned char)(pixels[k].w*255.0f);
+                        }
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_R32:
+                    {
+                        // WARNING: Image is converted to GRAYSCALE equivalent 32bit
 
-                    image->data = (float *)RL_MALLOC(image->width*image->height*sizeof(float));
+                        image->data = (float *)RL_MALLOC(image->width*image->height*sizeof(float));
 
-                    for (int i = 0; i < image->width*image->height; i++)
+                        for (int i = 0; i < image->width*image->height; i++)
+                        {
+                            ((float *)image->data)[i] = (float)(pixels[i].x*0.299f + pixels[i].y*0.587f + pixels[i].z*0.114f);
+                        }
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_R32G32B32:
                     {
-                        ((float *)image->data)[i] = (float)(pixels[i].x*0.299f + pixels[i].y*0.587f + pixels[i].z*0.114f);
-                    }
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_R32G32B32:
-                {
-                    image->data = (float *)RL_MALLOC(image->width*image->height*3*sizeof(float));
+                        image->data = (float *)RL_MALLOC(image->width*image->height*3*sizeof(float));
 
-                    for (int i = 0, k = 0; i < image->width*image->height*3; i += 3, k++)
+                        for (int i = 0, k = 0; i < image->width*image->height*3; i += 3, k++)
+                        {
+                            ((float *)image->data)[i] = pixels[k].x;
+                            ((float *)image->data)[i + 1] = pixels[k].y;
+                            ((float *)image->data)[i + 2] = pixels[k].z;
+                        }
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_R32G32B32A32:
                     {
-                        ((float *)image->data)[i] = pixels[k].x;
-                        ((float *)image->data)[i + 1] = pixels[k].y;
-                        ((float *)image->data)[i + 2] = pixels[k].z;
-                    }
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_R32G32B32A32:
-                {
-                    image->data = (float *)RL_MALLOC(image->width*image->height*4*sizeof(float));
+                        image->data = (float *)RL_MALLOC(image->width*image->height*4*sizeof(float));
 
-                    for (int i = 0, k = 0; i < image->width*image->height*4; i += 4, k++)
+                        for (int i = 0, k = 0; i < image->width*image->height*4; i += 4, k++)
+                        {
+                            ((float *)image->data)[i] = pixels[k].x;
+                            ((float *)image->data)[i + 1] = pixels[k].y;
+                            ((float *)image->data)[i + 2] = pixels[k].z;
+                            ((float *)image->data)[i + 3] = pixels[k].w;
+                        }
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_R16:
                     {
-                        ((float *)image->data)[i] = pixels[k].x;
-                        ((float *)image->data)[i + 1] = pixels[k].y;
-                        ((float *)image->data)[i + 2] = pixels[k].z;
-                        ((float *)image->data)[i + 3] = pixels[k].w;
-                    }
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_R16:
-                {
-                    // WARNING: Image is converted to GRAYSCALE equivalent 16bit
+                        // WARNING: Image is converted to GRAYSCALE equivalent 16bit
 
-                    image->data = (unsigned short *)RL_MALLOC(image->width*image->height*sizeof(unsigned short));
+                        image->data = (unsigned short *)RL_MALLOC(image->width*image->height*sizeof(unsigned short));
 
-                    for (int i = 0; i < image->width*image->height; i++)
+                        for (int i = 0; i < image->width*image->height; i++)
+                        {
+                            ((unsigned short *)image->data)[i] = FloatToHalf((float)(pixels[i].x*0.299f + pixels[i].y*0.587f + pixels[i].z*0.114f));
+                        }
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_R16G16B16:
                     {
-                        ((unsigned short *)image->data)[i] = FloatToHalf((float)(pixels[i].x*0.299f + pixels[i].y*0.587f + pixels[i].z*0.114f));
-                    }
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_R16G16B16:
-                {
-                    image->data = (unsigned short *)RL_MALLOC(image->width*image->height*3*sizeof(unsigned short));
+                        image->data = (unsigned short *)RL_MALLOC(image->width*image->height*3*sizeof(unsigned short));
 
-                    for (int i = 0, k = 0; i < image->width*image->height*3; i += 3, k++)
+                        for (int i = 0, k = 0; i < image->width*image->height*3; i += 3, k++)
+                        {
+                            ((unsigned short *)image->data)[i] = FloatToHalf(pixels[k].x);
+                            ((unsigned short *)image->data)[i + 1] = FloatToHalf(pixels[k].y);
+                            ((unsigned short *)image->data)[i + 2] = FloatToHalf(pixels[k].z);
+                        }
+                    } break;
+                    case PIXELFORMAT_UNCOMPRESSED_R16G16B16A16:
                     {
-                        ((unsigned short *)image->data)[i] = FloatToHalf(pixels[k].x);
-                        ((unsigned short *)image->data)[i + 1] = FloatToHalf(pixels[k].y);
-                        ((unsigned short *)image->data)[i + 2] = FloatToHalf(pixels[k].z);
-                    }
-                } break;
-                case PIXELFORMAT_UNCOMPRESSED_R16G16B16A16:
-                {
-                    image->data = (unsigned short *)RL_MALLOC(image->width*image->height*4*sizeof(unsigned short));
+                        image->data = (unsigned short *)RL_MALLOC(image->width*image->height*4*sizeof(unsigned short));
 
-                    for (int i = 0, k = 0; i < image->width*image->height*4; i += 4, k++)
-                    {
-                        ((unsigned short *)image->data)[i] = FloatToHalf(pixels[k].x);
-                        ((unsigned short *)image->data)[i + 1] = FloatToHalf(pixels[k].y);
-                        ((unsigned short *)image->data)[i + 2] = FloatToHalf(pixels[k].z);
-                        ((unsigned short *)image->data)[i + 3] = FloatToHalf(pixels[k].w);
-                    }
-                } break;
-                default: break;
-            }
+                        for (int i = 0, k = 0; i < image->width*image->height*4; i += 4, k++)
+                        {
+                            ((unsigned short *)image->data)[i] = FloatToHalf(pixels[k].x);
+                            ((unsigned short *)image->data)[i + 1] = FloatToHalf(pixels[k].y);
+                            ((unsigned short *)image->data)[i + 2] = FloatToHalf(pixels[k].z);
+                            ((unsigned short *)image->data)[i + 3] = FloatToHalf(pixels[k].w);
+                        }
+                    } break;
+                    default: break;
+                }
 
-            RL_FREE(pixels);
-            pixels = NULL;
+                RL_FREE(pixels);
+                pixels = NULL;
+            }
 
             // In case original image had mipmaps, generate mipmaps for formatted image
             // NOTE: Original mipmaps are replaced by new ones, if custom mipmaps were used, they are lost
@@ -1715,37 +1853,60 @@ void ImageResizeNN(Image *image,int newWidth,int newHeight)
     // Security check to avoid program crash
     if ((image->data == NULL) || (image->width == 0) || (image->height == 0)) return;
 
-    Color *pixels = LoadImageColors(*image);
-    Color *output = (Color *)RL_MALLOC(newWidth*newHeight*sizeof(Color));
-
     // EDIT: added +1 to account for an early rounding problem
     int xRatio = (int)((image->width << 16)/newWidth) + 1;
     int yRatio = (int)((image->height << 16)/newHeight) + 1;
 
-    int x2, y2;
-    for (int y = 0; y < newHeight; y++)
+    if (image->format < PIXELFORMAT_COMPRESSED_DXT1_RGB)
+    {
+        // Uncompressed pixels are copied as they are, no need to go through RGBA
+        int pixelSize = GetPixelDataSize(1, 1, image->format);
+        unsigned char *output = (unsigned char *)RL_MALLOC((size_t)newWidth*newHeight*pixelSize);
+        int *srcX = (int *)RL_MALLOC(newWidth*sizeof(int));
+
+        for (int x = 0; x < newWidth; x++) srcX[x] = (x*xRatio) >> 16;
+
+        ResizeNNTask task = { (const unsigned char *)image->data, output, image->width, newWidth, pixelSize, yRatio, srcX };
+        RunImageTasks(ResizeNNRows, &task, newHeight, IMAGE_TASK_MIN_PIXELS/newWidth);
+
+        RL_FREE(srcX);
+        RL_FREE(image->data);
+
+        image->data = output;
+        image->width = newWidth;
+        image->height = newHeight;
+        image->mipmaps = 1;
+    }
+    else
     {
-        for (int x = 0; x < newWidth; x++)
+        Color *pixels = LoadImageColors(*image);
+        Color *output = (Color *)RL_MALLOC(newWidth*newHeight*sizeof(Color));
+
+        int x2, y2;
+        for (int y = 0; y < newHeight; y++)
         {
-            x2 = ((x*xRatio) >> 16);
-            y2 = ((y*yRatio) >> 16);
+            for (int x = 0; x < newWidth; x++)
+            {
+                x2 = ((x*xRatio) >> 16);
+                y2 = ((y*yRatio) >> 16);
 
-            output[(y*newWidth) + x] = pixels[(y2*image->width) + x2] ;
+                output[(y*newWidth) + x] = pixels[(y2*image->width) + x2] ;
+            }
         }
-    }
 
-    int format = image->format;
+        int format = image->format;
 
-    RL_FREE(image->data);
+        RL_FREE(image->data);
 
-    image->data = output;
-    image->width = newWidth;
-    image->height = newHeight;
-    image->format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        image->data = output;
+        image->width = newWidth;
+        image->height = newHeight;
+        image->format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
 
-    ImageFormat(image, format);  // Reformat 32bit RGBA image to original format
+        ImageFormat(image, format);  // Reformat 32bit RGBA image to original format
 
-    UnloadImageColors(pixels);
+        UnloadImageColors(pixels);
+    }
 }
 
 // Resize and image to new size
@@ -1764,17 +1925,11 @@ void ImageResize(Image *image, int newWidth, int newHeight)
         (image->format == PIXELFORMAT_UNCOMPRESSED_R8G8B8) ||
         (image->format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8))
     {
+        // NOTE: Channels count matches stbir_pixel_layout values STBIR_1CHANNEL to STBIR_RGBA
         int bytesPerPixel = GetPixelDataSize(1, 1, image->format);
         unsigned char *output = (unsigned char *)RL_MALLOC(newWidth*newHeight*bytesPerPixel);
 
-        switch (image->format)
-        {
-            case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: stbir_resize_uint8_linear((unsigned char *)image->data, image->width, image->height, 0, output, newWidth, newHeight, 0, (stbir_pixel_layout)1); break;
-            case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA: stbir_resize_uint8_linear((unsigned char *)image->data, image->width, image->height, 0, output, newWidth, newHeight, 0, (stbir_pixel_layout)2); break;
-            case PIXELFORMAT_UNCOMPRESSED_R8G8B8: stbir_resize_uint8_linear((unsigned char *)image->data, image->width, image->height, 0, output, newWidth, newHeight, 0, (stbir_pixel_layout)3); break;
-            case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8: stbir_resize_uint8_linear((unsigned char *)image->data, image->width, image->height, 0, output, newWidth, newHeight, 0, (stbir_pixel_layout)4); break;
-            default: break;
-        }
+        ResizePixels8((unsigned char *)image->data, image->width, image->height, output, newWidth, newHeight, bytesPerPixel);
 
         RL_FREE(image->data);
         image->data = output;
@@ -1788,7 +1943,7 @@ void ImageResize(Image *image, int newWidth, int newHeight)
         Color *output = (Color *)RL_MALLOC(newWidth*newHeight*sizeof(Color));
 
         // NOTE: Color data is cast to (unsigned char *), there shouldn't been any problem...
-        stbir_resize_uint8_linear((unsigned char *)pixels, image->width, image->height, 0, (unsigned char *)output, newWidth, newHeight, 0, (stbir_pixel_layout)4);
+        ResizePixels8((unsigned char *)pixels, image->width, image->height, (unsigned char *)output, newWidth, newHeight, 4);
 
         int format = image->format;
 
@@ -2092,151 +2247,42 @@ void ImageAlphaPremultiply(Image *image)
 }
 
 // Apply box blur to image
+// NOTE: Blurs RGBA8 pixel data in place, other formats go through RGBA8
 void ImageBlurGaussian(Image *image, int blurSize)
 {
     // Security check to avoid program crash
     if ((image->data == NULL) || (image->width == 0) || (image->height == 0)) return;
 
-    ImageAlphaPremultiply(image);
-
-    Color *pixels = LoadImageColors(*image);
-
-    // Loop switches between pixelsCopy1 and pixelsCopy2
-    Vector4 *pixelsCopy1 = RL_MALLOC((image->height)*(image->width)*sizeof(Vector4));
-    Vector4 *pixelsCopy2 = RL_MALLOC((image->height)*(image->width)*sizeof(Vector4));
-
-    for (int i = 0; i < (image->height*image->width); i++)
+    if (image->format >= PIXELFORMAT_COMPRESSED_DXT1_RGB)
     {
-        pixelsCopy1[i].x = pixels[i].r;
-        pixelsCopy1[i].y = pixels[i].g;
-        pixelsCopy1[i].z = pixels[i].b;
-        pixelsCopy1[i].w = pixels[i].a;
+        TRACELOG(LOG_WARNING, "Image manipulation not supported for compressed formats");
+        return;
     }
+    if (blurSize < 1) return;
 
-    // Repeated convolution of rectangular window signal by itself converges to a gaussian distribution
-    for (int j = 0; j < GAUSSIAN_BLUR_ITERATIONS; j++)
-    {
-        // Horizontal motion blur
-        for (int row = 0; row < image->height; row++)
-        {
-            float avgR = 0.0f;
-            float avgG = 0.0f;
-            float avgB = 0.0f;
-            float avgAlpha = 0.0f;
-            int convolutionSize = blurSize;
-
-            for (int i = 0; i < blurSize; i++)
-            {
-                avgR += pixelsCopy1[row*image->width + i].x;
-                avgG += pixelsCopy1[row*image->width + i].y;
-                avgB += pixelsCopy1[row*image->width + i].z;
-                avgAlpha += pixelsCopy1[row*image->width + i].w;
-            }
-
-            for (int x = 0; x < image->width; x++)
-            {
-                if (x-blurSize-1 >= 0)
-                {
-                    avgR -= pixelsCopy1[row*image->width + x-blurSize-1].x;
-                    avgG -= pixelsCopy1[row*image->width + x-blurSize-1].y;
-                    avgB -= pixelsCopy1[row*image->width + x-blurSize-1].z;
-                    avgAlpha -= pixelsCopy1[row*image->width + x-blurSize-1].w;
-                    convolutionSize--;
-                }
-
-                if (x+blurSize < image->width)
-                {
-                    avgR += pixelsCopy1[row*image->width + x+blurSize].x;
-                    avgG += pixelsCopy1[row*image->width + x+blurSize].y;
-                    avgB += pixelsCopy1[row*image->width + x+blurSize].z;
-                    avgAlpha += pixelsCopy1[row*image->width + x+blurSize].w;
-                    convolutionSize++;
-                }
-
-                pixelsCopy2[row*image->width + x].x = avgR/convolutionSize;
-                pixelsCopy2[row*image->width + x].y = avgG/convolutionSize;
-                pixelsCopy2[row*image->width + x].z = avgB/convolutionSize;
-                pixelsCopy2[row*image->width + x].w = avgAlpha/convolutionSize;
-            }
-        }
-
-        // Vertical motion blur
-        for (int col = 0; col < image->width; col++)
-        {
-            float avgR = 0.0f;
-            float avgG = 0.0f;
-            float avgB = 0.0f;
-            float avgAlpha = 0.0f;
-            int convolutionSize = blurSize;
-
-            for (int i = 0; i < blurSize; i++)
-            {
-                avgR += pixelsCopy2[i*image->width + col].x;
-                avgG += pixelsCopy2[i*image->width + col].y;
-                avgB += pixelsCopy2[i*image->width + col].z;
-                avgAlpha += pixelsCopy2[i*image->width + col].w;
-            }
-
-            for (int y = 0; y < image->height; y++)
-            {
-                if (y-blurSize-1 >= 0)
-                {
-                    avgR -= pixelsCopy2[(y-blurSize-1)*image->width + col].x;
-                    avgG -= pixelsCopy2[(y-blurSize-1)*image->width + col].y;
-                    avgB -= pixelsCopy2[(y-blurSize-1)*image->width + col].z;
-                    avgAlpha -= pixelsCopy2[(y-blurSize-1)*image->width + col].w;
-                    convolutionSize--;
-                }
-                if (y+blurSize < image->height)
-                {
-                    avgR += pixelsCopy2[(y+blurSize)*image->width + col].x;
-                    avgG += pixelsCopy2[(y+blurSize)*image->width + col].y;
-                    avgB += pixelsCopy2[(y+blurSize)*image->width + col].z;
-                    avgAlpha += pixelsCopy2[(y+blurSize)*image->width + col].w;
-                    convolutionSize++;
-                }
-
-                pixelsCopy1[y*image->width + col].x = (unsigned char) (avgR/convolutionSize);
-                pixelsCopy1[y*image->width + col].y = (unsigned char) (avgG/convolutionSize);
-                pixelsCopy1[y*image->width + col].z = (unsigned char) (avgB/convolutionSize);
-                pixelsCopy1[y*image->width + col].w = (unsigned char) (avgAlpha/convolutionSize);
-            }
-        }
-    }
+    int format = image->format;
+    ImageFormat(image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
 
-    // Reverse premultiply
-    for (int i = 0; i < (image->width)*(image->height); i++)
-    {
-        if (pixelsCopy1[i].w == 0.0f)
-        {
-            pixels[i].r = 0;
-            pixels[i].g = 0;
-            pixels[i].b = 0;
-            pixels[i].a = 0;
-        }
-        else if (pixelsCopy1[i].w <= 255.0f)
-        {
-            float alpha = (float)pixelsCopy1[i].w/255.0f;
-            pixels[i].r = (unsigned char)((float)pixelsCopy1[i].x/alpha);
-            pixels[i].g = (unsigned char)((float)pixelsCopy1[i].y/alpha);
-            pixels[i].b = (unsigned char)((float)pixelsCopy1[i].z/alpha);
-            pixels[i].a = (unsigned char) pixelsCopy1[i].w;
-        }
-    }
+    // Repeated convolution of rectangular window signal by itself converges to a gaussian distribution
+    // NOTE: Window sums are updated while sliding, blurSize does not change the cost
+    BlurTask task = { (unsigned char *)image->data, image->width, image->height, 0 };
 
-    int format = image->format;
-    RL_FREE(image->data);
-    RL_FREE(pixelsCopy1);
-    RL_FREE(pixelsCopy2);
+    // Horizontal passes over strips of rows, alpha premultiplied on load
+    task.radius = (blurSize < image->width)? blurSize : image->width - 1;
+    if (task.radius > BLUR_MAX_RADIUS) task.radius = BLUR_MAX_RADIUS;
+    RunImageTasks(BlurRows, &task, (image->height + BLUR_STRIP_PIXELS - 1)/BLUR_STRIP_PIXELS, IMAGE_TASK_MIN_PIXELS/(BLUR_STRIP_PIXELS*image->width));
 
-    image->data = pixels;
-    image->format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    // Vertical passes over strips of columns, alpha premultiply reversed on store
+    task.radius = (blurSize < image->height)? blurSize : image->height - 1;
+    if (task.radius > BLUR_MAX_RADIUS) task.radius = BLUR_MAX_RADIUS;
+    RunImageTasks(BlurColumns, &task, (image->width + BLUR_STRIP_PIXELS - 1)/BLUR_STRIP_PIXELS, IMAGE_TASK_MIN_PIXELS/(BLUR_STRIP_PIXELS*image->height));
 
     ImageFormat(image, format);
 }
 
 // Apply custom square convolution kernel to image
-// NOTE: The convolution kernel matrix is expected to be square
+// NOTE: The convolution kernel matrix is expected to be square, pixels out of the image count as zero.
+// Separable kernels (a column times a row) run as two passes, other kernels in 16 bit fixed point
 void ImageKernelConvolution(Image *image, const float *kernel, int kernelSize)
 {
     if ((image->data == NULL) || (image->width == 0) || (image->height == 0) || kernel == NULL) return;
@@ -2249,119 +2295,82 @@ void ImageKernelConvolution(Image *image, const float *kernel, int kernelSize)
         return;
     }
 
-    Color *pixels = LoadImageColors(*image);
-
-    Vector4 *imageCopy2 = RL_MALLOC((image->height)*(image->width)*sizeof(Vector4));
-    Vector4 *temp = RL_MALLOC(kernelSize*sizeof(Vector4));
-
-    for (int i = 0; i < kernelSize; i++)
+    if (image->format >= PIXELFORMAT_COMPRESSED_DXT1_RGB)
     {
-        temp[i].x = 0.0f;
-        temp[i].y = 0.0f;
-        temp[i].z = 0.0f;
-        temp[i].w = 0.0f;
+        TRACELOG(LOG_WARNING, "Image manipulation not supported for compressed formats");
+        return;
     }
 
-    float rRes = 0.0f;
-    float gRes = 0.0f;
-    float bRes = 0.0f;
-    float aRes = 0.0f;
+    // Kernel is separable when every weight is its column weight (at the largest weight row)
+    // times its row weight (at the largest weight column, divided by the largest weight)
+    int peak = 0;
+    for (int i = 1; i < kernelSize; i++) if (fabsf(kernel[i]) > fabsf(kernel[peak])) peak = i;
 
-    int startRange = 0, endRange = 0;
+    float largest = fabsf(kernel[peak]);
+    float *rowWeights = (float *)RL_MALLOC(kernelWidth*sizeof(float));
+    float *columnWeights = (float *)RL_MALLOC(kernelWidth*sizeof(float));
+    bool separable = true;
 
-    if (kernelWidth%2 == 0)
+    for (int i = 0; i < kernelWidth; i++)
     {
-        startRange = -kernelWidth/2;
-        endRange = kernelWidth/2;
+        rowWeights[i] = (largest > 0.0f)? kernel[(peak/kernelWidth)*kernelWidth + i]/kernel[peak] : 0.0f;
+        columnWeights[i] = kernel[i*kernelWidth + peak%kernelWidth];
     }
-    else
+
+    for (int i = 0; (i < kernelSize) && separable; i++)
     {
-        startRange = -kernelWidth/2;
-        endRange = kernelWidth/2 + 1;
+        if (fabsf(kernel[i] - columnWeights[i/kernelWidth]*rowWeights[i%kernelWidth]) > largest*1e-5f) separable = false;
     }
 
-    for (int x = 0; x < image->height; x++)
+    // Other kernels weights in fixed point with as many fraction bits as fit 16 bit,
+    // rounded keeping their running sum exact so flat areas keep their level
+    int pairs = (kernelWidth + 1)/2;
+    int *fixedWeights = NULL;
+    int shift = 14;
+
+    if (!separable)
     {
-        for (int y = 0; y < image->width; y++)
+        if (largest > 32766.0f)
         {
-            for (int xk = startRange; xk < endRange; xk++)
-            {
-                for (int yk = startRange; yk < endRange; yk++)
-                {
-                    int xkabs = xk + kernelWidth/2;
-                    int ykabs = yk + kernelWidth/2;
-                    unsigned int imgindex = image->width*(x + xk) + (y + yk);
-
-                    if (imgindex >= (unsigned int)(image->width*image->height))
-                    {
-                        temp[kernelWidth*xkabs + ykabs].x = 0.0f;
-                        temp[kernelWidth*xkabs + ykabs].y = 0.0f;
-                        temp[kernelWidth*xkabs + ykabs].z = 0.0f;
-                        temp[kernelWidth*xkabs + ykabs].w = 0.0f;
-                    }
-                    else
-                    {
-                        temp[kernelWidth*xkabs + ykabs].x = ((float)pixels[imgindex].r)/255.0f*kernel[kernelWidth*xkabs + ykabs];
-                        temp[kernelWidth*xkabs + ykabs].y = ((float)pixels[imgindex].g)/255.0f*kernel[kernelWidth*xkabs + ykabs];
-                        temp[kernelWidth*xkabs + ykabs].z = ((float)pixels[imgindex].b)/255.0f*kernel[kernelWidth*xkabs + ykabs];
-                        temp[kernelWidth*xkabs + ykabs].w = ((float)pixels[imgindex].a)/255.0f*kernel[kernelWidth*xkabs + ykabs];
-                    }
-                }
-            }
-
-            for (int i = 0; i < kernelSize; i++)
-            {
-                rRes += temp[i].x;
-                gRes += temp[i].y;
-                bRes += temp[i].z;
-                aRes += temp[i].w;
-            }
-
-            if (rRes < 0.0f) rRes = 0.0f;
-            if (gRes < 0.0f) gRes = 0.0f;
-            if (bRes < 0.0f) bRes = 0.0f;
+            TRACELOG(LOG_WARNING, "IMAGE: Convolution kernel weights must be under 32767 to be applied");
+            RL_FREE(rowWeights);
+            RL_FREE(columnWeights);
+            return;
+        }
 
-            if (rRes > 1.0f) rRes = 1.0f;
-            if (gRes > 1.0f) gRes = 1.0f;
-            if (bRes > 1.0f) bRes = 1.0f;
+        while ((shift > 0) && (largest*(float)(1 << shift) > 32766.0f)) shift--;
 
-            imageCopy2[image->width*x + y].x = rRes;
-            imageCopy2[image->width*x + y].y = gRes;
-            imageCopy2[image->width*x + y].z = bRes;
-            imageCopy2[image->width*x + y].w = aRes;
+        fixedWeights = (int *)RL_CALLOC(kernelWidth*pairs, sizeof(int));
+        double total = 0.0;
+        long rounded = 0;
 
-            rRes = 0.0f;
-            gRes = 0.0f;
-            bRes = 0.0f;
-            aRes = 0.0f;
+        for (int i = 0; i < kernelSize; i++)
+        {
+            total += (double)kernel[i]*(double)(1 << shift);
+            long next = (long)floor(total + 0.5);
+            unsigned int weight = (unsigned short)(short)(next - rounded);
+            rounded = next;
 
-            for (int i = 0; i < kernelSize; i++)
-            {
-                temp[i].x = 0.0f;
-                temp[i].y = 0.0f;
-                temp[i].z = 0.0f;
-                temp[i].w = 0.0f;
-            }
+            // Weights paired per kernel row for _mm_madd_epi16(), the first one in the low half
+            fixedWeights[(i/kernelWidth)*pairs + (i%kernelWidth)/2] |= (int)(((i%kernelWidth)%2 == 0)? weight : weight << 16);
         }
     }
 
-    for (int i = 0; i < (image->width*image->height); i++)
-    {
-        float alpha = (float)imageCopy2[i].w;
+    int format = image->format;
+    ImageFormat(image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
 
-        pixels[i].r = (unsigned char)((imageCopy2[i].x)*255.0f);
-        pixels[i].g = (unsigned char)((imageCopy2[i].y)*255.0f);
-        pixels[i].b = (unsigned char)((imageCopy2[i].z)*255.0f);
-        pixels[i].a = (unsigned char)((alpha)*255.0f);
-    }
+    unsigned char *output = (unsigned char *)RL_MALLOC((size_t)image->width*image->height*4);
+    ConvolutionTask task = { (const unsigned char *)image->data, output, image->width, image->height, kernelWidth, rowWeights, columnWeights, fixedWeights, shift };
+    int tiles = ((image->width + CONVOLUTION_TILE - 1)/CONVOLUTION_TILE)*((image->height + CONVOLUTION_TILE - 1)/CONVOLUTION_TILE);
+
+    RunImageTasks(separable? ConvolveSeparableTiles : ConvolveFixedTiles, &task, tiles, IMAGE_TASK_MIN_PIXELS/(CONVOLUTION_TILE*CONVOLUTION_TILE));
 
-    int format = image->format;
     RL_FREE(image->data);
-    RL_FREE(imageCopy2);
-    RL_FREE(temp);
+    RL_FREE(rowWeights);
+    RL_FREE(columnWeights);
+    RL_FREE(fixedWeights);
 
-    image->data = pixels;
-    image->format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    image->data = output;
     ImageFormat(image, format);
 }
 
@@ -3326,17 +3335,9 @@ void ImageClearBackground(Image *dst, Color color)
     // Security check to avoid program crash
     if ((dst->data == NULL) || (dst->width == 0) || (dst->height == 0)) return;
 
-    // Fill in first pixel based on image format
-    ImageDrawPixel(dst, 0, 0, color);
-
-    unsigned char *pSrcPixel = (unsigned char *)dst->data;
-    int bytesPerPixel = GetPixelDataSize(1, 1, dst->format);
-
-    // Repeat the first pixel data throughout the image
-    for (int i = 1; i < dst->width*dst->height; i++)
-    {
-        memcpy(pSrcPixel + i*bytesPerPixel, pSrcPixel, bytesPerPixel);
-    }
+    // Image rows are contiguous, fill them as one span
+    PixelPen pen = LoadPixelPen(dst->format, color, false);
+    if (pen.bytesPerPixel > 0) FillPixelSpan((unsigned char *)dst->data, pen.pixel, pen.bytesPerPixel, dst->width*dst->height);
 }
 
 // Draw pixel within an image
@@ -3346,149 +3347,43 @@ void ImageDrawPixel(Image *dst, int x, int y, Color color)
     // Security check to avoid program crash
     if ((dst->data == NULL) || (x < 0) || (x >= dst->width) || (y < 0) || (y >= dst->height)) return;
 
-    switch (dst->format)
-    {
-        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE:
-        {
-            // NOTE: Calculate grayscale equivalent color
-            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
-            unsigned char gray = (unsigned char)((coln.x*0.299f + coln.y*0.587f + coln.z*0.114f)*255.0f);
+    StorePixelColor((unsigned char *)dst->data + ((size_t)y*dst->width + x)*GetPixelDataSize(1, 1, dst->format), color, dst->format);
+}
 
-            ((unsigned char *)dst->data)[y*dst->width + x] = gray;
+// Draw pixel within an image (Vector version)
+void ImageDrawPixelV(Image *dst, Vector2 position, Color color)
+{
+    ImageDrawPixel(dst, (int)position.x, (int)position.y, color);
+}
 
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
-        {
-            // NOTE: Calculate grayscale equivalent color
-            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
-            unsigned char gray = (unsigned char)((coln.x*0.299f + coln.y*0.587f + coln.z*0.114f)*255.0f);
-
-            ((unsigned char *)dst->data)[(y*dst->width + x)*2] = gray;
-            ((unsigned char *)dst->data)[(y*dst->width + x)*2 + 1] = color.a;
-
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
-        {
-            // NOTE: Calculate R5G6B5 equivalent color
-            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
-
-            unsigned char r = (unsigned char)(round(coln.x*31.0f));
-            unsigned char g = (unsigned char)(round(coln.y*63.0f));
-            unsigned char b = (unsigned char)(round(coln.z*31.0f));
-
-            ((unsigned short *)dst->data)[y*dst->width + x] = (unsigned short)r << 11 | (unsigned short)g << 5 | (unsigned short)b;
-
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
-        {
-            // NOTE: Calculate R5G5B5A1 equivalent color
-            Vector4 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f };
-
-            unsigned char r = (unsigned char)(round(coln.x*31.0f));
-            unsigned char g = (unsigned char)(round(coln.y*31.0f));
-            unsigned char b = (unsigned char)(round(coln.z*31.0f));
-            unsigned char a = (coln.w > ((float)PIXELFORMAT_UNCOMPRESSED_R5G5B5A1_ALPHA_THRESHOLD/255.0f))? 1 : 0;
-
-            ((unsigned short *)dst->data)[y*dst->width + x] = (unsigned short)r << 11 | (unsigned short)g << 6 | (unsigned short)b << 1 | (unsigned short)a;
-
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
-        {
-            // NOTE: Calculate R5G5B5A1 equivalent color
-            Vector4 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f };
-
-            unsigned char r = (unsigned char)(round(coln.x*15.0f));
-            unsigned char g = (unsigned char)(round(coln.y*15.0f));
-            unsigned char b = (unsigned char)(round(coln.z*15.0f));
-            unsigned char a = (unsigned char)(round(coln.w*15.0f));
-
-            ((unsigned short *)dst->data)[y*dst->width + x] = (unsigned short)r << 12 | (unsigned short)g << 8 | (unsigned short)b << 4 | (unsigned short)a;
-
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
-        {
-            ((unsigned char *)dst->data)[(y*dst->width + x)*3] = color.r;
-            ((unsigned char *)dst->data)[(y*dst->width + x)*3 + 1] = color.g;
-            ((unsigned char *)dst->data)[(y*dst->width + x)*3 + 2] = color.b;
-
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8:
-        {
-            ((unsigned char *)dst->data)[(y*dst->width + x)*4] = color.r;
-            ((unsigned char *)dst->data)[(y*dst->width + x)*4 + 1] = color.g;
-            ((unsigned char *)dst->data)[(y*dst->width + x)*4 + 2] = color.b;
-            ((unsigned char *)dst->data)[(y*dst->width + x)*4 + 3] = color.a;
-
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_R32:
-        {
-            // NOTE: Calculate grayscale equivalent color (normalized to 32bit)
-            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
-
-            ((float *)dst->data)[y*dst->width + x] = coln.x*0.299f + coln.y*0.587f + coln.z*0.114f;
-
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_R32G32B32:
-        {
-            // NOTE: Calculate R32G32B32 equivalent color (normalized to 32bit)
-            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
-
-            ((float *)dst->data)[(y*dst->width + x)*3] = coln.x;
-            ((float *)dst->data)[(y*dst->width + x)*3 + 1] = coln.y;
-            ((float *)dst->data)[(y*dst->width + x)*3 + 2] = coln.z;
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_R32G32B32A32:
-        {
-            // NOTE: Calculate R32G32B32A32 equivalent color (normalized to 32bit)
-            Vector4 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f };
-
-            ((float *)dst->data)[(y*dst->width + x)*4] = coln.x;
-            ((float *)dst->data)[(y*dst->width + x)*4 + 1] = coln.y;
-            ((float *)dst->data)[(y*dst->width + x)*4 + 2] = coln.z;
-            ((float *)dst->data)[(y*dst->width + x)*4 + 3] = coln.w;
-
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_R16:
-        {
-            // NOTE: Calculate grayscale equivalent color (normalized to 32bit)
-            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
-
-            ((unsigned short*)dst->data)[y*dst->width + x] = FloatToHalf(coln.x*0.299f + coln.y*0.587f + coln.z*0.114f);
-
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_R16G16B16:
-        {
-            // NOTE: Calculate R32G32B32 equivalent color (normalized to 32bit)
-            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
-
-            ((unsigned short *)dst->data)[(y*dst->width + x)*3] = FloatToHalf(coln.x);
-            ((unsigned short *)dst->data)[(y*dst->width + x)*3 + 1] = FloatToHalf(coln.y);
-            ((unsigned short *)dst->data)[(y*dst->width + x)*3 + 2] = FloatToHalf(coln.z);
-        } break;
-        case PIXELFORMAT_UNCOMPRESSED_R16G16B16A16:
-        {
-            // NOTE: Calculate R32G32B32A32 equivalent color (normalized to 32bit)
-            Vector4 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f };
-
-            ((unsigned short *)dst->data)[(y*dst->width + x)*4] = FloatToHalf(coln.x);
-            ((unsigned short *)dst->data)[(y*dst->width + x)*4 + 1] = FloatToHalf(coln.y);
-            ((unsigned short *)dst->data)[(y*dst->width + x)*4 + 2] = FloatToHalf(coln.z);
-            ((unsigned short *)dst->data)[(y*dst->width + x)*4 + 3] = FloatToHalf(coln.w);
+// Draw horizontal span of pixels within an image
+// NOTE: Only the span pixels are written, several threads can draw on one image as long as their spans do not overlap
+void ImageDrawSpan(Image *dst, int posX, int posY, int width, Color color)
+{
+    // Security check to avoid program crash
+    if ((dst->data == NULL) || (dst->width == 0) || (dst->height == 0)) return;
 
-        } break;
-        default: break;
-    }
+    PixelPen pen = LoadPixelPen(dst->format, color, false);
+    DrawPenSpan(dst, &pen, posX, posY, width);
 }
 
-// Draw pixel within an image (Vector version)
-void ImageDrawPixelV(Image *dst, Vector2 position, Color color)
+// Draw horizontal span of pixels alpha-blended within an image
+// NOTE: Pixels are blended as ColorAlphaBlend() does, only the span pixels are read and written
+void ImageDrawSpanBlend(Image *dst, int posX, int posY, int width, Color color)
 {
-    ImageDrawPixel(dst, (int)position.x, (int)position.y, color);
+    // Security check to avoid program crash
+    if ((dst->data == NULL) || (dst->width == 0) || (dst->height == 0)) return;
+
+    PixelPen pen = LoadPixelPen(dst->format, color, true);
+    DrawPenSpan(dst, &pen, posX, posY, width);
 }
 
 // Draw line within an image
 void ImageDrawLine(Image *dst, int startPosX, int startPosY, int endPosX, int endPosY, Color color)
 {
+    // Security check to avoid program crash
+    if ((dst->data == NULL) || (dst->width == 0) || (dst->height == 0)) return;
+
     // Calculate differences in coordinates
     int shortLen = endPosY - startPosY;
     int longLen = endPosX - startPosX;
@@ -3518,6 +3413,9 @@ void ImageDrawLine(Image *dst, int startPosX, int startPosY, int endPosX, int en
     // Calculate fixed-point increment for shorter length
     int decInc = (longLen == 0)? 0 : (shortLen << 16)/longLen;
 
+    // Convert color to the image format once for all the line pixels
+    PixelPen pen = LoadPixelPen(dst->format, color, false);
+
     // Draw the line pixel by pixel
     if (yLonger)
     {
@@ -3525,16 +3423,32 @@ void ImageDrawLine(Image *dst, int startPosX, int startPosY, int endPosX, int en
         for (int i = 0, j = 0; i != endVal; i += sgnInc, j += decInc)
         {
             // Calculate pixel position and draw it
-            ImageDrawPixel(dst, startPosX + (j >> 16), startPosY + i, color);
+            DrawPenSpan(dst, &pen, startPosX + (j >> 16), startPosY + i, 1);
         }
     }
     else
     {
-        // If line is more horizontal, iterate over x-axis
+        // If line is more horizontal, iterate over x-axis,
+        // drawing pixels on the same row together
+        int runStart = 0;
+        int runY = startPosY;
+
         for (int i = 0, j = 0; i != endVal; i += sgnInc, j += decInc)
         {
-            // Calculate pixel position and draw it
-            ImageDrawPixel(dst, startPosX + i, startPosY + (j >> 16), color);
+            if (startPosY + (j >> 16) != runY)
+            {
+                int first = (sgnInc > 0)? runStart : i + 1;
+                DrawPenSpan(dst, &pen, startPosX + first, runY, abs(i - runStart));
+
+                runStart = i;
+                runY = startPosY + (j >> 16);
+            }
+        }
+
+        if (endVal != 0)
+        {
+            int first = (sgnInc > 0)? runStart : endVal + 1;
+            DrawPenSpan(dst, &pen, startPosX + first, runY, abs(endVal - runStart));
         }
     }
 }
@@ -3600,16 +3514,21 @@ void ImageDrawLineEx(Image *dst, Vector2 start, Vector2 end, int thick, Color co
 // Draw circle within an image
 void ImageDrawCircle(Image* dst, int centerX, int centerY, int radius, Color color)
 {
+    // Security check to avoid program crash
+    if ((dst->data == NULL) || (dst->width == 0) || (dst->height == 0)) return;
+
+    PixelPen pen = LoadPixelPen(dst->format, color, false);
     int x = 0;
     int y = radius;
     int decesionParameter = 3 - 2*radius;
 
     while (y >= x)
     {
-        ImageDrawRectangle(dst, centerX - x, centerY + y, x*2, 1, color);
-        ImageDrawRectangle(dst, centerX - x, centerY - y, x*2, 1, color);
-        ImageDrawRectangle(dst, centerX - y, centerY + x, y*2, 1, color);
-        ImageDrawRectangle(dst, centerX - y, centerY - x, y*2, 1, color);
+        // NOTE: Spans are at least one pixel wide, the first ones give the circle its top and bottom pixels
+        DrawPenSpan(dst, &pen, centerX - x, centerY + y, (x > 0)? x*2 : 1);
+        DrawPenSpan(dst, &pen, centerX - x, centerY - y, (x > 0)? x*2 : 1);
+        DrawPenSpan(dst, &pen, centerX - y, centerY + x, (y > 0)? y*2 : 1);
+        DrawPenSpan(dst, &pen, centerX - y, centerY - x, (y > 0)? y*2 : 1);
         x++;
 
         if (decesionParameter > 0)
@@ -3630,20 +3549,24 @@ void ImageDrawCircleV(Image* dst, Vector2 center, int radius, Color color)
 // Draw circle outline within an image
 void ImageDrawCircleLines(Image *dst, int centerX, int centerY, int radius, Color color)
 {
+    // Security check to avoid program crash
+    if ((dst->data == NULL) || (dst->width == 0) || (dst->height == 0)) return;
+
+    PixelPen pen = LoadPixelPen(dst->format, color, false);
     int x = 0;
     int y = radius;
     int decesionParameter = 3 - 2*radius;
 
     while (y >= x)
     {
-        ImageDrawPixel(dst, centerX + x, centerY + y, color);
-        ImageDrawPixel(dst, centerX - x, centerY + y, color);
-        ImageDrawPixel(dst, centerX + x, centerY - y, color);
-        ImageDrawPixel(dst, centerX - x, centerY - y, color);
-        ImageDrawPixel(dst, centerX + y, centerY + x, color);
-        ImageDrawPixel(dst, centerX - y, centerY + x, color);
-        ImageDrawPixel(dst, centerX + y, centerY - x, color);
-        ImageDrawPixel(dst, centerX - y, centerY - x, color);
+        DrawPenSpan(dst, &pen, centerX + x, centerY + y, 1);
+        DrawPenSpan(dst, &pen, centerX - x, centerY + y, 1);
+        DrawPenSpan(dst, &pen, centerX + x, centerY - y, 1);
+        DrawPenSpan(dst, &pen, centerX - x, centerY - y, 1);
+        DrawPenSpan(dst, &pen, centerX + y, centerY + x, 1);
+        DrawPenSpan(dst, &pen, centerX - y, centerY + x, 1);
+        DrawPenSpan(dst, &pen, centerX + y, centerY - x, 1);
+        DrawPenSpan(dst, &pen, centerX - y, centerY - x, 1);
         x++;
 
         if (decesionParameter > 0)
@@ -3696,26 +3619,12 @@ void ImageDrawRectangleRec(Image *dst, Rectangle rec, Color color)
     int sy = (int)rec.y;
     int sx = (int)rec.x;
 
-    int bytesPerPixel = GetPixelDataSize(1, 1, dst->format);
-
-    // Fill in the first pixel of the first row based on image format
-    ImageDrawPixel(dst, sx, sy, color);
-
-    int bytesOffset = ((sy*dst->width) + sx)*bytesPerPixel;
-    unsigned char *pSrcPixel = (unsigned char *)dst->data + bytesOffset;
-
-    // Repeat the first pixel data throughout the row
-    for (int x = 1; x < (int)rec.width; x++)
-    {
-        memcpy(pSrcPixel + x*bytesPerPixel, pSrcPixel, bytesPerPixel);
-    }
+    // Convert color to the image format once, then fill every row with it
+    // NOTE: Rows are filled from the converted color instead of copied from the first one,
+    // so only the rectangle pixels are touched and other threads may draw next to it
+    PixelPen pen = LoadPixelPen(dst->format, color, false);
 
-    // Repeat the first row data for all other rows
-    int bytesPerRow = bytesPerPixel*(int)rec.width;
-    for (int y = 1; y < (int)rec.height; y++)
-    {
-        memcpy(pSrcPixel + (y*dst->width)*bytesPerPixel, pSrcPixel, bytesPerRow);
-    }
+    for (int y = 0; y < (int)rec.height; y++) DrawPenSpan(dst, &pen, sx, sy + y, (int)rec.width);
 }
 
 // Draw rectangle lines within an image
@@ -3767,26 +3676,36 @@ void ImageDrawTriangle(Image *dst, Vector2 v1, Vector2 v2, Vector2 v3, Color col
     int w2Row = (int)((xMin - v3.x)*w2XStep + w2YStep*(yMin - v3.y));
     int w3Row = (int)((xMin - v1.x)*w3XStep + w3YStep*(yMin - v1.y));
 
+    // Security check to avoid program crash
+    if ((dst->data == NULL) || (dst->width == 0) || (dst->height == 0)) return;
+
+    PixelPen pen = LoadPixelPen(dst->format, color, false);
+    int rowSteps[3] = { w1XStep, w2XStep, w3XStep };
+
     // Rasterization loop
-    // Iterate through each pixel in the bounding box
+    // Every row of the bounding box is inside the triangle along one span,
+    // where the three barycentric coordinates (linear in x) are not negative
     for (int y = yMin; y <= yMax; y++)
     {
-        int w1 = w1Row;
-        int w2 = w2Row;
-        int w3 = w3Row;
+        int rowStart[3] = { w1Row, w2Row, w3Row };
+        int first = 0;
+        int last = xMax - xMin;
 
-        for (int x = xMin; x <= xMax; x++)
+        for (int i = 0; i < 3; i++)
         {
-            // Check if the pixel is inside the triangle using barycentric coordinates
-            // If it is then we can draw the pixel with the given color
-            if ((w1 | w2 | w3) >= 0) ImageDrawPixel(dst, x, y, color);
+            int w = rowStart[i];
+            int step = rowSteps[i];
 
-            // Increment the barycentric coordinates for the next pixel
-            w1 += w1XStep;
-            w2 += w2XStep;
-            w3 += w3XStep;
+            if (step > 0)
+            {
+                if ((w < 0) && ((-w + step - 1)/step > first)) first = (-w + step - 1)/step;
+            }
+            else if (w < 0) last = -1;
+            else if ((step < 0) && (w/-step < last)) last = w/-step;
         }
 
+        if (first <= last) DrawPenSpan(dst, &pen, xMin + first, y, last - first + 1);
+
         // Move to the next row in the bounding box
         w1Row += w1YStep;
         w2Row += w2YStep;
@@ -5568,4 +5487,1454 @@ static Vector4 *LoadImageDataNormalized(Image image)
     return pixels;
 }
 
+//----------------------------------------------------------------------------------
+// Direct pixel format conversion
+//----------------------------------------------------------------------------------
+// Pairs of the 8 bit and packed 16 bit formats (GRAYSCALE to R8G8B8A8) convert without the normalized
+// float copy of the whole image: a source channel has at most 256 codes, so the float path is evaluated
+// once per code into tables and every pixel only looks them up, giving the same results.
+// Common pairs from 8 bit sources run SIMD loops first, with integer math that matches the float path
+#define PIXEL_CONVERT_CHUNK     256     // Pixels unpacked to channel codes at a time
+
+// Check if pixel format is one of the 8 bit or packed 16 bit formats
+static bool IsDirectPixelFormat(int format)
+{
+    return ((format >= PIXELFORMAT_UNCOMPRESSED_GRAYSCALE) && (format <= PIXELFORMAT_UNCOMPRESSED_R8G8B8A8));
+}
+
+// Get highest code of a channel (r, g, b, a) in pixel format, 0 if the format has no such channel
+static int GetChannelCodeMax(int format, int channel)
+{
+    int codeMax = 0;
+
+    switch (format)
+    {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE:
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8: codeMax = (channel == 3)? 0 : 255; break;
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8: codeMax = 255; break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5: codeMax = (channel == 3)? 0 : ((channel == 1)? 63 : 31); break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1: codeMax = (channel == 3)? 1 : 31; break;
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4: codeMax = 15; break;
+        default: break;
+    }
+
+    return codeMax;
+}
+
+// Get normalized value of a channel code, as LoadImageDataNormalized() computes it
+static float ChannelCodeToFloat(int format, int channel, int code)
+{
+    float value = 0.0f;
+
+    switch (format)
+    {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE:
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8: value = (channel == 3)? 1.0f : (float)code/255.0f; break;
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8: value = (float)code/255.0f; break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5: value = (channel == 3)? 1.0f : (float)code*((channel == 1)? (1.0f/63) : (1.0f/31)); break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1: value = (channel == 3)? ((code == 0)? 0.0f : 1.0f) : (float)code*(1.0f/31); break;
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4: value = (float)code*(1.0f/15); break;
+        default: break;
+    }
+
+    return value;
+}
+
+// Get channel code for a normalized value, as the float path of ImageFormat() computes it
+static unsigned char FloatToChannelCode(int format, int channel, float value)
+{
+    unsigned char code = 0;
+
+    switch (format)
+    {
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5: code = (unsigned char)(round(value*((channel == 1)? 63.0f : 31.0f))); break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+        {
+            if (channel == 3) code = (value > ((float)PIXELFORMAT_UNCOMPRESSED_R5G5B5A1_ALPHA_THRESHOLD/255.0f))? 1 : 0;
+            else code = (unsigned char)(round(value*31.0f));
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4: code = (unsigned char)(round(value*15.0f)); break;
+        default: code = (unsigned char)(value*255.0f); break;
+    }
+
+    return code;
+}
+
+// Unpack pixels into channel codes, one plane per channel (r, g, b, a)
+// NOTE: Channels missing in format get code 0
+static void UnpackChannelCodes(const unsigned char *src, int format, int count, unsigned char codes[4][PIXEL_CONVERT_CHUNK])
+{
+    const unsigned short *src16 = (const unsigned short *)src;
+
+    switch (format)
+    {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                codes[0][i] = codes[1][i] = codes[2][i] = src[i];
+                codes[3][i] = 0;
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                codes[0][i] = codes[1][i] = codes[2][i] = src[i*2];
+                codes[3][i] = src[i*2 + 1];
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                codes[0][i] = (unsigned char)(src16[i] >> 11);
+                codes[1][i] = (unsigned char)((src16[i] >> 5) & 0x3f);
+                codes[2][i] = (unsigned char)(src16[i] & 0x1f);
+                codes[3][i] = 0;
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                codes[0][i] = src[i*3];
+                codes[1][i] = src[i*3 + 1];
+                codes[2][i] = src[i*3 + 2];
+                codes[3][i] = 0;
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                codes[0][i] = (unsigned char)(src16[i] >> 11);
+                codes[1][i] = (unsigned char)((src16[i] >> 6) & 0x1f);
+                codes[2][i] = (unsigned char)((src16[i] >> 1) & 0x1f);
+                codes[3][i] = (unsigned char)(src16[i] & 0x1);
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                codes[0][i] = (unsigned char)(src16[i] >> 12);
+                codes[1][i] = (unsigned char)((src16[i] >> 8) & 0xf);
+                codes[2][i] = (unsigned char)((src16[i] >> 4) & 0xf);
+                codes[3][i] = (unsigned char)(src16[i] & 0xf);
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                codes[0][i] = src[i*4];
+                codes[1][i] = src[i*4 + 1];
+                codes[2][i] = src[i*4 + 2];
+                codes[3][i] = src[i*4 + 3];
+            }
+        } break;
+        default: break;
+    }
+}
+
+// Pack channel codes into pixels, mapping each code through the tables
+static void PackChannelCodes(unsigned char *dst, int format, int count, unsigned char codes[4][PIXEL_CONVERT_CHUNK],
+                             unsigned char codeTable[4][256], float grayTable[3][256])
+{
+    unsigned short *dst16 = (unsigned short *)dst;
+
+    switch (format)
+    {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                dst[i] = (unsigned char)((grayTable[0][codes[0][i]] + grayTable[1][codes[1][i]] + grayTable[2][codes[2][i]])*255.0f);
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                dst[i*2] = (unsigned char)((grayTable[0][codes[0][i]] + grayTable[1][codes[1][i]] + grayTable[2][codes[2][i]])*255.0f);
+                dst[i*2 + 1] = codeTable[3][codes[3][i]];
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                dst16[i] = (unsigned short)(codeTable[0][codes[0][i]] << 11 | codeTable[1][codes[1][i]] << 5 | codeTable[2][codes[2][i]]);
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                dst[i*3] = codeTable[0][codes[0][i]];
+                dst[i*3 + 1] = codeTable[1][codes[1][i]];
+                dst[i*3 + 2] = codeTable[2][codes[2][i]];
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                dst16[i] = (unsigned short)(codeTable[0][codes[0][i]] << 11 | codeTable[1][codes[1][i]] << 6 | codeTable[2][codes[2][i]] << 1 | codeTable[3][codes[3][i]]);
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                dst16[i] = (unsigned short)(codeTable[0][codes[0][i]] << 12 | codeTable[1][codes[1][i]] << 8 | codeTable[2][codes[2][i]] << 4 | codeTable[3][codes[3][i]]);
+            }
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8:
+        {
+            for (int i = 0; i < count; i++)
+            {
+                dst[i*4] = codeTable[0][codes[0][i]];
+                dst[i*4 + 1] = codeTable[1][codes[1][i]];
+                dst[i*4 + 2] = codeTable[2][codes[2][i]];
+                dst[i*4 + 3] = codeTable[3][codes[3][i]];
+            }
+        } break;
+        default: break;
+    }
+}
+
+#if defined(RTEXTURES_SSE2)
+#if !defined(RTEXTURES_AVX2)
+// Get gray level of 4 RGBA pixels in 32 bit lanes, same float math as ImageFormat()
+static __m128i GrayFromRGBA8x4(__m128i pixels)
+{
+    const __m128i mask = _mm_set1_epi32(0xff);
+    const __m128 scale = _mm_set1_ps(255.0f);
+
+    __m128 r = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(pixels, mask)), scale);
+    __m128 g = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 8), mask)), scale);
+    __m128 b = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(pixels, 16), mask)), scale);
+    __m128 sum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r, _mm_set1_ps(0.299f)), _mm_mul_ps(g, _mm_set1_ps(0.587f))), _mm_mul_ps(b, _mm_set1_ps(0.114f)));
+
+    return _mm_cvttps_epi32(_mm_mul_ps(sum, scale));
+}
+#endif
+
+// Get gray level of 8 RGBA pixels in 16 bit lanes
+static __m128i GrayFromRGBA8x8(const unsigned char *src)
+{
+#if defined(RTEXTURES_AVX2)
+    const __m256i mask = _mm256_set1_epi32(0xff);
+    const __m256 scale = _mm256_set1_ps(255.0f);
+    __m256i pixels = _mm256_loadu_si256((const __m256i *)src);
+
+    __m256 r = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(pixels, mask)), scale);
+    __m256 g = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), mask)), scale);
+    __m256 b = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 16), mask)), scale);
+    __m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(r, _mm256_set1_ps(0.299f)), _mm256_mul_ps(g, _mm256_set1_ps(0.587f))), _mm256_mul_ps(b, _mm256_set1_ps(0.114f)));
+    __m256i gray = _mm256_cvttps_epi32(_mm256_mul_ps(sum, scale));
+
+    return _mm_packs_epi32(_mm256_castsi256_si128(gray), _mm256_extracti128_si256(gray, 1));
+#else
+    return _mm_packs_epi32(GrayFromRGBA8x4(_mm_loadu_si128((const __m128i *)src)), GrayFromRGBA8x4(_mm_loadu_si128((const __m128i *)(src + 16))));
+#endif
+}
+
+// Quantize 8 bit values in 32 bit lanes to 0..levels, same results as round(value/255.0f*levels)
+static __m128i QuantizeChannel(__m128i value, int levels)
+{
+    __m128i t = _mm_add_epi32(_mm_mullo_epi16(value, _mm_set1_epi32(levels)), _mm_set1_epi32(128));
+
+    return _mm_srli_epi32(_mm_add_epi32(t, _mm_srli_epi32(t, 8)), 8);
+}
+
+// Pack 4 RGBA pixels to a 16 bit format, sign extended in 32 bit lanes for _mm_packs_epi32()
+static __m128i PackRGBA8x4(__m128i pixels, int format)
+{
+    const __m128i mask = _mm_set1_epi32(0xff);
+    __m128i r = _mm_and_si128(pixels, mask);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 8), mask);
+    __m128i b = _mm_and_si128(_mm_srli_epi32(pixels, 16), mask);
+    __m128i a = _mm_srli_epi32(pixels, 24);
+    __m128i packed = _mm_setzero_si128();
+
+    switch (format)
+    {
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
+        {
+            packed = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(QuantizeChannel(r, 31), 11), _mm_slli_epi32(QuantizeChannel(g, 63), 5)), QuantizeChannel(b, 31));
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+        {
+            __m128i alpha = _mm_and_si128(_mm_cmpgt_epi32(a, _mm_set1_epi32(PIXELFORMAT_UNCOMPRESSED_R5G5B5A1_ALPHA_THRESHOLD)), _mm_set1_epi32(1));
+            packed = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(QuantizeChannel(r, 31), 11), _mm_slli_epi32(QuantizeChannel(g, 31), 6)),
+                                  _mm_or_si128(_mm_slli_epi32(QuantizeChannel(b, 31), 1), alpha));
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
+        {
+            packed = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(QuantizeChannel(r, 15), 12), _mm_slli_epi32(QuantizeChannel(g, 15), 8)),
+                                  _mm_or_si128(_mm_slli_epi32(QuantizeChannel(b, 15), 4), QuantizeChannel(a, 15)));
+        } break;
+        default: break;
+    }
+
+    return _mm_srai_epi32(_mm_slli_epi32(packed, 16), 16);
+}
+#endif
+
+// Convert the bulk of the pixels of common format pairs with SIMD (byte copies for RGB without SSSE3),
+// returns pixels converted
+static int ConvertPixelsFast(const unsigned char *src, unsigned char *dst, int count, int format, int newFormat)
+{
+    int i = 0;
+#if defined(RTEXTURES_SSE2)
+    const __m128i alpha = _mm_set1_epi32((int)0xff000000);
+#endif
+
+    if (format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+    {
+        switch (newFormat)
+        {
+        #if defined(RTEXTURES_SSE2)
+            case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE:
+            {
+                for (; i + 16 <= count; i += 16)
+                {
+                    _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(GrayFromRGBA8x8(src + i*4), GrayFromRGBA8x8(src + i*4 + 32)));
+                }
+            } break;
+            case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+            {
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m128i a0 = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(src + i*4)), 24);
+                    __m128i a1 = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(src + i*4 + 16)), 24);
+                    _mm_storeu_si128((__m128i *)(dst + i*2), _mm_or_si128(GrayFromRGBA8x8(src + i*4), _mm_slli_epi16(_mm_packs_epi32(a0, a1), 8)));
+                }
+            } break;
+            case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
+            case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+            case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
+            {
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m128i p0 = PackRGBA8x4(_mm_loadu_si128((const __m128i *)(src + i*4)), newFormat);
+                    __m128i p1 = PackRGBA8x4(_mm_loadu_si128((const __m128i *)(src + i*4 + 16)), newFormat);
+                    _mm_storeu_si128((__m128i *)(dst + i*2), _mm_packs_epi32(p0, p1));
+                }
+            } break;
+        #endif
+        #if defined(RTEXTURES_SSSE3)
+            case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
+            {
+                // Each store writes 4 bytes past its pixels, the next store overwrites them
+                const __m128i shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+                for (; i + 6 <= count; i += 4)
+                {
+                    _mm_storeu_si128((__m128i *)(dst + i*3), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(src + i*4)), shuffle));
+                }
+            } break;
+        #else
+            case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
+            {
+                for (; i < count; i++)
+                {
+                    dst[i*3] = src[i*4];
+                    dst[i*3 + 1] = src[i*4 + 1];
+                    dst[i*3 + 2] = src[i*4 + 2];
+                }
+            } break;
+        #endif
+            default: break;
+        }
+    }
+    else if (newFormat == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+    {
+        switch (format)
+        {
+        #if defined(RTEXTURES_SSE2)
+            case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE:
+            {
+                for (; i + 16 <= count; i += 16)
+                {
+                    __m128i gray = _mm_loadu_si128((const __m128i *)(src + i));
+                    __m128i gray2Low = _mm_unpacklo_epi8(gray, gray);
+                    __m128i gray2High = _mm_unpackhi_epi8(gray, gray);
+                    _mm_storeu_si128((__m128i *)(dst + i*4), _mm_or_si128(_mm_unpacklo_epi16(gray2Low, gray2Low), alpha));
+                    _mm_storeu_si128((__m128i *)(dst + i*4 + 16), _mm_or_si128(_mm_unpackhi_epi16(gray2Low, gray2Low), alpha));
+                    _mm_storeu_si128((__m128i *)(dst + i*4 + 32), _mm_or_si128(_mm_unpacklo_epi16(gray2High, gray2High), alpha));
+                    _mm_storeu_si128((__m128i *)(dst + i*4 + 48), _mm_or_si128(_mm_unpackhi_epi16(gray2High, gray2High), alpha));
+                }
+            } break;
+            case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+            {
+                const __m128i mask = _mm_set1_epi32(0xff);
+
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m128i pixels = _mm_loadu_si128((const __m128i *)(src + i*2));
+                    __m128i low = _mm_unpacklo_epi16(pixels, _mm_setzero_si128());
+                    __m128i high = _mm_unpackhi_epi16(pixels, _mm_setzero_si128());
+                    __m128i grayLow = _mm_and_si128(low, mask);
+                    __m128i grayHigh = _mm_and_si128(high, mask);
+
+                    // Gray in the low two bytes, then (gray | alpha << 8) shifted into the high two
+                    _mm_storeu_si128((__m128i *)(dst + i*4), _mm_or_si128(_mm_or_si128(grayLow, _mm_slli_epi32(grayLow, 8)), _mm_slli_epi32(low, 16)));
+                    _mm_storeu_si128((__m128i *)(dst + i*4 + 16), _mm_or_si128(_mm_or_si128(grayHigh, _mm_slli_epi32(grayHigh, 8)), _mm_slli_epi32(high, 16)));
+                }
+            } break;
+        #endif
+        #if defined(RTEXTURES_SSSE3)
+            case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
+            {
+                // Each load reads 4 bytes past its pixels, so the last ones are left to the table path
+                const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+
+                for (; i + 6 <= count; i += 4)
+                {
+                    _mm_storeu_si128((__m128i *)(dst + i*4), _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(src + i*3)), shuffle), alpha));
+                }
+            } break;
+        #else
+            case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
+            {
+                for (; i < count; i++)
+                {
+                    dst[i*4] = src[i*3];
+                    dst[i*4 + 1] = src[i*3 + 1];
+                    dst[i*4 + 2] = src[i*3 + 2];
+                    dst[i*4 + 3] = 255;
+                }
+            } break;
+        #endif
+            default: break;
+        }
+    }
+
+    return i;
+}
+
+// Convert pixels between the 8 bit and packed 16 bit formats into a new buffer
+// NOTE: Returns NULL if any of the formats is not one of those, callers then use the float path
+static void *ConvertPixelsDirect(const void *data, int count, int format, int newFormat)
+{
+    if (!IsDirectPixelFormat(format) || !IsDirectPixelFormat(newFormat)) return NULL;
+
+    const unsigned char *src = (const unsigned char *)data;
+    int srcPixelSize = GetPixelDataSize(1, 1, format);
+    int dstPixelSize = GetPixelDataSize(1, 1, newFormat);
+    unsigned char *dst = (unsigned char *)RL_MALLOC(count*dstPixelSize);
+    if (dst == NULL) return NULL;
+
+    int converted = ConvertPixelsFast(src, dst, count, format, newFormat);
+
+    if (converted < count)
+    {
+        // Destination code and weighted gray term of every source code, per channel
+        static const float grayWeights[3] = { 0.299f, 0.587f, 0.114f };
+        unsigned char codeTable[4][256] = { 0 };
+        float grayTable[3][256] = { 0 };
+        unsigned char codes[4][PIXEL_CONVERT_CHUNK];
+
+        for (int channel = 0; channel < 4; channel++)
+        {
+            for (int code = 0; code <= GetChannelCodeMax(format, channel); code++)
+            {
+                float value = ChannelCodeToFloat(format, channel, code);
+
+                codeTable[channel][code] = FloatToChannelCode(newFormat, channel, value);
+                if (channel < 3) grayTable[channel][code] = value*grayWeights[channel];
+            }
+        }
+
+        for (int i = converted; i < count; i += PIXEL_CONVERT_CHUNK)
+        {
+            int chunk = ((count - i) < PIXEL_CONVERT_CHUNK)? (count - i) : PIXEL_CONVERT_CHUNK;
+
+            UnpackChannelCodes(src + i*srcPixelSize, format, chunk, codes);
+            PackChannelCodes(dst + i*dstPixelSize, newFormat, chunk, codes, codeTable, grayTable);
+        }
+    }
+
+    return dst;
+}
+
+// Image worker threads
+// NOTE: Jobs are split in chunks of items taken by the workers and by the calling thread,
+// a job started while another one runs (from another thread or from inside a task) runs
+// on its calling thread alone
+#if defined(RTEXTURES_THREADS)
+static void LockImagePool(void)
+{
+#if defined(_WIN32)
+    AcquireSRWLockExclusive(&imagePoolLock);
+#else
+    pthread_mutex_lock(&imagePoolLock);
+#endif
+}
+
+static void UnlockImagePool(void)
+{
+#if defined(_WIN32)
+    ReleaseSRWLockExclusive(&imagePoolLock);
+#else
+    pthread_mutex_unlock(&imagePoolLock);
+#endif
+}
+
+#if defined(_WIN32)
+static void WaitImagePool(ImagePoolSync *condition)
+{
+    SleepConditionVariableSRW(condition, &imagePoolLock, 0xFFFFFFFF, 0);
+}
+
+static void SignalImagePool(ImagePoolSync *condition)
+{
+    WakeAllConditionVariable(condition);
+}
+#else
+static void WaitImagePool(pthread_cond_t *condition)
+{
+    pthread_cond_wait(condition, &imagePoolLock);
+}
+
+static void SignalImagePool(pthread_cond_t *condition)
+{
+    pthread_cond_broadcast(condition);
+}
+#endif
+
+// Take chunks of the current job until none is left
+static void RunImagePoolChunks(void)
+{
+    while (true)
+    {
+        LockImagePool();
+        int start = imagePool.next;
+        if (start < imagePool.count) imagePool.next += imagePool.chunk;
+        int end = (start + imagePool.chunk < imagePool.count)? start + imagePool.chunk : imagePool.count;
+        ImageTaskFunc func = imagePool.func;
+        void *data = imagePool.data;
+        UnlockImagePool();
+
+        if (start >= end) break;
+        func(data, start, end);
+    }
+}
+
+// Worker thread loop, runs every job started after its creation
+static void ImageWorkerLoop(void)
+{
+    unsigned int seenJob = 0;   // Workers are started before the first job
+
+    LockImagePool();
+    while (true)
+    {
+        while (imagePool.job == seenJob) WaitImagePool(&imagePoolWake);
+        seenJob = imagePool.job;
+        UnlockImagePool();
+
+        RunImagePoolChunks();
+
+        LockImagePool();
+        imagePool.working--;
+        if (imagePool.working == 0) SignalImagePool(&imagePoolDone);
+    }
+}
+
+#if defined(_WIN32)
+static unsigned int __stdcall ImageWorkerThread(void *arg)
+{
+    (void)arg;
+    ImageWorkerLoop();
+    return 0;
+}
+#else
+static void *ImageWorkerThread(void *arg)
+{
+    (void)arg;
+    ImageWorkerLoop();
+    return NULL;
+}
+#endif
+
+// Start one worker thread per processor core but the calling one
+// NOTE: Called with the pool locked, workers block on the lock until the first job is set
+static void StartImageWorkers(void)
+{
+#if defined(_WIN32)
+    int cores = (int)GetActiveProcessorCount(0xFFFF);   // ALL_PROCESSOR_GROUPS
+#else
+    int cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (cores > IMAGE_MAX_THREADS) cores = IMAGE_MAX_THREADS;
+
+    imagePool.threadCount = 1;
+    for (int i = 1; i < cores; i++)
+    {
+#if defined(_WIN32)
+        void *thread = (void *)_beginthreadex(NULL, 0, ImageWorkerThread, NULL, 0, NULL);
+        if (thread == NULL) break;
+        CloseHandle(thread);
+#else
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, ImageWorkerThread, NULL) != 0) break;
+        pthread_detach(thread);
+#endif
+        imagePool.threadCount++;
+    }
+
+    if (imagePool.threadCount > 1) TRACELOG(LOG_INFO, "IMAGE: Started %i worker threads", imagePool.threadCount - 1);
+}
+#endif  // RTEXTURES_THREADS
+
+// Get threads sharing image tasks, starts the worker threads
+static int GetImageThreadCount(void)
+{
+    int threadCount = 1;
+
+#if defined(RTEXTURES_THREADS)
+    LockImagePool();
+    if (imagePool.threadCount == 0) StartImageWorkers();
+    threadCount = imagePool.threadCount;
+    UnlockImagePool();
+#endif
+
+    return threadCount;
+}
+
+// Run func over items [0, count) on the worker threads, in chunks of minChunk items at least
+// NOTE: Returns when all the items are done, tasks must not depend on each other
+static void RunImageTasks(ImageTaskFunc func, void *data, int count, int minChunk)
+{
+    if (count <= 0) return;
+    if (minChunk < 1) minChunk = 1;
+
+#if defined(RTEXTURES_THREADS)
+    if (count >= 2*minChunk)
+    {
+        LockImagePool();
+        if (imagePool.threadCount == 0) StartImageWorkers();
+
+        if (!imagePool.busy && (imagePool.threadCount > 1))
+        {
+            // Some chunks per thread to balance uneven tasks
+            int chunk = (count + imagePool.threadCount*4 - 1)/(imagePool.threadCount*4);
+
+            imagePool.busy = true;
+            imagePool.func = func;
+            imagePool.data = data;
+            imagePool.count = count;
+            imagePool.chunk = (chunk > minChunk)? chunk : minChunk;
+            imagePool.next = 0;
+            imagePool.working = imagePool.threadCount - 1;
+            imagePool.job++;
+            SignalImagePool(&imagePoolWake);
+            UnlockImagePool();
+
+            RunImagePoolChunks();
+
+            LockImagePool();
+            while (imagePool.working > 0) WaitImagePool(&imagePoolDone);
+            imagePool.busy = false;
+            UnlockImagePool();
+            return;
+        }
+
+        UnlockImagePool();
+    }
+#endif
+
+    func(data, 0, count);
+}
+
+// Copy rows of a nearest-neighbor resize, see ImageResizeNN()
+static void ResizeNNRows(void *data, int start, int end)
+{
+    const ResizeNNTask *task = (const ResizeNNTask *)data;
+    const int *srcX = task->srcX;
+    int width = task->dstWidth;
+    int pixelSize = task->pixelSize;
+    size_t rowSize = (size_t)width*pixelSize;
+    int lastY = -1;
+
+    for (int y = start; y < end; y++)
+    {
+        int srcY = (y*task->yRatio) >> 16;
+        unsigned char *dstRow = task->dst + (size_t)y*rowSize;
+
+        // Scaling up repeats source rows
+        if (srcY == lastY)
+        {
+            memcpy(dstRow, dstRow - rowSize, rowSize);
+            continue;
+        }
+        lastY = srcY;
+
+        const unsigned char *srcRow = task->src + (size_t)srcY*task->srcWidth*pixelSize;
+
+        switch (pixelSize)
+        {
+            case 1:
+            {
+                for (int x = 0; x < width; x++) dstRow[x] = srcRow[srcX[x]];
+            } break;
+            case 2:
+            {
+                const unsigned short *src = (const unsigned short *)srcRow;
+                unsigned short *dst = (unsigned short *)dstRow;
+                for (int x = 0; x < width; x++) dst[x] = src[srcX[x]];
+            } break;
+            case 4:
+            {
+                const unsigned int *src = (const unsigned int *)srcRow;
+                unsigned int *dst = (unsigned int *)dstRow;
+                int x = 0;
+            #if defined(RTEXTURES_AVX2)
+                for (; x + 8 <= width; x += 8)
+                {
+                    __m256i index = _mm256_loadu_si256((const __m256i *)(srcX + x));
+                    _mm256_storeu_si256((__m256i *)(dst + x), _mm256_i32gather_epi32((const int *)src, index, 4));
+                }
+            #endif
+                for (; x < width; x++) dst[x] = src[srcX[x]];
+            } break;
+            default:
+            {
+                for (int x = 0; x < width; x++) memcpy(dstRow + x*pixelSize, srcRow + (size_t)srcX[x]*pixelSize, pixelSize);
+            } break;
+        }
+    }
+}
+
+// Run splits of a stb_image_resize2 resize, see ResizePixels8()
+static void ResizeSplits(void *data, int start, int end)
+{
+    stbir_resize_extended_split((STBIR_RESIZE *)data, start, end - start);
+}
+
+// Resize 8 bit per channel pixels with 1 to 4 channels, split on the worker threads
+// NOTE: Splits give the same result as a single stbir_resize_uint8_linear() call
+static void ResizePixels8(const unsigned char *pixels, int width, int height, unsigned char *output, int newWidth, int newHeight, int channels)
+{
+    STBIR_RESIZE resize = { 0 };
+    stbir_resize_init(&resize, pixels, width, height, 0, output, newWidth, newHeight, 0, (stbir_pixel_layout)channels, STBIR_TYPE_UINT8);
+
+    int splits = (newWidth*newHeight >= 2*IMAGE_TASK_MIN_PIXELS)? GetImageThreadCount() : 1;
+
+    if (splits > 1)
+    {
+        splits = stbir_build_samplers_with_splits(&resize, splits);
+        RunImageTasks(ResizeSplits, &resize, splits, 1);
+        stbir_free_samplers(&resize);
+    }
+    else stbir_resize_extended(&resize);
+}
+
+// Box blur pass over count elements of BLUR_STRIP_PIXELS*4 channels, see ImageBlurGaussian()
+// NOTE: Channels are 7 bit fixed point, the window [i - radius, i + radius] is cut at the ends.
+// SIMD sums are 32 bit, unpacking low and high 16 bit halves and packing them back keeps channels order
+static void BoxBlurPass(const unsigned short *src, unsigned short *dst, int count, int radius)
+{
+    static const unsigned short none[BLUR_STRIP_LANES] = { 0 };
+    float interior = 1.0f/(float)(2*radius + 1);
+
+#if defined(RTEXTURES_AVX2)
+    __m256i zero = _mm256_setzero_si256();
+    __m256 half = _mm256_set1_ps(0.5f);
+    __m256i sums[BLUR_STRIP_LANES/8];
+
+    for (int b = 0; b < BLUR_STRIP_LANES/8; b++) sums[b] = zero;
+    for (int i = 0; i < radius; i++)
+    {
+        for (int b = 0; b < BLUR_STRIP_LANES/16; b++)
+        {
+            __m256i in = _mm256_loadu_si256((const __m256i *)(src + i*BLUR_STRIP_LANES + b*16));
+            sums[2*b] = _mm256_add_epi32(sums[2*b], _mm256_unpacklo_epi16(in, zero));
+            sums[2*b + 1] = _mm256_add_epi32(sums[2*b + 1], _mm256_unpackhi_epi16(in, zero));
+        }
+    }
+#elif defined(RTEXTURES_SSE2)
+    __m128i zero = _mm_setzero_si128();
+    __m128 half = _mm_set1_ps(0.5f);
+    __m128i sums[BLUR_STRIP_LANES/4];
+
+    for (int b = 0; b < BLUR_STRIP_LANES/4; b++) sums[b] = zero;
+    for (int i = 0; i < radius; i++)
+    {
+        for (int b = 0; b < BLUR_STRIP_LANES/8; b++)
+        {
+            __m128i in = _mm_loadu_si128((const __m128i *)(src + i*BLUR_STRIP_LANES + b*8));
+            sums[2*b] = _mm_add_epi32(sums[2*b], _mm_unpacklo_epi16(in, zero));
+            sums[2*b + 1] = _mm_add_epi32(sums[2*b + 1], _mm_unpackhi_epi16(in, zero));
+        }
+    }
+#else
+    unsigned int sums[BLUR_STRIP_LANES] = { 0 };
+
+    for (int i = 0; i < radius; i++)
+    {
+        for (int l = 0; l < BLUR_STRIP_LANES; l++) sums[l] += src[i*BLUR_STRIP_LANES + l];
+    }
+#endif
+
+    for (int i = 0; i < count; i++)
+    {
+        const unsigned short *leaving = (i - radius - 1 >= 0)? src + (i - radius - 1)*BLUR_STRIP_LANES : none;
+        const unsigned short *entering = (i + radius < count)? src + (i + radius)*BLUR_STRIP_LANES : none;
+        int first = (i - radius > 0)? i - radius : 0;
+        int last = (i + radius < count)? i + radius : count - 1;
+        float scale = (last - first == 2*radius)? interior : 1.0f/(float)(last - first + 1);
+        unsigned short *out = dst + i*BLUR_STRIP_LANES;
+
+#if defined(RTEXTURES_AVX2)
+        __m256 vscale = _mm256_set1_ps(scale);
+        for (int b = 0; b < BLUR_STRIP_LANES/16; b++)
+        {
+            __m256i in = _mm256_loadu_si256((const __m256i *)(entering + b*16));
+            __m256i gone = _mm256_loadu_si256((const __m256i *)(leaving + b*16));
+            sums[2*b] = _mm256_sub_epi32(_mm256_add_epi32(sums[2*b], _mm256_unpacklo_epi16(in, zero)), _mm256_unpacklo_epi16(gone, zero));
+            sums[2*b + 1] = _mm256_sub_epi32(_mm256_add_epi32(sums[2*b + 1], _mm256_unpackhi_epi16(in, zero)), _mm256_unpackhi_epi16(gone, zero));
+
+            __m256i low = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(sums[2*b]), vscale), half));
+            __m256i high = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(sums[2*b + 1]), vscale), half));
+            _mm256_storeu_si256((__m256i *)(out + b*16), _mm256_packs_epi32(low, high));
+        }
+#elif defined(RTEXTURES_SSE2)
+        __m128 vscale = _mm_set1_ps(scale);
+        for (int b = 0; b < BLUR_STRIP_LANES/8; b++)
+        {
+            __m128i in = _mm_loadu_si128((const __m128i *)(entering + b*8));
+            __m128i gone = _mm_loadu_si128((const __m128i *)(leaving + b*8));
+            sums[2*b] = _mm_sub_epi32(_mm_add_epi32(sums[2*b], _mm_unpacklo_epi16(in, zero)), _mm_unpacklo_epi16(gone, zero));
+            sums[2*b + 1] = _mm_sub_epi32(_mm_add_epi32(sums[2*b + 1], _mm_unpackhi_epi16(in, zero)), _mm_unpackhi_epi16(gone, zero));
+
+            __m128i low = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(sums[2*b]), vscale), half));
+            __m128i high = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(sums[2*b + 1]), vscale), half));
+            _mm_storeu_si128((__m128i *)(out + b*8), _mm_packs_epi32(low, high));
+        }
+#else
+        for (int l = 0; l < BLUR_STRIP_LANES; l++)
+        {
+            sums[l] += entering[l] - leaving[l];
+            out[l] = (unsigned short)((float)sums[l]*scale + 0.5f);
+        }
+#endif
+    }
+}
+
+// Load an RGBA8 pixel as 7 bit fixed point channels, optionally premultiplying alpha
+static void LoadBlurPixel(const unsigned char *pixel, unsigned short *fixed, bool premultiply)
+{
+#if defined(RTEXTURES_SSE2)
+    int packed = 0;
+    memcpy(&packed, pixel, 4);
+    __m128i channels = _mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), _mm_setzero_si128());
+    __m128i shifted = _mm_slli_epi16(channels, 7);
+
+    if (premultiply)
+    {
+        // c*a*128/255 as c*a*32896 >> 16, alpha lane kept shifted
+        __m128i alpha = _mm_shufflelo_epi16(channels, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i premultiplied = _mm_mulhi_epu16(_mm_mullo_epi16(channels, alpha), _mm_set1_epi16((short)32896));
+        __m128i alphaLane = _mm_set_epi16(0, 0, 0, 0, -1, 0, 0, 0);
+        shifted = _mm_or_si128(_mm_andnot_si128(alphaLane, premultiplied), _mm_and_si128(alphaLane, shifted));
+    }
+
+    _mm_storel_epi64((__m128i *)fixed, shifted);
+#else
+    unsigned int a = pixel[3];
+
+    for (int c = 0; c < 3; c++) fixed[c] = (unsigned short)(premultiply? (pixel[c]*a*32896) >> 16 : (unsigned int)pixel[c] << 7);
+    fixed[3] = (unsigned short)(a << 7);
+#endif
+}
+
+// Store 7 bit fixed point channels as an RGBA8 pixel, optionally reversing alpha premultiply
+static void StoreBlurPixel(const unsigned short *fixed, unsigned char *pixel, bool unpremultiply)
+{
+    unsigned int a = (fixed[3] + 64) >> 7;
+
+    if (unpremultiply && (a == 0))
+    {
+        memset(pixel, 0, 4);
+        return;
+    }
+
+#if defined(RTEXTURES_SSE2)
+    __m128i zero = _mm_setzero_si128();
+    __m128i channels = _mm_loadl_epi64((const __m128i *)fixed);
+    __m128i result;
+
+    if (unpremultiply)
+    {
+        __m128 values = _mm_cvtepi32_ps(_mm_unpacklo_epi16(channels, zero));
+        __m128 scale = _mm_div_ps(_mm_set1_ps(255.0f), _mm_shuffle_ps(values, values, _MM_SHUFFLE(3, 3, 3, 3)));
+        values = _mm_min_ps(_mm_add_ps(_mm_mul_ps(values, scale), _mm_set1_ps(0.5f)), _mm_set1_ps(255.0f));
+        result = _mm_insert_epi16(_mm_cvttps_epi32(values), (int)a, 6);
+        result = _mm_packs_epi32(result, result);
+    }
+    else result = _mm_srli_epi16(_mm_add_epi16(channels, _mm_set1_epi16(64)), 7);
+
+    int packed = _mm_cvtsi128_si32(_mm_packus_epi16(result, result));
+    memcpy(pixel, &packed, 4);
+#else
+    if (unpremultiply)
+    {
+        float scale = 255.0f/(float)fixed[3];
+        for (int c = 0; c < 3; c++)
+        {
+            float value = (float)fixed[c]*scale + 0.5f;
+            pixel[c] = (value < 255.0f)? (unsigned char)value : 255;
+        }
+    }
+    else
+    {
+        for (int c = 0; c < 3; c++) pixel[c] = (unsigned char)((fixed[c] + 64) >> 7);
+    }
+    pixel[3] = (unsigned char)a;
+#endif
+}
+
+// Blur RGBA8 row strips horizontally, premultiplying alpha
+// NOTE: Strip rows are interleaved pixel by pixel, box blur passes run over all of them at once
+static void BlurRows(void *data, int start, int end)
+{
+    const BlurTask *task = (const BlurTask *)data;
+    int width = task->width;
+    unsigned short *bufferA = (unsigned short *)RL_CALLOC(width*BLUR_STRIP_LANES, sizeof(unsigned short));
+    unsigned short *bufferB = (unsigned short *)RL_MALLOC(width*BLUR_STRIP_LANES*sizeof(unsigned short));
+
+    for (int strip = start; strip < end; strip++)
+    {
+        int top = strip*BLUR_STRIP_PIXELS;
+        int rows = (task->height - top < BLUR_STRIP_PIXELS)? task->height - top : BLUR_STRIP_PIXELS;
+
+        for (int r = 0; r < rows; r++)
+        {
+            const unsigned char *pixels = task->pixels + (size_t)(top + r)*width*4;
+            unsigned short *fixed = bufferA + r*4;
+
+            for (int x = 0; x < width; x++, pixels += 4, fixed += BLUR_STRIP_LANES) LoadBlurPixel(pixels, fixed, true);
+        }
+
+        for (int i = 0; i < GAUSSIAN_BLUR_ITERATIONS; i++)
+        {
+            if ((i%2) == 0) BoxBlurPass(bufferA, bufferB, width, task->radius);
+            else BoxBlurPass(bufferB, bufferA, width, task->radius);
+        }
+
+        const unsigned short *result = ((GAUSSIAN_BLUR_ITERATIONS%2) == 0)? bufferA : bufferB;
+        for (int r = 0; r < rows; r++)
+        {
+            unsigned char *pixels = task->pixels + (size_t)(top + r)*width*4;
+            const unsigned short *blurred = result + r*4;
+
+            for (int x = 0; x < width; x++, pixels += 4, blurred += BLUR_STRIP_LANES) StoreBlurPixel(blurred, pixels, false);
+        }
+    }
+
+    RL_FREE(bufferA);
+    RL_FREE(bufferB);
+}
+
+// Blur RGBA8 column strips vertically, reversing alpha premultiply
+static void BlurColumns(void *data, int start, int end)
+{
+    const BlurTask *task = (const BlurTask *)data;
+    int width = task->width;
+    int height = task->height;
+    unsigned short *bufferA = (unsigned short *)RL_CALLOC(height*BLUR_STRIP_LANES, sizeof(unsigned short));
+    unsigned short *bufferB = (unsigned short *)RL_MALLOC(height*BLUR_STRIP_LANES*sizeof(unsigned short));
+
+    for (int strip = start; strip < end; strip++)
+    {
+        int left = strip*BLUR_STRIP_PIXELS;
+        int lanes = ((width - left < BLUR_STRIP_PIXELS)? width - left : BLUR_STRIP_PIXELS)*4;
+
+        for (int y = 0; y < height; y++)
+        {
+            const unsigned char *pixels = task->pixels + ((size_t)y*width + left)*4;
+            for (int l = 0; l < lanes; l += 4) LoadBlurPixel(pixels + l, bufferA + y*BLUR_STRIP_LANES + l, false);
+        }
+
+        for (int i = 0; i < GAUSSIAN_BLUR_ITERATIONS; i++)
+        {
+            if ((i%2) == 0) BoxBlurPass(bufferA, bufferB, height, task->radius);
+            else BoxBlurPass(bufferB, bufferA, height, task->radius);
+        }
+
+        const unsigned short *result = ((GAUSSIAN_BLUR_ITERATIONS%2) == 0)? bufferA : bufferB;
+        for (int y = 0; y < height; y++)
+        {
+            unsigned char *pixels = task->pixels + ((size_t)y*width + left)*4;
+            const unsigned short *blurred = result + y*BLUR_STRIP_LANES;
+
+            for (int l = 0; l < lanes; l += 4) StoreBlurPixel(blurred + l, pixels + l, true);
+        }
+    }
+
+    RL_FREE(bufferA);
+    RL_FREE(bufferB);
+}
+
+// Add weight times src to sums, count being a multiple of 4
+static void MulAddFloats(float *sums, const float *src, float weight, int count)
+{
+    int i = 0;
+
+#if defined(RTEXTURES_AVX2)
+    __m256 weight8 = _mm256_set1_ps(weight);
+    for (; i + 8 <= count; i += 8) _mm256_storeu_ps(sums + i, _mm256_add_ps(_mm256_loadu_ps(sums + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), weight8)));
+#endif
+#if defined(RTEXTURES_SSE2)
+    __m128 weight4 = _mm_set1_ps(weight);
+    for (; i < count; i += 4) _mm_storeu_ps(sums + i, _mm_add_ps(_mm_loadu_ps(sums + i), _mm_mul_ps(_mm_loadu_ps(src + i), weight4)));
+#else
+    for (; i < count; i++) sums[i] += src[i]*weight;
+#endif
+}
+
+// Convolve RGBA8 tiles with a separable kernel
+// NOTE: Rows the tile reaches are convolved horizontally first, then the tile vertically, in floats
+static void ConvolveSeparableTiles(void *data, int start, int end)
+{
+    const ConvolutionTask *task = (const ConvolutionTask *)data;
+    int width = task->width;
+    int height = task->height;
+    int kernelWidth = task->kernelWidth;
+    int before = kernelWidth/2;
+    int tilesX = (width + CONVOLUTION_TILE - 1)/CONVOLUTION_TILE;
+
+    float *line = (float *)RL_MALLOC((CONVOLUTION_TILE + kernelWidth)*4*sizeof(float));
+    float *rows = (float *)RL_MALLOC((CONVOLUTION_TILE + kernelWidth)*CONVOLUTION_TILE*4*sizeof(float));
+    float *sums = (float *)RL_MALLOC(CONVOLUTION_TILE*4*sizeof(float));
+
+    for (int tile = start; tile < end; tile++)
+    {
+        int left = (tile%tilesX)*CONVOLUTION_TILE;
+        int top = (tile/tilesX)*CONVOLUTION_TILE;
+        int tileWidth = (width - left < CONVOLUTION_TILE)? width - left : CONVOLUTION_TILE;
+        int tileHeight = (height - top < CONVOLUTION_TILE)? height - top : CONVOLUTION_TILE;
+
+        for (int r = 0; r < tileHeight + kernelWidth - 1; r++)
+        {
+            int y = top + r - before;
+            float *row = rows + r*CONVOLUTION_TILE*4;
+
+            memset(row, 0, tileWidth*4*sizeof(float));
+            if ((y < 0) || (y >= height)) continue;
+
+            // Line pixels from first to last are inside the image, the rest zero
+            const unsigned char *pixels = task->src + (size_t)y*width*4;
+            int offset = (left - before)*4;
+            int count = tileWidth + kernelWidth - 1;
+            int first = (before > left)? before - left : 0;
+            int last = (left - before + count > width)? width - left + before : count;
+
+            memset(line, 0, count*4*sizeof(float));
+            for (int i = first*4; i < last*4; i++) line[i] = (float)pixels[offset + i];
+
+            for (int j = 0; j < kernelWidth; j++) MulAddFloats(row, line + j*4, task->rowWeights[j], tileWidth*4);
+        }
+
+        for (int r = 0; r < tileHeight; r++)
+        {
+            unsigned char *pixels = task->dst + ((size_t)(top + r)*width + left)*4;
+
+            memset(sums, 0, tileWidth*4*sizeof(float));
+            for (int i = 0; i < kernelWidth; i++) MulAddFloats(sums, rows + (r + i)*CONVOLUTION_TILE*4, task->columnWeights[i], tileWidth*4);
+
+            int i = 0;
+#if defined(RTEXTURES_SSE2)
+            // Same rounding as below: add half, clamp, truncate
+            for (; i + 16 <= tileWidth*4; i += 16)
+            {
+                __m128i values[4];
+                for (int n = 0; n < 4; n++)
+                {
+                    __m128 value = _mm_add_ps(_mm_loadu_ps(sums + i + n*4), _mm_set1_ps(0.5f));
+                    values[n] = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(255.0f)));
+                }
+                _mm_storeu_si128((__m128i *)(pixels + i), _mm_packus_epi16(_mm_packs_epi32(values[0], values[1]), _mm_packs_epi32(values[2], values[3])));
+            }
+#endif
+            for (; i < tileWidth*4; i++)
+            {
+                float value = sums[i] + 0.5f;
+                pixels[i] = (value <= 0.0f)? 0 : (value >= 255.0f)? 255 : (unsigned char)value;
+            }
+        }
+    }
+
+    RL_FREE(line);
+    RL_FREE(rows);
+    RL_FREE(sums);
+}
+
+// Convolve RGBA8 tiles with a fixed point kernel
+// NOTE: Source rows the tile reaches are widened to 16 bit once, then every output pixel sums
+// kernel taps two at a time (pixels interleaved channel by channel against a weights pair)
+static void ConvolveFixedTiles(void *data, int start, int end)
+{
+    const ConvolutionTask *task = (const ConvolutionTask *)data;
+    int width = task->width;
+    int height = task->height;
+    int kernelWidth = task->kernelWidth;
+    int before = kernelWidth/2;
+    int pairs = (kernelWidth + 1)/2;
+    int shift = task->fixedShift;
+    int tilesX = (width + CONVOLUTION_TILE - 1)/CONVOLUTION_TILE;
+    int stride = (CONVOLUTION_TILE + kernelWidth + 1)*4;    // Taps pairs read up to one pixel more
+
+    short *source = (short *)RL_CALLOC((CONVOLUTION_TILE + kernelWidth)*stride, sizeof(short));
+
+    for (int tile = start; tile < end; tile++)
+    {
+        int left = (tile%tilesX)*CONVOLUTION_TILE;
+        int top = (tile/tilesX)*CONVOLUTION_TILE;
+        int tileWidth = (width - left < CONVOLUTION_TILE)? width - left : CONVOLUTION_TILE;
+        int tileHeight = (height - top < CONVOLUTION_TILE)? height - top : CONVOLUTION_TILE;
+
+        for (int r = 0; r < tileHeight + kernelWidth - 1; r++)
+        {
+            int y = top + r - before;
+            short *row = source + r*stride;
+            int count = tileWidth + kernelWidth + 1;
+
+            memset(row, 0, count*4*sizeof(short));
+            if ((y < 0) || (y >= height)) continue;
+
+            // Row pixels from first to last are inside the image, the rest zero
+            const unsigned char *pixels = task->src + (size_t)y*width*4;
+            int offset = (left - before)*4;
+            int first = (before > left)? before - left : 0;
+            int last = (left - before + count > width)? width - left + before : count;
+
+            for (int i = first*4; i < last*4; i++) row[i] = pixels[offset + i];
+        }
+
+        for (int r = 0; r < tileHeight; r++)
+        {
+            unsigned char *pixels = task->dst + ((size_t)(top + r)*width + left)*4;
+
+            for (int x = 0; x < tileWidth; x += 2)
+            {
+#if defined(RTEXTURES_SSE2)
+                __m128i sum0 = _mm_setzero_si128();     // Pixel x channels
+                __m128i sum1 = _mm_setzero_si128();     // Pixel x + 1 channels
+
+                for (int i = 0; i < kernelWidth; i++)
+                {
+                    const short *row = source + (r + i)*stride + x*4;
+                    const int *weights = task->fixedWeights + i*pairs;
+
+                    for (int p = 0; p < pairs; p++)
+                    {
+                        __m128i a = _mm_loadu_si128((const __m128i *)(row + p*8));        // Pixels x + 2p, x + 2p + 1
+                        __m128i b = _mm_loadu_si128((const __m128i *)(row + p*8 + 4));    // Pixels x + 2p + 1, x + 2p + 2
+                        __m128i weight = _mm_set1_epi32(weights[p]);
+
+                        sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), weight));
+                        sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), weight));
+                    }
+                }
+
+                __m128i half = _mm_set1_epi32((1 << shift) >> 1);
+                __m128i count = _mm_cvtsi32_si128(shift);
+                sum0 = _mm_sra_epi32(_mm_add_epi32(sum0, half), count);
+                sum1 = _mm_sra_epi32(_mm_add_epi32(sum1, half), count);
+
+                __m128i packed = _mm_packus_epi16(_mm_packs_epi32(sum0, sum1), _mm_setzero_si128());
+                if (x + 1 < tileWidth) _mm_storel_epi64((__m128i *)(pixels + x*4), packed);
+                else
+                {
+                    int first = _mm_cvtsi128_si32(packed);
+                    memcpy(pixels + x*4, &first, 4);
+                }
+#else
+                for (int n = x; (n < x + 2) && (n < tileWidth); n++)
+                {
+                    int sums[4] = { 0 };
+
+                    for (int i = 0; i < kernelWidth; i++)
+                    {
+                        const short *row = source + (r + i)*stride + n*4;
+                        const int *weights = task->fixedWeights + i*pairs;
+
+                        for (int p = 0; p < pairs; p++)
+                        {
+                            int weight0 = (short)(weights[p] & 0xFFFF);
+                            int weight1 = (short)((unsigned int)weights[p] >> 16);
+                            for (int c = 0; c < 4; c++) sums[c] += row[p*8 + c]*weight0 + row[p*8 + 4 + c]*weight1;
+                        }
+                    }
+
+                    for (int c = 0; c < 4; c++)
+                    {
+                        int value = (sums[c] + ((1 << shift) >> 1)) >> shift;
+                        pixels[n*4 + c] = (value < 0)? 0 : (value > 255)? 255 : (unsigned char)value;
+                    }
+                }
+#endif
+            }
+        }
+    }
+
+    RL_FREE(source);
+}
+
+// Store color in any uncompressed pixel format
+static void StorePixelColor(unsigned char *pixel, Color color, int format)
+{
+    switch (format)
+    {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE:
+        {
+            // NOTE: Calculate grayscale equivalent color
+            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
+            unsigned char gray = (unsigned char)((coln.x*0.299f + coln.y*0.587f + coln.z*0.114f)*255.0f);
+
+            pixel[0] = gray;
+
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+        {
+            // NOTE: Calculate grayscale equivalent color
+            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
+            unsigned char gray = (unsigned char)((coln.x*0.299f + coln.y*0.587f + coln.z*0.114f)*255.0f);
+
+            pixel[0] = gray;
+            pixel[1] = color.a;
+
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
+        {
+            // NOTE: Calculate R5G6B5 equivalent color
+            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
+
+            unsigned char r = (unsigned char)(round(coln.x*31.0f));
+            unsigned char g = (unsigned char)(round(coln.y*63.0f));
+            unsigned char b = (unsigned char)(round(coln.z*31.0f));
+
+            ((unsigned short *)pixel)[0] = (unsigned short)r << 11 | (unsigned short)g << 5 | (unsigned short)b;
+
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+        {
+            // NOTE: Calculate R5G5B5A1 equivalent color
+            Vector4 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f };
+
+            unsigned char r = (unsigned char)(round(coln.x*31.0f));
+            unsigned char g = (unsigned char)(round(coln.y*31.0f));
+            unsigned char b = (unsigned char)(round(coln.z*31.0f));
+            unsigned char a = (coln.w > ((float)PIXELFORMAT_UNCOMPRESSED_R5G5B5A1_ALPHA_THRESHOLD/255.0f))? 1 : 0;
+
+            ((unsigned short *)pixel)[0] = (unsigned short)r << 11 | (unsigned short)g << 6 | (unsigned short)b << 1 | (unsigned short)a;
+
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
+        {
+            // NOTE: Calculate R5G5B5A1 equivalent color
+            Vector4 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f };
+
+            unsigned char r = (unsigned char)(round(coln.x*15.0f));
+            unsigned char g = (unsigned char)(round(coln.y*15.0f));
+            unsigned char b = (unsigned char)(round(coln.z*15.0f));
+            unsigned char a = (unsigned char)(round(coln.w*15.0f));
+
+            ((unsigned short *)pixel)[0] = (unsigned short)r << 12 | (unsigned short)g << 8 | (unsigned short)b << 4 | (unsigned short)a;
+
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8:
+        {
+            pixel[0] = color.r;
+            pixel[1] = color.g;
+            pixel[2] = color.b;
+
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8:
+        {
+            pixel[0] = color.r;
+            pixel[1] = color.g;
+            pixel[2] = color.b;
+            pixel[3] = color.a;
+
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R32:
+        {
+            // NOTE: Calculate grayscale equivalent color (normalized to 32bit)
+            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
+
+            ((float *)pixel)[0] = coln.x*0.299f + coln.y*0.587f + coln.z*0.114f;
+
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R32G32B32:
+        {
+            // NOTE: Calculate R32G32B32 equivalent color (normalized to 32bit)
+            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
+
+            ((float *)pixel)[0] = coln.x;
+            ((float *)pixel)[1] = coln.y;
+            ((float *)pixel)[2] = coln.z;
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R32G32B32A32:
+        {
+            // NOTE: Calculate R32G32B32A32 equivalent color (normalized to 32bit)
+            Vector4 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f };
+
+            ((float *)pixel)[0] = coln.x;
+            ((float *)pixel)[1] = coln.y;
+            ((float *)pixel)[2] = coln.z;
+            ((float *)pixel)[3] = coln.w;
+
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R16:
+        {
+            // NOTE: Calculate grayscale equivalent color (normalized to 32bit)
+            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
+
+            ((unsigned short *)pixel)[0] = FloatToHalf(coln.x*0.299f + coln.y*0.587f + coln.z*0.114f);
+
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R16G16B16:
+        {
+            // NOTE: Calculate R32G32B32 equivalent color (normalized to 32bit)
+            Vector3 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f };
+
+            ((unsigned short *)pixel)[0] = FloatToHalf(coln.x);
+            ((unsigned short *)pixel)[1] = FloatToHalf(coln.y);
+            ((unsigned short *)pixel)[2] = FloatToHalf(coln.z);
+        } break;
+        case PIXELFORMAT_UNCOMPRESSED_R16G16B16A16:
+        {
+            // NOTE: Calculate R32G32B32A32 equivalent color (normalized to 32bit)
+            Vector4 coln = { (float)color.r/255.0f, (float)color.g/255.0f, (float)color.b/255.0f, (float)color.a/255.0f };
+
+            ((unsigned short *)pixel)[0] = FloatToHalf(coln.x);
+            ((unsigned short *)pixel)[1] = FloatToHalf(coln.y);
+            ((unsigned short *)pixel)[2] = FloatToHalf(coln.z);
+            ((unsigned short *)pixel)[3] = FloatToHalf(coln.w);
+
+        } break;
+        default: break;
+    }
+}
+
+// Convert color once for spans drawn on a pixel format
+static PixelPen LoadPixelPen(int format, Color color, bool blend)
+{
+    PixelPen pen = { 0 };
+
+    if (format < PIXELFORMAT_COMPRESSED_DXT1_RGB)
+    {
+        pen.bytesPerPixel = GetPixelDataSize(1, 1, format);
+        pen.format = format;
+        pen.color = color;
+
+        // Opaque colors replace pixels, transparent ones leave them
+        pen.blend = blend && (color.a < 255);
+        if (pen.blend && (color.a == 0)) pen.bytesPerPixel = 0;
+
+        StorePixelColor((unsigned char *)pen.pixel, color, format);
+    }
+
+    return pen;
+}
+
+// Repeat one pixel count times
+// NOTE: Pixels of sizes dividing 16 bytes are stored as 16 (32 with AVX2) byte patterns,
+// other sizes double the filled part until the span is done
+static void FillPixelSpan(unsigned char *dst, const void *pixel, int bytesPerPixel, int count)
+{
+    const unsigned char *bytes = (const unsigned char *)pixel;
+    size_t size = (size_t)count*bytesPerPixel;
+    bool sameBytes = true;
+
+    for (int i = 1; i < bytesPerPixel; i++) if (bytes[i] != bytes[0]) sameBytes = false;
+
+    if (sameBytes) memset(dst, bytes[0], size);
+    else if ((16%bytesPerPixel) == 0)
+    {
+        unsigned char pattern[32];
+        for (int i = 0; i < 32; i += bytesPerPixel) memcpy(pattern + i, bytes, bytesPerPixel);
+
+        size_t i = 0;
+#if defined(RTEXTURES_AVX2)
+        __m256i pattern32 = _mm256_loadu_si256((const __m256i *)pattern);
+        for (; i + 32 <= size; i += 32) _mm256_storeu_si256((__m256i *)(dst + i), pattern32);
+#endif
+#if defined(RTEXTURES_SSE2)
+        __m128i pattern16 = _mm_loadu_si128((const __m128i *)pattern);
+        for (; i + 16 <= size; i += 16) _mm_storeu_si128((__m128i *)(dst + i), pattern16);
+#else
+        for (; i + 32 <= size; i += 32) memcpy(dst + i, pattern, 32);
+#endif
+        memcpy(dst + i, pattern, size - i);
+    }
+    else if (size > 0)
+    {
+        memcpy(dst, bytes, bytesPerPixel);
+
+        for (size_t filled = bytesPerPixel; filled < size; filled *= 2)
+        {
+            memcpy(dst + filled, dst, (filled < size - filled)? filled : size - filled);
+        }
+    }
+}
+
+// Blend pen color over count pixels, as ColorAlphaBlend() with a white tint does
+static void BlendPixelSpan(unsigned char *dst, const PixelPen *pen, int count)
+{
+    unsigned int alpha = (unsigned int)pen->color.a + 1;
+    unsigned int r = (unsigned int)pen->color.r*alpha*256;
+    unsigned int g = (unsigned int)pen->color.g*alpha*256;
+    unsigned int b = (unsigned int)pen->color.b*alpha*256;
+
+    if ((pen->format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) || (pen->format == PIXELFORMAT_UNCOMPRESSED_R8G8B8))
+    {
+        int step = pen->bytesPerPixel;
+
+        for (int i = 0; i < count; i++, dst += step)
+        {
+            unsigned int keep = ((step == 4)? dst[3] : 255)*(256 - alpha);
+            unsigned int outAlpha = (alpha*256 + keep) >> 8;      // Never 0, alpha is at least 1
+
+            dst[0] = (unsigned char)(((r + dst[0]*keep)/outAlpha) >> 8);
+            dst[1] = (unsigned char)(((g + dst[1]*keep)/outAlpha) >> 8);
+            dst[2] = (unsigned char)(((b + dst[2]*keep)/outAlpha) >> 8);
+            if (step == 4) dst[3] = (unsigned char)outAlpha;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < count; i++, dst += pen->bytesPerPixel)
+        {
+            StorePixelColor(dst, ColorAlphaBlend(GetPixelColor(dst, pen->format), pen->color, WHITE), pen->format);
+        }
+    }
+}
+
+// Draw span of pixels, clipped to the image
+// NOTE: Only the span pixels are read or written, spans can be drawn from several threads
+// as long as they do not overlap
+static void DrawPenSpan(Image *dst, const PixelPen *pen, int x, int y, int width)
+{
+    if ((pen->bytesPerPixel == 0) || (y < 0) || (y >= dst->height)) return;
+
+    if (x < 0) { width += x; x = 0; }
+    if (x + width > dst->width) width = dst->width - x;
+    if (width <= 0) return;
+
+    unsigned char *pixels = (unsigned char *)dst->data + ((size_t)y*dst->width + x)*pen->bytesPerPixel;
+
+    if (pen->blend) BlendPixelSpan(pixels, pen, width);
+    else FillPixelSpan(pixels, pen->pixel, pen->bytesPerPixel, width);
+}
+
 #endif      // SUPPORT_MODULE_RTEXTURES
@@ -157,15 +157,16 @@ if (downloadRaylib) then
 
         vpaths 
         {
-            ["Header Files/*"] = { "../include/**.h",  "../include/**.hpp", "../src/**.h", "../src/**.hpp"},
-            ["Source Files/*"] = {"../src/**.c", "src/**.cpp"},
+            ["Header Files/*"] = { "../include/**.h",  "../include/**.hpp", "../*.h"},
+            ["Source Files/*"] = {"../main.cpp"},
         }
-        files {"../src/**.c", "../src/**.cpp", "../src/**.h", "../src/**.hpp", "../include/**.h", "../include/**.hpp"}
+        -- the UI only; the business logic comes from the pizzeria library below
+        files {"../main.cpp", "../raygui.h", "../include/**.h", "../include/**.hpp"}
     
-        includedirs { "../src" }
+        includedirs { "../" }
         includedirs { "../include" }
 
-        links {"raylib"}
+        links {"pizzeria", "raylib"}
 
         cdialect "C17"
         cppdialect "C++17"
@@ -178,7 +179,7 @@ if (downloadRaylib) then
 
         filter "action:vs*"
             defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS"}
-            dependson {"raylib"}
+            dependson {"raylib", "pizzeria"}
             links {"raylib.lib"}
             characterset ("Unicode")
             buildoptions { "/Zc:__cplusplus" }
@@ -197,6 +198,107 @@ if (downloadRaylib) then
         filter{}
 		
 
+    -- menu, orders, kitchen and journal without raylib, shared by the game and the benchmark
+    project "pizzeria"
+        kind "StaticLib"
+        language "C++"
+        cppdialect "C++17"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        vpaths
+        {
+            ["Header Files/*"] = { "../include/**.h" },
+            ["Source Files/*"] = { "../src/**.cpp" },
+        }
+        files {"../src/**.cpp", "../src/**.h", "../include/**.h"}
+        includedirs { "../include" }
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            buildoptions { "/Zc:__cplusplus" }
+        filter{}
+
+    project "pizzeria_bench"
+        kind "ConsoleApp"
+        language "C++"
+        cppdialect "C++17"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        files {"../bench/pizzeria_bench.cpp"}
+        includedirs { "../include" }
+        links {"pizzeria"}
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            dependson {"pizzeria"}
+            buildoptions { "/Zc:__cplusplus" }
+
+        filter "system:windows"
+            libdirs {"../bin/%{cfg.buildcfg}"}
+
+        filter "system:linux"
+            links {"pthread"}
+
+        filter{}
+
+    -- order service for several tills, see include/order_server.h
+    project "pizzeria_server"
+        kind "ConsoleApp"
+        language "C++"
+        cppdialect "C++17"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        files {"../server/**.cpp"}
+        includedirs { "../include" }
+        links {"pizzeria"}
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            dependson {"pizzeria"}
+            buildoptions { "/Zc:__cplusplus" }
+
+        filter "system:windows"
+            libdirs {"../bin/%{cfg.buildcfg}"}
+
+        filter "system:linux"
+            links {"pthread"}
+
+        filter{}
+
+    -- CPU image functions of raylib (rtextures.c) without a window
+    project "image_bench"
+        kind "ConsoleApp"
+        language "C++"
+        cppdialect "C++17"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        files {"../bench/image_bench.cpp"}
+        includedirs {raylib_dir .. "/src" }
+        links {"raylib"}
+        platform_defines()
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            dependson {"raylib"}
+            links {"raylib.lib"}
+            buildoptions { "/Zc:__cplusplus" }
+
+        filter "system:windows"
+            links {"winmm", "gdi32", "opengl32"}
+            libdirs {"../bin/%{cfg.buildcfg}"}
+
+        filter "system:linux"
+            links {"pthread", "m", "dl", "rt", "X11"}
+
+        filter "system:macosx"
+            links {"OpenGL.framework", "Cocoa.framework", "IOKit.framework", "CoreFoundation.framework", "CoreAudio.framework", "CoreVideo.framework", "AudioToolbox.framework"}
+
+        filter{}
+
     project "raylib"
         kind "StaticLib"
     
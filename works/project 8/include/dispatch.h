@@ -0,0 +1,116 @@
+// dispatch.h
+#pragma once
+
+#include "menu.h"
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Delivery dispatch on a grid city: the pizzeria sits at (0, 0) and
+// couriers drive along the streets, so distances are Manhattan blocks.
+//
+// Ready delivery orders wait in a pool split by direction. A sector is
+// dispatched when it can fill a courier or its oldest order has waited
+// long enough; the batch is the oldest order plus its nearest neighbours
+// going the same way, routed nearest-neighbour first and then improved
+// with 2-opt. While a courier is loading, new orders for its sector are
+// inserted into the planned route instead of waiting for the next trip.
+// Fees are set at departure from each order's share of the route.
+
+struct GridPoint {
+	int16_t x = 0;
+	int16_t y = 0;
+};
+
+inline int gridDistance(GridPoint a, GridPoint b) { return abs(a.x - b.x) + abs(a.y - b.y); }
+
+struct DispatchConfig {
+	int couriers = 6;
+	int tripCapacity = 4;          // orders per trip, at most MAX_STOPS
+	int gridRadius = 30;           // blocks from the pizzeria to the edge of town
+	double blockMeters = 120;
+	double courierSpeed = 7;       // meters per second
+	double handoverSeconds = 60;   // at every stop
+	double loadSeconds = 30;       // between planning and departure
+	double maxHoldSeconds = 180;   // a lone order stops waiting for company
+	int sectors = 12;
+	Cents baseFee = 150;
+	Cents centsPerKm = 80;
+};
+
+struct DispatchEvent {
+	enum Kind : uint8_t { DEPARTED, DELIVERED };
+	Kind kind;
+	int orderId;
+	int courier;
+	Cents fee; // final delivery fee, set on DEPARTED
+};
+
+struct DispatchStats {
+	int couriers = 0;
+	int idle = 0;
+	int loading = 0;
+	int waiting = 0;               // orders not on a courier yet
+	uint64_t received = 0;
+	uint64_t delivered = 0;
+	uint64_t trips = 0;
+	double ordersPerTrip = 0;
+	double kmPerOrder = 0;         // route length over orders carried
+	double avgHoldSeconds = 0;     // from ready to departure
+	double maxUpdateMicros = 0;    // slowest update since the last stats()
+};
+
+class Dispatcher {
+public:
+	static constexpr int MAX_STOPS = 16;
+
+	explicit Dispatcher(const DispatchConfig& config = DispatchConfig());
+
+	// Stands in for geocoding: the same address always lands on the same corner.
+	GridPoint locate(const std::string& address) const;
+	// What the customer pays if the order goes out alone.
+	Cents quote(GridPoint drop) const;
+
+	// now is in seconds on any steady clock, the same one for every call.
+	void add(int orderId, GridPoint drop, double now);
+	// Moves couriers on to now, plans new trips and reports what happened.
+	void update(double now, std::vector<DispatchEvent>& events);
+	DispatchStats stats();
+
+private:
+	struct Stop {
+		int orderId;
+		GridPoint drop;
+		double readyAt;
+	};
+
+	struct Courier {
+		enum State : uint8_t { IDLE, LOADING, DRIVING } state = IDLE;
+		int sector = 0;
+		std::vector<Stop> route;   // in driving order
+		std::vector<double> arrivals;
+		size_t nextDrop = 0;
+		double departAt = 0;
+		double backAt = 0;
+	};
+
+	DispatchConfig config;
+	std::vector<std::vector<Stop>> pool; // by sector
+	std::vector<Courier> couriers;
+	std::vector<std::vector<int>> loading; // courier indices by sector
+	int waiting = 0;
+	DispatchStats totals;
+	double holdSeconds = 0;
+	double routeKm = 0;
+	uint64_t ordersCarried = 0;
+
+	int sectorOf(GridPoint p) const;
+	bool due(const std::vector<Stop>& sector, double now) const;
+	void plan(int courier, int sector, double now);
+	bool insert(Courier& c, const Stop& s);
+	void depart(Courier& c, int index, double now, std::vector<DispatchEvent>& events);
+
+	static int routeBlocks(const std::vector<Stop>& route);
+	static void improve(std::vector<Stop>& route);
+};
@@ -0,0 +1,295 @@
+/**********************************************************************************************
+*
+*   frame_profiler.h - куда уходит время кадра
+*
+*   Зоны отмечаются парами PROFILE_BEGIN("имя") / PROFILE_END(); зоны можно вкладывать.
+*   PROFILE_FRAME_END() после EndDrawing() закрывает кадр: его время и собственное время
+*   каждой зоны (без вложенных) попадают в кольцо из PROFILER_HISTORY кадров.
+*   PROFILE_OVERLAY() внутри BeginDrawing/EndDrawing обрабатывает клавиши и рисует
+*   столбики по кадрам:
+*       F3 - показать/скрыть график
+*       F4 - записать последние PROFILER_MAX_EVENTS зон в profile_trace.json
+*            (формат Chrome trace: chrome://tracing или ui.perfetto.dev)
+*
+*   Время берётся из GetTime(), одна зона стоит два его вызова и несколько сложений.
+*
+*   Один .c/.cpp в проекте должен определить FRAME_PROFILER_IMPLEMENTATION перед
+*   подключением. Если определён FRAME_PROFILER_DISABLE, все макросы PROFILE_*
+*   превращаются в пустоту и профилировщик не компилируется вовсе.
+*
+*   Копии этого файла лежат в каждом проекте с raylib; меняя один, меняйте все.
+*
+**********************************************************************************************/
+
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include "raylib.h"
+
+#define PROFILER_MAX_ZONES 16
+#define PROFILER_MAX_DEPTH 16
+#define PROFILER_HISTORY 240     // кадров в графике
+#define PROFILER_MAX_EVENTS 8192 // зон в кольце для трассы
+
+#if defined(FRAME_PROFILER_DISABLE)
+#define PROFILE_BEGIN(name) ((void)0)
+#define PROFILE_END() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#define PROFILE_OVERLAY() ((void)0)
+#else
+#define PROFILE_BEGIN(name) ProfilerBegin(name)
+#define PROFILE_END() ProfilerEnd()
+#define PROFILE_FRAME_END() ProfilerFrameEnd()
+#define PROFILE_OVERLAY() ProfilerOverlay()
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// name должен жить всю программу (строковый литерал)
+void ProfilerBegin(const char *name);
+void ProfilerEnd(void);
+void ProfilerFrameEnd(void);
+void ProfilerOverlay(void);
+bool ProfilerDumpTrace(const char *path);
+
+#if defined(__cplusplus)
+}
+#endif
+#endif // FRAME_PROFILER_DISABLE
+
+#endif // FRAME_PROFILER_H
+
+/***********************************************************************************
+*
+*   FRAME_PROFILER_IMPLEMENTATION
+*
+************************************************************************************/
+#if defined(FRAME_PROFILER_IMPLEMENTATION) && !defined(FRAME_PROFILER_DISABLE)
+
+#include <stdio.h>
+#include <string.h>
+
+typedef struct
+{
+    float frameMs;
+    float selfMs[PROFILER_MAX_ZONES]; // без вложенных зон, поэтому складываются в столбик
+} ProfilerFrame;
+
+typedef struct
+{
+    short zone;
+    short depth;
+    double start; // секунды GetTime()
+    float duration;
+} ProfilerEvent;
+
+typedef struct
+{
+    short zone;
+    double start;
+    double childTime;
+} ProfilerOpenZone;
+
+static struct
+{
+    const char *zoneNames[PROFILER_MAX_ZONES];
+    int zoneCount;
+
+    ProfilerOpenZone stack[PROFILER_MAX_DEPTH];
+    int depth;
+
+    ProfilerFrame current;
+    ProfilerFrame frames[PROFILER_HISTORY];
+    int frameHead; // куда пишется следующий кадр
+    int frameCount;
+    double frameStart;
+
+    ProfilerEvent events[PROFILER_MAX_EVENTS];
+    int eventHead;
+    int eventCount;
+
+    bool visible;
+} profiler;
+
+static int ProfilerZoneId(const char *name)
+{
+    // обычно тот же литерал, поэтому сначала сравниваем указатели
+    for (int i = 0; i < profiler.zoneCount; i++)
+        if (profiler.zoneNames[i] == name)
+            return i;
+    for (int i = 0; i < profiler.zoneCount; i++)
+        if (strcmp(profiler.zoneNames[i], name) == 0)
+            return i;
+    if (profiler.zoneCount == PROFILER_MAX_ZONES)
+        return -1;
+    profiler.zoneNames[profiler.zoneCount] = name;
+    return profiler.zoneCount++;
+}
+
+void ProfilerBegin(const char *name)
+{
+    if (profiler.depth == PROFILER_MAX_DEPTH)
+    {
+        profiler.depth++; // ProfilerEnd снимет эту лишнюю зону
+        return;
+    }
+    ProfilerOpenZone *open = &profiler.stack[profiler.depth++];
+    open->zone = (short)ProfilerZoneId(name);
+    open->childTime = 0.0;
+    open->start = GetTime();
+}
+
+void ProfilerEnd(void)
+{
+    double now = GetTime();
+    if (profiler.depth == 0)
+        return;
+    if (profiler.depth-- > PROFILER_MAX_DEPTH)
+        return;
+    ProfilerOpenZone *open = &profiler.stack[profiler.depth];
+    double duration = now - open->start;
+    if (profiler.depth > 0)
+        profiler.stack[profiler.depth - 1].childTime += duration;
+    if (open->zone < 0)
+        return;
+
+    profiler.current.selfMs[open->zone] += (float)((duration - open->childTime) * 1000.0);
+    ProfilerEvent *e = &profiler.events[profiler.eventHead];
+    e->zone = open->zone;
+    e->depth = (short)profiler.depth;
+    e->start = open->start;
+    e->duration = (float)duration;
+    profiler.eventHead = (profiler.eventHead + 1) % PROFILER_MAX_EVENTS;
+    if (profiler.eventCount < PROFILER_MAX_EVENTS)
+        profiler.eventCount++;
+}
+
+void ProfilerFrameEnd(void)
+{
+    double now = GetTime();
+    if (profiler.frameStart > 0.0)
+    {
+        profiler.current.frameMs = (float)((now - profiler.frameStart) * 1000.0);
+        profiler.frames[profiler.frameHead] = profiler.current;
+        profiler.frameHead = (profiler.frameHead + 1) % PROFILER_HISTORY;
+        if (profiler.frameCount < PROFILER_HISTORY)
+            profiler.frameCount++;
+    }
+    memset(&profiler.current, 0, sizeof(profiler.current));
+    profiler.frameStart = now;
+}
+
+//----------------------------------------------------------------------------------
+// Трасса Chrome: события "X" (начало + длительность) в микросекундах
+//----------------------------------------------------------------------------------
+bool ProfilerDumpTrace(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return false;
+    int first = (profiler.eventHead - profiler.eventCount + PROFILER_MAX_EVENTS) % PROFILER_MAX_EVENTS;
+    double origin = profiler.eventCount ? profiler.events[first].start : 0.0;
+    fprintf(f, "{\"traceEvents\":[\n");
+    for (int i = 0; i < profiler.eventCount; i++)
+    {
+        const ProfilerEvent *e = &profiler.events[(first + i) % PROFILER_MAX_EVENTS];
+        fprintf(f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}\n",
+                i ? "," : "", profiler.zoneNames[e->zone],
+                (e->start - origin) * 1e6, e->duration * 1e6);
+    }
+    fprintf(f, "],\"displayTimeUnit\":\"ms\"}\n");
+    bool ok = !ferror(f);
+    return fclose(f) == 0 && ok;
+}
+
+//----------------------------------------------------------------------------------
+// График: столбик на кадр, сегменты по зонам, остаток кадра серым
+//----------------------------------------------------------------------------------
+static Color ProfilerZoneColor(int zone)
+{
+    static const Color palette[] = {
+        {230, 41, 55, 255}, {0, 121, 241, 255}, {0, 228, 48, 255}, {253, 249, 0, 255},
+        {200, 122, 255, 255}, {255, 161, 0, 255}, {102, 191, 255, 255}, {255, 109, 194, 255}};
+    return palette[zone % (int)(sizeof(palette) / sizeof(palette[0]))];
+}
+
+static void ProfilerDrawGraph(Rectangle bounds)
+{
+    const float scaleMs = 33.3f; // высота графика — два кадра по 60 FPS
+    const float barWidth = bounds.width / PROFILER_HISTORY;
+    float base = bounds.y + bounds.height;
+
+    for (int i = 0; i < profiler.frameCount; i++)
+    {
+        int index = (profiler.frameHead - profiler.frameCount + i + PROFILER_HISTORY) % PROFILER_HISTORY;
+        const ProfilerFrame *frame = &profiler.frames[index];
+        float x = bounds.x + (PROFILER_HISTORY - profiler.frameCount + i) * barWidth;
+        float y = base;
+        for (int z = 0; z < profiler.zoneCount; z++)
+        {
+            float h = frame->selfMs[z] / scaleMs * bounds.height;
+            DrawRectangleRec(CLITERAL(Rectangle){x, y - h, barWidth, h}, ProfilerZoneColor(z));
+            y -= h;
+        }
+        float total = frame->frameMs / scaleMs * bounds.height;
+        if (total > bounds.height)
+            total = bounds.height;
+        if (base - total < y)
+            DrawRectangleRec(CLITERAL(Rectangle){x, base - total, barWidth, y - (base - total)},
+                             Fade(GRAY, 0.6f));
+    }
+    float target = base - 16.7f / scaleMs * bounds.height;
+    DrawLineV(CLITERAL(Vector2){bounds.x, target},
+              CLITERAL(Vector2){bounds.x + bounds.width, target}, Fade(WHITE, 0.7f));
+}
+
+void ProfilerOverlay(void)
+{
+    if (IsKeyPressed(KEY_F3))
+        profiler.visible = !profiler.visible;
+    if (IsKeyPressed(KEY_F4))
+        ProfilerDumpTrace("profile_trace.json");
+    if (!profiler.visible)
+        return;
+
+    Rectangle panel = {10, 10, 300, 110 + 14.0f * profiler.zoneCount};
+#if defined(RAYGUI_H)
+    GuiPanel(panel, "Profiler (F3, F4 - trace)");
+    Rectangle graph = {panel.x + 10, panel.y + 34, panel.width - 20, 60};
+#else
+    DrawRectangleRec(panel, Fade(BLACK, 0.75f));
+    DrawText("Profiler (F3, F4 - trace)", (int)panel.x + 10, (int)panel.y + 6, 10, WHITE);
+    Rectangle graph = {panel.x + 10, panel.y + 24, panel.width - 20, 60};
+#endif
+    ProfilerDrawGraph(graph);
+
+    float avgFrame = 0, maxFrame = 0;
+    float avgZone[PROFILER_MAX_ZONES] = {0};
+    for (int i = 0; i < profiler.frameCount; i++)
+    {
+        const ProfilerFrame *frame = &profiler.frames[i];
+        avgFrame += frame->frameMs;
+        if (frame->frameMs > maxFrame)
+            maxFrame = frame->frameMs;
+        for (int z = 0; z < profiler.zoneCount; z++)
+            avgZone[z] += frame->selfMs[z];
+    }
+    float n = profiler.frameCount ? (float)profiler.frameCount : 1.0f;
+    Color text = GetColor(0xDDDDDDFF);
+#if defined(RAYGUI_H)
+    text = GetColor(GuiGetStyle(DEFAULT, TEXT_COLOR_NORMAL));
+#endif
+    int y = (int)(graph.y + graph.height + 6);
+    DrawText(TextFormat("frame %.2f ms avg, %.2f ms max", avgFrame / n, maxFrame),
+             (int)graph.x, y, 10, text);
+    for (int z = 0; z < profiler.zoneCount; z++)
+    {
+        y += 14;
+        DrawRectangle((int)graph.x, y, 10, 10, ProfilerZoneColor(z));
+        DrawText(TextFormat("%-10s %.3f ms", profiler.zoneNames[z], avgZone[z] / n),
+                 (int)graph.x + 16, y, 10, text);
+    }
+}
+
+#endif // FRAME_PROFILER_IMPLEMENTATION
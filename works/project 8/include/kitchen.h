@@ -0,0 +1,331 @@
+// kitchen.h
+#pragma once
+
+#include "order.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Bounded lock-free queue for any number of producers and consumers
+// (Dmitry Vyukov's design): each cell carries a sequence number that
+// says whether it is free for the next push or holds a value to pop.
+template <typename T>
+class MpmcQueue {
+public:
+	explicit MpmcQueue(size_t capacity) {
+		size_t size = 2;
+		while (size < capacity) size *= 2;
+		cells.reset(new Cell[size]);
+		mask = size - 1;
+		for (size_t i = 0; i < size; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	
+	bool push(const T& value) {
+		size_t pos = tail.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;) {
+			cell = &cells[pos & mask];
+			size_t seq = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+			if (diff == 0) {
+				if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+			} else if (diff < 0) {
+				return false; // full
+			} else {
+				pos = tail.load(std::memory_order_relaxed);
+			}
+		}
+		cell->value = value;
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+	
+	bool pop(T& value) {
+		size_t pos = head.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;) {
+			cell = &cells[pos & mask];
+			size_t seq = cell->sequence.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+			if (diff == 0) {
+				if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+			} else if (diff < 0) {
+				return false; // empty
+			} else {
+				pos = head.load(std::memory_order_relaxed);
+			}
+		}
+		value = cell->value;
+		cell->sequence.store(pos + mask + 1, std::memory_order_release);
+		return true;
+	}
+	
+	size_t sizeApprox() const {
+		size_t h = head.load(std::memory_order_relaxed);
+		size_t t = tail.load(std::memory_order_relaxed);
+		return t > h ? t - h : 0;
+	}
+	
+private:
+	struct Cell {
+		std::atomic<size_t> sequence;
+		T value;
+	};
+	std::unique_ptr<Cell[]> cells;
+	size_t mask;
+	alignas(64) std::atomic<size_t> head{0};
+	alignas(64) std::atomic<size_t> tail{0};
+};
+
+struct StationConfig {
+	const char* name;
+	int capacity;          // orders served at the same time
+	double serviceSeconds;
+};
+
+struct KitchenConfig {
+	std::vector<StationConfig> stations = { {"Dough", 2, 0.4}, {"Oven", 4, 1.5}, {"Packing", 1, 0.2} };
+	int workers = 0;              // 0 - one per station slot
+	int ticketCapacity = 1 << 16; // orders in the kitchen at once
+	double timeScale = 1.0;       // multiplies service times; 0 - no waiting at all
+};
+
+struct StationStats {
+	const char* name;
+	int queued;
+	int busy;
+	int capacity;
+	uint64_t served;
+	double avgWaitMs; // in this station's queue
+	double maxWaitMs;
+};
+
+struct KitchenStats {
+	std::vector<StationStats> stations;
+	uint64_t submitted;
+	uint64_t ready;
+	uint64_t cancelled;
+	double ordersPerSecond; // ready orders since the kitchen opened
+	double avgLatencyMs;    // submit to ready
+};
+
+// Orders pass the stations in sequence. Each worker has a home station
+// and, when its queue is empty, steals from the others, latest station
+// first so that nearly done orders leave before new ones start.
+// Any thread may submit or cancel; the UI reads statuses by ticket.
+class Kitchen {
+public:
+	explicit Kitchen(const KitchenConfig& c = KitchenConfig())
+	: config(c), ticketMask(0), slots(nullptr) {
+		size_t capacity = 2;
+		while (capacity < (size_t)std::max(config.ticketCapacity, 2)) capacity *= 2;
+		ticketMask = capacity - 1;
+		slots.reset(new std::atomic<uint64_t>[capacity]);
+		previous.reset(new std::atomic<uint64_t>[capacity]);
+		for (size_t i = 0; i < capacity; i++) {
+			slots[i].store(0, std::memory_order_relaxed);
+			previous[i].store(0, std::memory_order_relaxed);
+		}
+		for (const auto& sc : config.stations) stations.emplace_back(new Station(sc, capacity));
+		
+		openedAt = clockNs();
+		int workerCount = config.workers;
+		if (workerCount <= 0)
+			for (const auto& sc : config.stations) workerCount += sc.capacity;
+		for (int w = 0; w < workerCount; w++) workers.emplace_back(&Kitchen::workerMain, this, w);
+	}
+	
+	~Kitchen() {
+		quit.store(true);
+		idle.notify_all();
+		for (auto& t : workers) t.join();
+	}
+	
+	Kitchen(const Kitchen&) = delete;
+	Kitchen& operator=(const Kitchen&) = delete;
+	
+	// Ticket for status() and cancel(), or 0 when the kitchen is full.
+	uint32_t submit() {
+		uint32_t ticket;
+		do ticket = nextTicket.fetch_add(1); while (ticket == 0);
+		auto& slot = slots[ticket & ticketMask];
+		uint64_t old = slot.load();
+		// the order that had this slot may still sit in a queue
+		if (old & SLOT_LIVE) return 0;
+		// kept before the slot changes hands, so status() never misses it
+		previous[ticket & ticketMask].store(old, std::memory_order_release);
+		if (!slot.compare_exchange_strong(old, slotValue(ticket, OrderStatus::PENDING) | SLOT_LIVE))
+			return 0;
+		int64_t now = clockNs();
+		stations[0]->queue.push({ticket, now, now}); // cannot fail: a queue has a cell per slot
+		submitted.fetch_add(1, std::memory_order_relaxed);
+		wake();
+		return ticket;
+	}
+	
+	// Only orders that are not ready yet can be cancelled.
+	bool cancel(uint32_t ticket) {
+		return advance(ticket, OrderStatus::PENDING, OrderStatus::CANCELLED) ||
+			advance(ticket, OrderStatus::PREPARING, OrderStatus::CANCELLED);
+	}
+	
+	// A ticket whose slot went to a newer order has left the kitchen and
+	// reads as it left, READY or CANCELLED. Only a ticket that is more
+	// than one lap of ticketCapacity behind is no longer known; it reads
+	// as READY.
+	OrderStatus status(uint32_t ticket) const {
+		uint64_t v = slots[ticket & ticketMask].load(std::memory_order_acquire);
+		if ((uint32_t)(v >> 32) == ticket) return (OrderStatus)(v & SLOT_STATUS);
+		v = previous[ticket & ticketMask].load(std::memory_order_acquire);
+		if ((uint32_t)(v >> 32) == ticket) return (OrderStatus)(v & SLOT_STATUS);
+		return OrderStatus::READY;
+	}
+	
+	KitchenStats stats() const {
+		KitchenStats ks;
+		for (const auto& st : stations) {
+			uint64_t served = st->served.load(std::memory_order_relaxed);
+			uint64_t waited = st->waitedCount.load(std::memory_order_relaxed);
+			ks.stations.push_back({st->config.name, (int)st->queue.sizeApprox(), std::min(st->busy.load(), st->config.capacity),
+				st->config.capacity, served, waited ? st->waitNs.load(std::memory_order_relaxed) / 1e6 / waited : 0.0,
+				st->maxWaitNs.load(std::memory_order_relaxed) / 1e6});
+		}
+		ks.submitted = submitted.load(std::memory_order_relaxed);
+		ks.ready = ready.load(std::memory_order_relaxed);
+		ks.cancelled = cancelled.load(std::memory_order_relaxed);
+		double seconds = (clockNs() - openedAt) / 1e9;
+		ks.ordersPerSecond = seconds > 0 ? ks.ready / seconds : 0.0;
+		ks.avgLatencyMs = ks.ready ? latencyNs.load(std::memory_order_relaxed) / 1e6 / ks.ready : 0.0;
+		return ks;
+	}
+	
+private:
+	struct Ticket {
+		uint32_t id;
+		int64_t submittedNs;
+		int64_t enqueuedNs;
+	};
+	
+	struct Station {
+		StationConfig config;
+		MpmcQueue<Ticket> queue;
+		std::atomic<int> busy{0};
+		std::atomic<uint64_t> served{0};
+		std::atomic<uint64_t> waitedCount{0};
+		std::atomic<int64_t> waitNs{0};
+		std::atomic<int64_t> maxWaitNs{0};
+		
+		Station(const StationConfig& c, size_t capacity) : config(c), queue(capacity) {}
+	};
+	
+	// A slot holds ticket << 32 | SLOT_LIVE | status. It stays live until
+	// the ticket leaves its last queue and only then may be reused; the
+	// retired value moves to previous.
+	static constexpr uint64_t SLOT_STATUS = 0x7f;
+	static constexpr uint64_t SLOT_LIVE = 0x80;
+	
+	KitchenConfig config;
+	size_t ticketMask;
+	std::unique_ptr<std::atomic<uint64_t>[]> slots;
+	std::unique_ptr<std::atomic<uint64_t>[]> previous; // last ticket of each slot, in its final status
+	std::vector<std::unique_ptr<Station>> stations;
+	std::vector<std::thread> workers;
+	
+	std::atomic<uint32_t> nextTicket{1};
+	std::atomic<uint64_t> submitted{0};
+	std::atomic<uint64_t> ready{0};
+	std::atomic<uint64_t> cancelled{0};
+	std::atomic<int64_t> latencyNs{0};
+	int64_t openedAt;
+	
+	std::atomic<bool> quit{false};
+	std::mutex idleLock;
+	std::condition_variable idle;
+	
+	static int64_t clockNs() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	
+	void wake() { idle.notify_one(); }
+	
+	static uint64_t slotValue(uint32_t ticket, OrderStatus status) { return (uint64_t)ticket << 32 | (uint64_t)status; }
+	
+	bool advance(uint32_t ticket, OrderStatus from, OrderStatus to) {
+		uint64_t expected = slotValue(ticket, from) | SLOT_LIVE;
+		return slots[ticket & ticketMask].compare_exchange_strong(expected, slotValue(ticket, to) | SLOT_LIVE);
+	}
+	
+	void retire(bool wasCancelled, const Ticket& t) {
+		slots[t.id & ticketMask].fetch_and(~SLOT_LIVE);
+		if (wasCancelled) {
+			cancelled.fetch_add(1, std::memory_order_relaxed);
+		} else {
+			latencyNs.fetch_add(clockNs() - t.submittedNs, std::memory_order_relaxed);
+			ready.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	
+	bool serve(int index) {
+		Station& st = *stations[index];
+		if (st.busy.fetch_add(1) >= st.config.capacity) {
+			st.busy.fetch_sub(1);
+			return false;
+		}
+		Ticket t;
+		if (!st.queue.pop(t)) {
+			st.busy.fetch_sub(1);
+			return false;
+		}
+		
+		if (index == 0) advance(t.id, OrderStatus::PENDING, OrderStatus::PREPARING);
+		if (status(t.id) == OrderStatus::CANCELLED) {
+			st.busy.fetch_sub(1);
+			retire(true, t);
+			return true;
+		}
+		
+		int64_t wait = clockNs() - t.enqueuedNs;
+		st.waitNs.fetch_add(wait, std::memory_order_relaxed);
+		st.waitedCount.fetch_add(1, std::memory_order_relaxed);
+		int64_t max = st.maxWaitNs.load(std::memory_order_relaxed);
+		while (wait > max && !st.maxWaitNs.compare_exchange_weak(max, wait, std::memory_order_relaxed)) {}
+		
+		double service = st.config.serviceSeconds * config.timeScale;
+		if (service > 0) std::this_thread::sleep_for(std::chrono::duration<double>(service));
+		st.served.fetch_add(1, std::memory_order_relaxed);
+		st.busy.fetch_sub(1);
+		
+		if (index + 1 < (int)stations.size()) {
+			t.enqueuedNs = clockNs();
+			stations[index + 1]->queue.push(t);
+			wake();
+		} else {
+			retire(!advance(t.id, OrderStatus::PREPARING, OrderStatus::READY), t);
+		}
+		return true;
+	}
+	
+	void workerMain(int worker) {
+		int n = (int)stations.size();
+		if (n == 0) return;
+		int home = worker % n;
+		std::vector<int> order = { home };
+		for (int s = n - 1; s >= 0; s--)
+			if (s != home) order.push_back(s);
+		
+		while (!quit.load(std::memory_order_relaxed)) {
+			bool worked = false;
+			for (int s : order)
+				if ((worked = serve(s))) break;
+			if (!worked) {
+				// pushes do not take the lock, so a wakeup can be missed; the timeout covers it
+				std::unique_lock<std::mutex> lock(idleLock);
+				idle.wait_for(lock, std::chrono::milliseconds(2));
+			}
+		}
+	}
+};
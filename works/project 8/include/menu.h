@@ -0,0 +1,363 @@
+// menu.h
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+struct Topping {
+	std::string name;
+	double price;
+	bool offered = true; // false - kept only so that older orders still show it
+};
+
+class MenuItem {
+protected:
+	std::string name;
+	double basePrice;
+	
+public:
+	MenuItem(const std::string& n, double p) : name(n), basePrice(p) {}
+	virtual ~MenuItem() = default;
+	
+	const std::string& getName() const { return name; }
+	double getBasePrice() const { return basePrice; }
+	
+	virtual double calculatePrice() const = 0;
+	virtual void display() const = 0;
+};
+
+enum class PizzaSize : uint8_t { SMALL, MEDIUM, LARGE };
+enum class BaseType : uint8_t { THIN, TRADITIONAL, THICK };
+
+class Pizza : public MenuItem {
+private:
+	PizzaSize size;
+	BaseType baseType;
+	std::vector<Topping> toppings;
+	
+public:
+	Pizza(const std::string& n, double p)
+	: MenuItem(n, p), size(PizzaSize::MEDIUM), baseType(BaseType::THIN) {}
+	
+	void setSize(PizzaSize s) { size = s; }
+	void setBaseType(BaseType bt) { baseType = bt; }
+	void addTopping(const Topping& t) { toppings.push_back(t); }
+	void removeTopping(const std::string& toppingName) {
+		toppings.erase(std::remove_if(toppings.begin(), toppings.end(),
+			[&](const Topping& t){ return t.name == toppingName; }), toppings.end());
+	}
+	
+	double calculatePrice() const override {
+		double price = basePrice;
+		switch (size) {
+			case PizzaSize::SMALL: price *= 1.0; break;
+			case PizzaSize::MEDIUM: price *= 1.2; break;
+			case PizzaSize::LARGE: price *= 1.5; break;
+		}
+		for (const auto& t : toppings) price += t.price;
+		return price;
+	}
+	
+	void display() const override {
+		std::cout << "Pizza: " << name << ", Size: ";
+		switch(size) {
+			case PizzaSize::SMALL: std::cout << "Small"; break;
+			case PizzaSize::MEDIUM: std::cout << "Medium"; break;
+			case PizzaSize::LARGE: std::cout << "Large"; break;
+		}
+		std::cout << ", Base: ";
+		switch(baseType) {
+			case BaseType::THIN: std::cout << "Thin"; break;
+			case BaseType::TRADITIONAL: std::cout << "Traditional"; break;
+			case BaseType::THICK: std::cout << "Thick"; break;
+		}
+		std::cout << ", Toppings: ";
+		for (const auto& t : toppings) std::cout << t.name << " ";
+		std::cout << ", Price: $" << calculatePrice() << std::endl;
+	}
+	
+	PizzaSize getSize() const { return size; }
+	BaseType getBaseType() const { return baseType; }
+	const std::vector<Topping>& getToppings() const { return toppings; }
+};
+
+class Drink : public MenuItem {
+private:
+	double volume;
+	bool isCarbonated;
+public:
+	Drink(const std::string& n, double p, double v, bool c)
+	: MenuItem(n, p), volume(v), isCarbonated(c) {}
+	
+	double calculatePrice() const override { return basePrice; }
+	void display() const override {
+		std::cout << "Drink: " << name << ", Volume: " << volume << "L"
+		<< (isCarbonated ? ", Carbonated" : ", Non-carbonated")
+		<< ", Price: $" << basePrice << std::endl;
+	}
+};
+
+class SideDish : public MenuItem {
+private:
+	std::string portionSize;
+public:
+	SideDish(const std::string& n, double p, const std::string& portion)
+	: MenuItem(n, p), portionSize(portion) {}
+	
+	double calculatePrice() const override { return basePrice; }
+	void display() const override {
+		std::cout << "SideDish: " << name << ", Portion: " << portionSize
+		<< ", Price: $" << basePrice << std::endl;
+	}
+};
+
+// Orders never copy menu objects: a line refers to the menu by ID
+// and keeps the chosen toppings as bits, so the Menu stays the only
+// owner of names and prices.
+using ItemId = uint16_t;   // index in Menu::items
+using ToppingId = uint8_t; // index in Menu::availableToppings
+
+enum class ItemCategory : uint8_t { PIZZA, DRINK, SIDE };
+
+// Order arithmetic is done in whole cents, so totals kept up to date
+// by adding and subtracting lines never drift.
+using Cents = int64_t;
+
+// Pizza size multipliers in percent, indexed by PizzaSize.
+constexpr int SIZE_PERCENT[] = { 100, 120, 150 };
+constexpr int SIZE_COUNT = sizeof(SIZE_PERCENT) / sizeof(SIZE_PERCENT[0]);
+
+inline Cents toCents(double price) { return (Cents)std::llround(price * 100.0); }
+
+inline std::string formatCents(Cents c) {
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%s%lld.%02lld", c < 0 ? "-" : "", (long long)std::llabs(c) / 100, (long long)std::llabs(c) % 100);
+	return buf;
+}
+
+inline int lowestBit(uint32_t bits) {
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, bits);
+	return (int)index;
+#else
+	return __builtin_ctz(bits);
+#endif
+}
+
+// Open addressing with linear probing, kept at most half full. Keys are
+// 64-bit hashes; find() asks the caller to confirm a hit, so colliding
+// hashes only cost an extra probe.
+class HashIndex {
+public:
+	void reset(size_t count) {
+		size_t size = 8;
+		while (size < count * 2) size *= 2;
+		slots.assign(size, Slot{});
+		mask = size - 1;
+	}
+	void insert(uint64_t key, uint32_t value) {
+		for (size_t i = key & mask;; i = (i + 1) & mask) {
+			if (!slots[i].used) {
+				slots[i] = {key, value, true};
+				return;
+			}
+		}
+	}
+	template <typename Match>
+	int find(uint64_t key, Match match) const {
+		for (size_t i = key & mask;; i = (i + 1) & mask) {
+			const Slot& s = slots[i];
+			if (!s.used) return -1;
+			if (s.key == key && match(s.value)) return (int)s.value;
+		}
+	}
+	
+private:
+	struct Slot {
+		uint64_t key = 0;
+		uint32_t value = 0;
+		bool used = false;
+	};
+	std::vector<Slot> slots = std::vector<Slot>(8);
+	size_t mask = 7;
+};
+
+// FNV-1a with a final mix, so that the low bits used for slots spread well.
+inline uint64_t hashName(std::string_view name) {
+	uint64_t h = 1469598103934665603ull;
+	for (unsigned char c : name) h = (h ^ c) * 1099511628211ull;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	return h ^ (h >> 33);
+}
+
+struct ToppingSet {
+	static constexpr int CAPACITY = 32;
+	uint32_t bits = 0;
+	
+	bool has(ToppingId t) const { return (bits >> t) & 1u; }
+	void add(ToppingId t) { bits |= 1u << t; }
+	void remove(ToppingId t) { bits &= ~(1u << t); }
+	bool empty() const { return bits == 0; }
+};
+
+// One catalog snapshot. Menus loaded from a file (see menu_catalog.h)
+// take their item IDs and topping bits from it, so that IDs kept in
+// orders and in the journal mean the same item in the next snapshot;
+// the built-in menu numbers its items in list order.
+class Menu {
+public:
+	std::vector<Pizza> availablePizzas;
+	std::vector<Drink> availableDrinks;
+	std::vector<SideDish> availableSides;
+	std::vector<Topping> availableToppings; // indexed by ToppingId
+	
+	Menu() : Menu(true) {}
+	
+	// false - an empty menu for MenuCatalog to fill
+	explicit Menu(bool builtIn) {
+		if (!builtIn) return;
+		availablePizzas.emplace_back("Margherita", 5.0);
+		availablePizzas.emplace_back("Pepperoni", 6.5);
+		availablePizzas.emplace_back("Hawaiian", 7.0);
+		
+		availableDrinks.emplace_back("Coca-Cola", 1.5, 0.5, true);
+		availableDrinks.emplace_back("Water", 1.0, 0.5, false);
+		
+		availableSides.emplace_back("French Fries", 2.0, "Medium");
+		availableSides.emplace_back("Salad", 2.5, "Small");
+		
+		availableToppings.push_back({"Cheese", 0.5});
+		availableToppings.push_back({"Mushrooms", 0.7});
+		availableToppings.push_back({"Olives", 0.6});
+		availableToppings.push_back({"Peppers", 0.4});
+		
+		buildIndex();
+	}
+	
+	Menu(const Menu&) = delete;
+	Menu& operator=(const Menu&) = delete;
+	
+	// The item lists must not change after this: items points into them.
+	void buildIndex() {
+		if (availableToppings.size() > ToppingSet::CAPACITY)
+			availableToppings.resize(ToppingSet::CAPACITY);
+		auto numbered = [](std::vector<ItemId>& ids, size_t count, size_t first) {
+			if (ids.size() == count) return;
+			ids.resize(count);
+			for (size_t i = 0; i < count; i++) ids[i] = (ItemId)(first + i);
+		};
+		numbered(pizzaIds, availablePizzas.size(), 0);
+		numbered(drinkIds, availableDrinks.size(), availablePizzas.size());
+		numbered(sideIds, availableSides.size(), availablePizzas.size() + availableDrinks.size());
+		
+		size_t count = 0;
+		for (const auto* ids : { &pizzaIds, &drinkIds, &sideIds, &unlistedIds })
+			for (ItemId id : *ids) count = std::max(count, (size_t)id + 1);
+		items.assign(count, &gap);
+		categories.assign(count, ItemCategory::SIDE);
+		listed.assign(count, false);
+		auto place = [&](auto& list, const std::vector<ItemId>& ids, ItemCategory c) {
+			for (size_t i = 0; i < list.size(); i++) {
+				items[ids[i]] = &list[i];
+				categories[ids[i]] = c;
+				listed[ids[i]] = true;
+			}
+		};
+		place(availablePizzas, pizzaIds, ItemCategory::PIZZA);
+		place(availableDrinks, drinkIds, ItemCategory::DRINK);
+		place(availableSides, sideIds, ItemCategory::SIDE);
+		for (size_t i = 0; i < unlisted.size(); i++) {
+			items[unlistedIds[i]] = &unlisted[i];
+			categories[unlistedIds[i]] = unlistedCategories[i];
+		}
+		
+		names.reset(count);
+		for (size_t id = 0; id < count; id++)
+			if (listed[id]) names.insert(hashName(items[id]->getName()), (uint32_t)id);
+		toppingNames.reset(availableToppings.size());
+		offeredToppings = 0;
+		for (size_t t = 0; t < availableToppings.size(); t++) {
+			if (!availableToppings[t].offered) continue;
+			toppingNames.insert(hashName(availableToppings[t].name), (uint32_t)t);
+			offeredToppings |= 1u << t;
+		}
+		updatePrices();
+	}
+	
+	ItemId pizzaId(int i) const { return pizzaIds[i]; }
+	ItemId drinkId(int i) const { return drinkIds[i]; }
+	ItemId sideId(int i) const { return sideIds[i]; }
+	
+	ItemCategory category(ItemId id) const { return categories[id]; }
+	
+	// IDs run up to itemCount() but may have gaps; only these can be ordered.
+	size_t itemCount() const { return items.size(); }
+	bool offered(ItemId id) const { return id < listed.size() && listed[id]; }
+	// offered or kept for older orders
+	bool known(ItemId id) const { return id < items.size() && items[id] != &gap; }
+	bool offered(ToppingSet toppings) const { return (toppings.bits & ~offeredToppings) == 0; }
+	
+	// Offered item ID or topping bit by exact name, -1 if there is none.
+	int findItem(std::string_view itemName) const {
+		return names.find(hashName(itemName), [&](uint32_t id) { return items[id]->getName() == itemName; });
+	}
+	int findTopping(std::string_view toppingName) const {
+		return toppingNames.find(hashName(toppingName), [&](uint32_t t) { return availableToppings[t].name == toppingName; });
+	}
+	const MenuItem& item(ItemId id) const { return *items[id]; }
+	const std::string& name(ItemId id) const { return items[id]->getName(); }
+	const Topping& topping(ToppingId t) const { return availableToppings[t]; }
+	
+	// Two table lookups plus one add per topping, no virtual calls.
+	Cents linePrice(ItemId item, PizzaSize size, ToppingSet toppings) const {
+		Cents price = sizedCents[item * SIZE_COUNT + (int)size];
+		for (uint32_t bits = toppings.bits; bits; bits &= bits - 1)
+			price += toppingCents[lowestBit(bits)];
+		return price;
+	}
+	
+private:
+	friend class MenuCatalog;
+	
+	// by position in availablePizzas / Drinks / Sides
+	std::vector<ItemId> pizzaIds;
+	std::vector<ItemId> drinkIds;
+	std::vector<ItemId> sideIds;
+	// items no longer offered, kept so that older orders still show them
+	std::vector<SideDish> unlisted;
+	std::vector<ItemId> unlistedIds;
+	std::vector<ItemCategory> unlistedCategories;
+	SideDish gap{"(unknown item)", 0.0, ""}; // stands in for unused IDs
+	
+	std::vector<MenuItem*> items; // by ItemId
+	std::vector<ItemCategory> categories;
+	std::vector<bool> listed;
+	HashIndex names;
+	HashIndex toppingNames;
+	uint32_t offeredToppings = 0;
+	std::vector<Cents> sizedCents; // SIZE_COUNT prices per item, the same for non-pizzas
+	Cents toppingCents[ToppingSet::CAPACITY] = {};
+	
+	void updatePrices() {
+		sizedCents.resize(items.size() * SIZE_COUNT);
+		for (size_t id = 0; id < items.size(); id++) {
+			Cents base = toCents(items[id]->getBasePrice());
+			bool sized = category((ItemId)id) == ItemCategory::PIZZA;
+			for (int s = 0; s < SIZE_COUNT; s++)
+				sizedCents[id * SIZE_COUNT + s] = sized ? (base * SIZE_PERCENT[s] + 50) / 100 : base;
+		}
+		for (size_t t = 0; t < availableToppings.size(); t++)
+			toppingCents[t] = toCents(availableToppings[t].price);
+	}
+};
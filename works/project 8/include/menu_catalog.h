@@ -0,0 +1,42 @@
+// menu_catalog.h
+#pragma once
+
+#include "menu.h"
+#include <atomic>
+#include <memory>
+#include <string>
+
+// The live menu, loaded from a text file and swapped whole (RCU style):
+// readers take current() once per operation and keep using that
+// snapshot while a reload publishes the next one, which is never changed
+// after publishing. The last reader of an old snapshot frees it.
+//
+// File format, one entry per line, fields separated by '|':
+//   pizza   | id  | name | price
+//   drink   | id  | name | price | litres | carbonated or still
+//   side    | id  | name | price | portion
+//   topping | bit | name | price
+// A trailing "| off" keeps an entry for older orders without offering
+// it. '#' starts a comment. IDs are the ones orders and the journal
+// store, so an item keeps its ID for good; topping bits are 0..31.
+
+class MenuCatalog {
+public:
+	MenuCatalog() : snapshot(std::make_shared<const Menu>()) {}
+
+	std::shared_ptr<const Menu> current() const { return std::atomic_load(&snapshot); }
+	uint64_t version() const { return published.load(std::memory_order_acquire); }
+	void publish(std::shared_ptr<const Menu> menu);
+
+	// Parses path and publishes it; on failure the current menu stays.
+	bool load(const std::string& path, std::string& error);
+	// load() when the file changed since the last load through here.
+	bool reloadIfChanged(const std::string& path, std::string& error);
+
+	static std::shared_ptr<Menu> parse(const std::string& text, std::string& error);
+
+private:
+	std::shared_ptr<const Menu> snapshot;
+	std::atomic<uint64_t> published{1};
+	int64_t loadedStamp = -1;
+};
@@ -0,0 +1,207 @@
+// order.h
+#pragma once
+
+#include "menu.h"
+#include <memory>
+
+struct OrderLine {
+	ToppingSet toppings;
+	int32_t priceCents; // as charged when the line was (re)priced
+	ItemId item;
+	PizzaSize size;
+	BaseType baseType;
+};
+
+// Bump allocator for the lines of big orders. Blocks are only released
+// all at once by reset(), so an order that grows simply abandons its
+// old span. Most orders never get here (see Order::INLINE_LINES).
+class OrderArena {
+public:
+	explicit OrderArena(size_t lines = 4096) : blockLines(lines) {}
+	
+	OrderLine* allocate(size_t count) {
+		if (blocks.empty() || used + count > blockSizes.back()) {
+			size_t size = std::max(blockLines, count);
+			blocks.emplace_back(new OrderLine[size]);
+			blockSizes.push_back(size);
+			used = 0;
+		}
+		OrderLine* span = blocks.back().get() + used;
+		used += count;
+		return span;
+	}
+	
+	// Every order that spilled into the arena becomes invalid.
+	void reset() {
+		blocks.clear();
+		blockSizes.clear();
+		used = 0;
+	}
+	
+private:
+	size_t blockLines;
+	std::vector<std::unique_ptr<OrderLine[]>> blocks;
+	std::vector<size_t> blockSizes;
+	size_t used = 0;
+};
+
+enum class OrderType { DINE_IN, TAKEAWAY, DELIVERY };
+enum class OrderStatus { PENDING, PREPARING, READY, DELIVERED, CANCELLED };
+
+// Lines live in one contiguous span: first inside the order itself,
+// then in the arena once there are more than INLINE_LINES of them.
+// Orders can be moved but not copied, because the arena span is not owned.
+class Order {
+public:
+	static constexpr int INLINE_LINES = 8;
+	
+	int orderId;
+	std::string customerName;
+	OrderType orderType;
+	std::string deliveryAddress;
+	Cents deliveryFee = 0;
+	OrderStatus status = OrderStatus::PENDING;
+	uint32_t kitchenTicket = 0; // 0 - not sent to the kitchen
+	
+	explicit Order(int id, OrderArena* owner = nullptr)
+	: orderId(id), orderType(OrderType::DINE_IN), arena(owner) {}
+	
+	Order(const Order&) = delete;
+	Order& operator=(const Order&) = delete;
+	Order(Order&& other) noexcept { *this = std::move(other); }
+	Order& operator=(Order&& other) noexcept {
+		if (this == &other) return *this;
+		orderId = other.orderId;
+		customerName = std::move(other.customerName);
+		orderType = other.orderType;
+		deliveryAddress = std::move(other.deliveryAddress);
+		deliveryFee = other.deliveryFee;
+		status = other.status;
+		kitchenTicket = other.kitchenTicket;
+		itemsCents = other.itemsCents;
+		arena = other.arena;
+		spilled = other.spilled;
+		count = other.count;
+		capacity = other.capacity;
+		if (!spilled) std::copy(other.inlineLines, other.inlineLines + count, inlineLines);
+		other.spilled = nullptr;
+		other.count = 0;
+		other.capacity = INLINE_LINES;
+		other.itemsCents = 0;
+		return *this;
+	}
+	
+	// Without an arena the order holds at most INLINE_LINES lines.
+	// The total follows every change, so nothing needs recalculating.
+	bool addPizza(const Menu& menu, ItemId pizza, PizzaSize size, BaseType base, ToppingSet toppings) {
+		return addLine({toppings, (int32_t)menu.linePrice(pizza, size, toppings), pizza, size, base});
+	}
+	bool addItem(const Menu& menu, ItemId item) {
+		return addLine({ToppingSet{}, (int32_t)menu.linePrice(item, PizzaSize::MEDIUM, ToppingSet{}), item, PizzaSize::MEDIUM, BaseType::THIN});
+	}
+	
+	void removeLine(int index) {
+		OrderLine* l = lines();
+		itemsCents -= l[index].priceCents;
+		std::copy(l + index + 1, l + count, l + index);
+		count--;
+	}
+	
+	// A line exactly as it was charged, e.g. read back from the journal.
+	bool restoreLine(const OrderLine& l) { return addLine(l); }
+	// The same order with its lines copied into owner, so the arena holding
+	// the old span can be reset; the strings are moved out of this one.
+	Order relocate(OrderArena* owner) {
+		Order copy(orderId, owner);
+		copy.customerName = std::move(customerName);
+		copy.orderType = orderType;
+		copy.deliveryAddress = std::move(deliveryAddress);
+		copy.deliveryFee = deliveryFee;
+		copy.status = status;
+		copy.kitchenTicket = kitchenTicket;
+		for (const auto& l : *this) copy.restoreLine(l);
+		return copy;
+	}
+	// A line's price as it was repriced, read back from the journal.
+	void restorePrice(int index, int32_t priceCents) {
+		OrderLine& l = lines()[index];
+		itemsCents += priceCents - l.priceCents;
+		l.priceCents = priceCents;
+	}
+	
+	void setToppings(const Menu& menu, int index, ToppingSet toppings) {
+		OrderLine& l = lines()[index];
+		itemsCents -= l.priceCents;
+		l.toppings = toppings;
+		l.priceCents = (int32_t)menu.linePrice(l.item, l.size, toppings);
+		itemsCents += l.priceCents;
+	}
+	
+	const OrderLine* begin() const { return spilled ? spilled : inlineLines; }
+	const OrderLine* end() const { return begin() + count; }
+	int lineCount() const { return count; }
+	bool empty() const { return count == 0; }
+	
+	Cents total() const { return itemsCents + (orderType == OrderType::DELIVERY ? deliveryFee : 0); }
+	
+	// After a menu price change: one sequential pass over the orders,
+	// touching only their lines and totals.
+	static void repriceAll(const Menu& menu, Order* orders, size_t orderCount) {
+		for (size_t i = 0; i < orderCount; i++) {
+			Order& o = orders[i];
+			OrderLine* l = o.lines();
+			Cents sum = 0;
+			for (int k = 0; k < o.count; k++) {
+				l[k].priceCents = (int32_t)menu.linePrice(l[k].item, l[k].size, l[k].toppings);
+				sum += l[k].priceCents;
+			}
+			o.itemsCents = sum;
+		}
+	}
+	
+	void displayOrder(const Menu& menu) const {
+		static const char* headers[] = { "Pizzas:", "Drinks:", "Sides:" };
+		std::cout << "Order #" << orderId << " for " << customerName << std::endl;
+		for (int c = 0; c < 3; c++) {
+			std::cout << headers[c] << "\n";
+			for (const auto& l : *this)
+				if ((int)menu.category(l.item) == c) displayLine(menu, l);
+		}
+		std::cout << "Total: $" << formatCents(total()) << std::endl;
+	}
+	
+private:
+	OrderArena* arena = nullptr;
+	OrderLine* spilled = nullptr;
+	Cents itemsCents = 0;
+	int count = 0;
+	int capacity = INLINE_LINES;
+	OrderLine inlineLines[INLINE_LINES];
+	
+	OrderLine* lines() { return spilled ? spilled : inlineLines; }
+	
+	bool addLine(const OrderLine& l) {
+		if (count == capacity) {
+			if (!arena) return false;
+			OrderLine* grown = arena->allocate(capacity * 2);
+			std::copy(begin(), end(), grown);
+			spilled = grown;
+			capacity *= 2;
+		}
+		lines()[count++] = l;
+		itemsCents += l.priceCents;
+		return true;
+	}
+	
+	static void displayLine(const Menu& menu, const OrderLine& l) {
+		std::cout << "  " << menu.name(l.item);
+		if (menu.category(l.item) == ItemCategory::PIZZA) {
+			static const char* sizes[] = { "Small", "Medium", "Large" };
+			static const char* bases[] = { "Thin", "Traditional", "Thick" };
+			std::cout << ", Size: " << sizes[(int)l.size] << ", Base: " << bases[(int)l.baseType] << ", Toppings: ";
+			for (int t = 0; t < (int)menu.availableToppings.size(); t++)
+				if (l.toppings.has((ToppingId)t)) std::cout << menu.topping((ToppingId)t).name << " ";
+		}
+		std::cout << ", Price: $" << formatCents(l.priceCents) << std::endl;
+	}
+};
@@ -0,0 +1,52 @@
+// order_client.h
+#pragma once
+
+#include "order_protocol.h"
+#include <string>
+#include <vector>
+
+// Blocking till connection to an OrderServer. Requests are queued and go
+// out together on flush(); receive() then returns their responses one by
+// one in the same order. orderId 0 refers to the order this connection
+// created last.
+//
+//   client.newOrder(OrderType::TAKEAWAY, "Anna");
+//   client.addPizza(0, margherita, PizzaSize::LARGE, BaseType::THIN, ToppingSet{});
+//   client.send(0);
+//   client.flush();
+//   for (int i = 0; i < 3; i++) client.receive(r);
+//
+// POSIX sockets; elsewhere connecting fails.
+
+class OrderClient {
+public:
+	OrderClient() = default;
+	~OrderClient() { close(); }
+	OrderClient(const OrderClient&) = delete;
+	OrderClient& operator=(const OrderClient&) = delete;
+
+	bool connectTcp(const std::string& host, uint16_t port);
+	bool connectUnix(const std::string& path);
+	void close();
+	bool isOpen() const { return fd >= 0; }
+
+	void newOrder(OrderType type, const std::string& customer, const std::string& address = std::string());
+	void addPizza(int32_t orderId, ItemId pizza, PizzaSize size, BaseType base, ToppingSet toppings);
+	void addItem(int32_t orderId, ItemId item);
+	void removeLine(int32_t orderId, int32_t index);
+	void send(int32_t orderId);
+	void status(int32_t orderId);
+
+	// Writes every queued request; false if the connection is gone.
+	bool flush();
+	// Next response, waiting for it if needed.
+	bool receive(Response& r);
+
+private:
+	int fd = -1;
+	std::vector<uint8_t> out;
+	std::vector<uint8_t> in;
+	size_t inUsed = 0;
+
+	void line(int32_t orderId, ItemId item, PizzaSize size, BaseType base, ToppingSet toppings);
+};
@@ -0,0 +1,89 @@
+// order_journal.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Append-only file of checksummed records, written by a background thread.
+//
+// File layout (little-endian):
+//   "PZJ1" u32 version
+//   records: u32 size, u32 crc32(payload), payload[size]
+//
+// append() only copies the record into memory. The flusher thread writes
+// everything gathered since its last pass with one write and one fsync
+// (group commit), so a burst of events costs a single disk sync.
+// waitDurable() blocks until a given record is on disk.
+//
+// open() maps the existing file, hands every intact record to the
+// callback and cuts off a torn tail left by a crash. compact() replaces
+// the whole file with a snapshot, which bounds the next recovery. A
+// compaction that fails leaves the old file and every appended record
+// in place, so nothing is lost but the chance to shrink the file.
+// writeFailed() turns true once a record could not be written; records
+// appended since then may not reach the disk.
+//
+// The payload format belongs to the caller.
+
+struct JournalOptions {
+	int flushIntervalMs = 5;      // longest time a record waits in memory
+	size_t flushBytes = 1 << 20;  // flush early once this much is pending
+	bool sync = true;             // false - write without fsync (benchmarks)
+};
+
+class OrderJournal {
+public:
+	using RecordCallback = void (*)(const uint8_t* payload, uint32_t size, void* user);
+
+	OrderJournal() = default;
+	~OrderJournal() { close(); }
+	OrderJournal(const OrderJournal&) = delete;
+	OrderJournal& operator=(const OrderJournal&) = delete;
+
+	// Replays path through onRecord (may be null) and opens it for appending.
+	// The file stays locked while open: false if another journal has it.
+	bool open(const std::string& path, RecordCallback onRecord, void* user, const JournalOptions& options = JournalOptions());
+	// Writes what is pending and stops the flusher.
+	void close();
+	bool isOpen() const { return file >= 0; }
+
+	// Sequence number of the record, for waitDurable().
+	uint64_t append(const void* payload, uint32_t size);
+	void waitDurable(uint64_t sequence);
+
+	// records: framed with frame(). They must describe the state after
+	// every record appended so far, which is dropped with the old file
+	// once the snapshot has replaced it. false - the old file stays.
+	bool compact(const std::vector<uint8_t>& records);
+	bool writeFailed() const { return failed; }
+
+	static void frame(std::vector<uint8_t>& out, const void* payload, uint32_t size);
+	static uint32_t crc32(const uint8_t* data, size_t size);
+
+	uint64_t fileBytes() const { return bytesOnDisk; }
+
+private:
+	std::string path;
+	JournalOptions options;
+	intptr_t file = -1; // fd or HANDLE
+	uint64_t bytesOnDisk = 0;
+
+	std::mutex lock;
+	std::condition_variable wake;    // records pending or closing
+	std::condition_variable durable; // durableSequence moved
+	std::vector<uint8_t> pending;
+	uint64_t appendedSequence = 0;
+	uint64_t durableSequence = 0;
+	bool quit = false;
+	std::atomic<bool> failed{false};
+	std::mutex fileLock; // held by the flusher from taking pending until written, and by compact
+	std::thread flusher;
+
+	void flusherMain();
+};
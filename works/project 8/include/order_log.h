@@ -0,0 +1,288 @@
+// order_log.h
+#pragma once
+
+#include "order.h"
+#include "order_journal.h"
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+
+enum class OrderEvent : uint8_t { CREATE = 1, ADD_LINE, REMOVE_LINE, STATUS, DELIVERY, REPRICE, NEXT_ID };
+
+// Journal payloads, field by field in host order (little-endian on all our targets).
+struct RecordWriter {
+	static constexpr size_t MAX_STRING = 100;
+	uint8_t data[256];
+	uint32_t size = 0;
+	
+	template <typename T> void put(T v) { memcpy(data + size, &v, sizeof(v)); size += sizeof(v); }
+	void putString(const std::string& s) {
+		uint16_t n = (uint16_t)std::min(s.size(), MAX_STRING);
+		put(n);
+		memcpy(data + size, s.data(), n);
+		size += n;
+	}
+};
+
+struct RecordReader {
+	const uint8_t* p;
+	const uint8_t* end;
+	bool ok = true;
+	
+	template <typename T> T get() {
+		T v{};
+		if (end - p < (ptrdiff_t)sizeof(v)) { ok = false; return v; }
+		memcpy(&v, p, sizeof(v));
+		p += sizeof(v);
+		return v;
+	}
+	std::string getString() {
+		uint16_t n = get<uint16_t>();
+		if (end - p < n) { ok = false; return std::string(); }
+		std::string s((const char*)p, n);
+		p += n;
+		return s;
+	}
+};
+
+// Turns order changes into journal records and journal records back into
+// orders. Only orders that were sent to the kitchen and are not delivered
+// or cancelled yet are recovered; the draft being edited at the time of a
+// crash is dropped.
+class OrderLog {
+public:
+	static constexpr uint64_t SNAPSHOT_EVENTS = 1000000;
+	
+	// Rebuilds orders from path and keeps appending to it; false leaves the log disabled.
+	bool open(const std::string& path, const Menu& menu, OrderArena& arena, std::vector<Order>& orders, int& nextOrderId,
+		const JournalOptions& options = JournalOptions()) {
+		Recovery r{menu, arena};
+		bool ok = journal.open(path, &Recovery::apply, &r, options);
+		for (size_t i = 0; i < r.orders.size(); i++)
+			if (r.sent[i] && !closed(r.orders[i].status)) orders.push_back(std::move(r.orders[i]));
+		nextOrderId = std::max(nextOrderId, r.maxOrderId + 1);
+		eventsSinceSnapshot = r.events;
+		return ok;
+	}
+	
+	void created(const Order& o) { RecordWriter w; encodeCreate(w, o); append(w); }
+	void lineAdded(const Order& o) { RecordWriter w; encodeLine(w, o.orderId, *(o.end() - 1)); append(w); }
+	void lineRemoved(const Order& o, int index) {
+		RecordWriter w;
+		w.put(OrderEvent::REMOVE_LINE);
+		w.put((int32_t)o.orderId);
+		w.put((int32_t)index);
+		append(w);
+	}
+	void statusChanged(const Order& o) { RecordWriter w; encodeStatus(w, o); append(w); }
+	// after Order::repriceAll, one record per line
+	void repriced(const Order& o) {
+		int index = 0;
+		for (const auto& l : o) {
+			RecordWriter w;
+			w.put(OrderEvent::REPRICE);
+			w.put((int32_t)o.orderId);
+			w.put((int32_t)index++);
+			w.put(l.priceCents);
+			append(w);
+		}
+	}
+	// order type, address or fee
+	void deliveryChanged(const Order& o) {
+		RecordWriter w;
+		w.put(OrderEvent::DELIVERY);
+		w.put((int32_t)o.orderId);
+		w.put((uint8_t)o.orderType);
+		w.put((int64_t)o.deliveryFee);
+		w.putString(o.deliveryAddress);
+		append(w);
+	}
+	
+	bool snapshotDue() const { return journal.isOpen() && eventsSinceSnapshot >= snapshotAfter; }
+	// a record could not be written, orders since may be lost on a crash
+	bool failed() const { return journal.writeFailed(); }
+	
+	// Rewrites the journal as the current state, so recovery replays
+	// one record per order and line instead of the whole history.
+	// Delivered and cancelled orders are left out: recovery would drop them.
+	// false - the journal keeps its history and the next attempt waits
+	// for another SNAPSHOT_EVENTS events.
+	bool snapshot(const std::vector<Order>& orders, const Order* draft) {
+		std::vector<uint8_t> records;
+		for (const auto& o : orders)
+			if (!closed(o.status)) encodeSnapshot(records, o, true);
+		if (draft) encodeSnapshot(records, *draft, false);
+		return compact(records);
+	}
+	// The same for a list of drafts and sent orders mixed (the order
+	// server): an order counts as sent once it has a kitchen ticket or has
+	// moved past PENDING. Drafts are left out, recovery drops them anyway;
+	// nextOrderId goes first so their IDs, and those of pruned orders, are
+	// not handed out again after a restart.
+	bool snapshot(const std::vector<Order>& orders, int nextOrderId) {
+		std::vector<uint8_t> records;
+		RecordWriter w;
+		w.put(OrderEvent::NEXT_ID);
+		w.put((int32_t)nextOrderId);
+		OrderJournal::frame(records, w.data, w.size);
+		for (const auto& o : orders)
+			if (o.kitchenTicket || o.status != OrderStatus::PENDING) encodeSnapshot(records, o, true);
+		return compact(records);
+	}
+
+private:
+	OrderJournal journal;
+	std::atomic<uint64_t> eventsSinceSnapshot{0}; // events may come from several threads
+	uint64_t snapshotAfter = SNAPSHOT_EVENTS;     // raised after a failed snapshot
+	
+	static bool closed(OrderStatus s) { return s == OrderStatus::DELIVERED || s == OrderStatus::CANCELLED; }
+	
+	bool compact(const std::vector<uint8_t>& records) {
+		if (!journal.compact(records)) {
+			snapshotAfter = eventsSinceSnapshot + SNAPSHOT_EVENTS;
+			return false;
+		}
+		eventsSinceSnapshot = 0;
+		snapshotAfter = SNAPSHOT_EVENTS;
+		return true;
+	}
+	
+	void append(const RecordWriter& w) {
+		if (!journal.isOpen()) return;
+		journal.append(w.data, w.size);
+		eventsSinceSnapshot++;
+	}
+	
+	// the order with its lines, plus its status once it was sent
+	static void encodeSnapshot(std::vector<uint8_t>& records, const Order& o, bool sent) {
+		RecordWriter w;
+		encodeCreate(w, o);
+		OrderJournal::frame(records, w.data, w.size);
+		for (const auto& l : o) {
+			w.size = 0;
+			encodeLine(w, o.orderId, l);
+			OrderJournal::frame(records, w.data, w.size);
+		}
+		if (sent) {
+			w.size = 0;
+			encodeStatus(w, o);
+			OrderJournal::frame(records, w.data, w.size);
+		}
+	}
+	
+	static void encodeCreate(RecordWriter& w, const Order& o) {
+		w.put(OrderEvent::CREATE);
+		w.put((int32_t)o.orderId);
+		w.put((uint8_t)o.orderType);
+		w.put((int64_t)o.deliveryFee);
+		w.putString(o.customerName);
+		w.putString(o.deliveryAddress);
+	}
+	
+	static void encodeLine(RecordWriter& w, int orderId, const OrderLine& l) {
+		w.put(OrderEvent::ADD_LINE);
+		w.put((int32_t)orderId);
+		w.put(l.item);
+		w.put((uint8_t)l.size);
+		w.put((uint8_t)l.baseType);
+		w.put(l.toppings.bits);
+		w.put(l.priceCents);
+	}
+	
+	static void encodeStatus(RecordWriter& w, const Order& o) {
+		w.put(OrderEvent::STATUS);
+		w.put((int32_t)o.orderId);
+		w.put((uint8_t)o.status);
+	}
+	
+	struct Recovery {
+		const Menu& menu;
+		OrderArena& arena;
+		std::vector<Order> orders;
+		std::vector<bool> sent;
+		std::vector<int32_t> indexById; // order IDs are small and dense
+		int maxOrderId = 0;
+		uint64_t events = 0;
+		
+		Recovery(const Menu& m, OrderArena& a) : menu(m), arena(a) {}
+		
+		Order* find(int32_t id) {
+			if (id < 0 || id >= (int32_t)indexById.size() || indexById[id] < 0) return nullptr;
+			return &orders[indexById[id]];
+		}
+		
+		static void apply(const uint8_t* payload, uint32_t size, void* user) {
+			Recovery& r = *(Recovery*)user;
+			RecordReader in{payload, payload + size};
+			OrderEvent type = in.get<OrderEvent>();
+			int32_t id = in.get<int32_t>();
+			r.events++;
+			
+			switch (type) {
+			case OrderEvent::CREATE: {
+				Order o(id, &r.arena);
+				o.orderType = (OrderType)in.get<uint8_t>();
+				o.deliveryFee = in.get<int64_t>();
+				o.customerName = in.getString();
+				o.deliveryAddress = in.getString();
+				if (!in.ok || id < 0) return;
+				if (id >= (int32_t)r.indexById.size()) r.indexById.resize(id + 1, -1);
+				r.indexById[id] = (int32_t)r.orders.size();
+				r.orders.push_back(std::move(o));
+				r.sent.push_back(false);
+				r.maxOrderId = std::max(r.maxOrderId, (int)id);
+				break;
+			}
+			case OrderEvent::ADD_LINE: {
+				OrderLine l;
+				l.item = in.get<ItemId>();
+				l.size = (PizzaSize)in.get<uint8_t>();
+				l.baseType = (BaseType)in.get<uint8_t>();
+				l.toppings.bits = in.get<uint32_t>();
+				l.priceCents = in.get<int32_t>();
+				Order* o = r.find(id);
+				// a line whose item left the menu cannot be shown any more
+				if (in.ok && o && l.item < r.menu.itemCount() && (int)l.size < SIZE_COUNT) o->restoreLine(l);
+				break;
+			}
+			case OrderEvent::REMOVE_LINE: {
+				int32_t index = in.get<int32_t>();
+				Order* o = r.find(id);
+				if (in.ok && o && index >= 0 && index < o->lineCount()) o->removeLine(index);
+				break;
+			}
+			case OrderEvent::STATUS: {
+				uint8_t status = in.get<uint8_t>();
+				Order* o = r.find(id);
+				if (in.ok && o && status <= (uint8_t)OrderStatus::CANCELLED) {
+					o->status = (OrderStatus)status;
+					r.sent[r.indexById[id]] = true;
+				}
+				break;
+			}
+			case OrderEvent::REPRICE: {
+				int32_t index = in.get<int32_t>();
+				int32_t price = in.get<int32_t>();
+				Order* o = r.find(id);
+				if (in.ok && o && index >= 0 && index < o->lineCount()) o->restorePrice(index, price);
+				break;
+			}
+			case OrderEvent::NEXT_ID:
+				if (in.ok) r.maxOrderId = std::max(r.maxOrderId, (int)id - 1);
+				break;
+			case OrderEvent::DELIVERY: {
+				uint8_t orderType = in.get<uint8_t>();
+				Cents fee = in.get<int64_t>();
+				std::string address = in.getString();
+				Order* o = r.find(id);
+				if (in.ok && o && orderType <= (uint8_t)OrderType::DELIVERY) {
+					o->orderType = (OrderType)orderType;
+					o->deliveryFee = fee;
+					o->deliveryAddress = std::move(address);
+				}
+				break;
+			}
+			}
+		}
+	};
+};
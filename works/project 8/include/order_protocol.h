@@ -0,0 +1,75 @@
+// order_protocol.h
+#pragma once
+
+#include "order_log.h"
+#include <cstdint>
+#include <vector>
+
+// Wire format between tills and the order server (little-endian).
+//
+// Every message is a frame: u32 size, then size bytes of payload.
+//   request:  u8 Request, fields below (RecordWriter encoding)
+//   response: u8 Request, u8 Result, i32 orderId, i64 total, u32 ticket, u8 status
+//
+// Responses come back in request order, so a till may send any number
+// of requests before reading (pipelining). orderId 0 in a request means
+// the order this connection created last, which lets a till send a whole
+// order - NEW_ORDER, its lines and SEND - in one round trip.
+//
+//   NEW_ORDER    u8 OrderType, string customer, string address
+//   ADD_LINE     i32 orderId, u16 item, u8 size, u8 base, u32 toppings
+//   REMOVE_LINE  i32 orderId, i32 index
+//   SEND         i32 orderId
+//   STATUS       i32 orderId
+
+enum class Request : uint8_t { NEW_ORDER = 1, ADD_LINE, REMOVE_LINE, SEND, STATUS };
+enum class Result : uint8_t { OK, UNKNOWN_ORDER, BAD_ITEM, ALREADY_SENT, KITCHEN_FULL, MALFORMED };
+
+struct Response {
+	Request request = Request::STATUS;
+	Result result = Result::OK;
+	int32_t orderId = 0;
+	Cents total = 0;
+	uint32_t ticket = 0;
+	OrderStatus status = OrderStatus::PENDING;
+};
+
+constexpr uint32_t MAX_FRAME_SIZE = 1024;
+
+inline void appendFrame(std::vector<uint8_t>& out, const RecordWriter& w) {
+	uint32_t size = w.size;
+	out.insert(out.end(), (const uint8_t*)&size, (const uint8_t*)&size + 4);
+	out.insert(out.end(), w.data, w.data + w.size);
+}
+
+inline void appendResponse(std::vector<uint8_t>& out, const Response& r) {
+	RecordWriter w;
+	w.put(r.request);
+	w.put(r.result);
+	w.put(r.orderId);
+	w.put((int64_t)r.total);
+	w.put(r.ticket);
+	w.put((uint8_t)r.status);
+	appendFrame(out, w);
+}
+
+inline bool parseResponse(const uint8_t* payload, uint32_t size, Response& r) {
+	RecordReader in{payload, payload + size};
+	r.request = in.get<Request>();
+	r.result = in.get<Result>();
+	r.orderId = in.get<int32_t>();
+	r.total = in.get<int64_t>();
+	r.ticket = in.get<uint32_t>();
+	r.status = (OrderStatus)in.get<uint8_t>();
+	return in.ok;
+}
+
+// Payload of the first complete frame in [data, data + size), or null
+// when more bytes are needed. frameBytes gets the whole frame's length.
+inline const uint8_t* nextFrame(const uint8_t* data, size_t size, uint32_t& payloadSize, size_t& frameBytes) {
+	if (size < 4) return nullptr;
+	memcpy(&payloadSize, data, 4);
+	if (size - 4 < payloadSize) return nullptr;
+	frameBytes = 4 + (size_t)payloadSize;
+	return data + 4;
+}
@@ -0,0 +1,119 @@
+// order_server.h
+#pragma once
+
+#include "dispatch.h"
+#include "kitchen.h"
+#include "menu_catalog.h"
+#include "order_protocol.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Order service that many tills share, see order_protocol.h for the wire
+// format. One thread runs an epoll loop over every connection and owns
+// the orders, so requests never wait on a lock; each readable socket is
+// drained, all complete frames in it are answered and the answers go
+// out in a single write.
+//
+// Order IDs come from one counter that continues after the highest ID in
+// the journal, so no two tills and no restart ever hand out the same ID.
+//
+// Kitchen statuses are copied into the orders and journaled every
+// KITCHEN_POLL_MS whether or not a till asks, so a restart never cooks a
+// finished order again. Finished orders, and the unsent drafts of closed
+// connections, are dropped every so often and the journal is snapshotted
+// on the same schedule as the app's, so neither memory nor the journal
+// grows with the number of orders ever served. STATUS on a dropped order
+// answers UNKNOWN_ORDER.
+//
+// Linux only (epoll); elsewhere start() returns false.
+
+struct ServerOptions {
+	std::string host = "127.0.0.1";
+	uint16_t port = 5150;          // 0 - any free port, see port()
+	std::string unixPath;          // listen here instead of on TCP when set
+	std::string journalPath;       // empty - no journal; locked while the server runs
+	std::string menuPath;          // empty - the built-in menu, else reloaded when it changes
+	JournalOptions journal;
+	KitchenConfig kitchen;
+};
+
+struct ServerStats {
+	uint64_t connections = 0;      // open now
+	uint64_t requests = 0;
+	uint64_t ordersSent = 0;
+	uint64_t reads = 0;            // requests / reads is the pipelining depth
+};
+
+class OrderServer {
+public:
+	explicit OrderServer(const ServerOptions& options = ServerOptions());
+	~OrderServer();
+	OrderServer(const OrderServer&) = delete;
+	OrderServer& operator=(const OrderServer&) = delete;
+
+	// Recovers the journal and starts listening; false if either fails.
+	bool start();
+	// Serves until stop() is called from any thread.
+	void run();
+	void stop();
+
+	uint16_t port() const { return boundPort; }
+	ServerStats stats() const;
+	int allocateOrderId() { return nextOrderId.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+	struct Connection {
+		int fd = -1;
+		std::vector<uint8_t> in;
+		std::vector<uint8_t> out;
+		size_t outSent = 0;
+		int32_t current = 0;       // order ID 0 stands for
+		std::vector<int32_t> drafts; // created here and not sent from here yet
+		bool writing = false;      // waiting for EPOLLOUT
+	};
+
+	ServerOptions options;
+	MenuCatalog catalog;
+	std::shared_ptr<const Menu> menu; // taken once per read, see run()
+	std::chrono::steady_clock::time_point menuChecked;
+	std::chrono::steady_clock::time_point kitchenChecked;
+	OrderArena arenas[2];          // prune() moves the kept orders to the other one
+	int arena = 0;
+	std::vector<Order> orders;
+	size_t finishedOrders = 0;     // in orders, waiting for prune()
+	std::vector<int32_t> cooking;  // IDs of the orders in the kitchen, see pollKitchen()
+	size_t unsubmitted = 0;        // of them still without a ticket, the kitchen was full
+	bool journalFailed = false;    // reported once
+	std::unordered_map<int32_t, size_t> orderIndex;
+	std::atomic<int> nextOrderId{1};
+	Kitchen kitchen;
+	OrderLog log;
+	Dispatcher quotes;             // delivery fee quotes only
+
+	int listenFd = -1;
+	int epollFd = -1;
+	int wakeFd = -1;
+	uint16_t boundPort = 0;
+	std::atomic<bool> running{false};
+	std::unordered_map<int, Connection> connections;
+
+	std::atomic<uint64_t> requestCount{0};
+	std::atomic<uint64_t> sentCount{0};
+	std::atomic<uint64_t> readCount{0};
+	std::atomic<uint64_t> connectionCount{0};
+
+	void accept();
+	void reloadMenu();
+	void readable(Connection& c);
+	bool flush(Connection& c);
+	void close(Connection& c);
+	Response handle(Connection& c, const uint8_t* payload, uint32_t size);
+	Order* find(Connection& c, int32_t id, Response& r);
+	void updateStatus(Order& o);
+	void pollKitchen();
+	void maintain();
+	void prune();
+};
@@ -0,0 +1,15 @@
+// pizzeria.h
+// Business logic of the pizzeria without any UI: menu, orders, kitchen,
+// the order journal, sales, delivery dispatch and the order server with
+// its client. Built as the pizzeria library, see build/premake5.lua.
+#pragma once
+
+#include "menu.h"
+#include "menu_catalog.h"
+#include "order.h"
+#include "kitchen.h"
+#include "order_log.h"
+#include "sales_store.h"
+#include "dispatch.h"
+#include "order_server.h"
+#include "order_client.h"
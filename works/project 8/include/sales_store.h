@@ -0,0 +1,62 @@
+// sales_store.h
+#pragma once
+
+#include "order.h"
+#include <cstdint>
+#include <vector>
+
+// Completed order lines kept column by column, so that a query reads
+// only the two or three arrays it needs. Queries sum revenue and count
+// lines per group over a time range and split the rows across cores.
+//
+// Small groups (up to 8 keys: item, size, order type) use an SSE2
+// kernel that compares four keys at once and adds into 32-bit partial
+// sums; bigger ones (hour) use a histogram split in four to keep
+// consecutive rows off the same counters.
+
+enum class SalesGroup { ITEM, SIZE, HOUR, ORDER_TYPE };
+
+struct SalesTotals {
+	std::vector<Cents> revenue; // by key
+	std::vector<uint64_t> lines;
+	double milliseconds = 0;    // query time
+};
+
+class SalesStore {
+public:
+	static constexpr int NO_SIZE = SIZE_COUNT; // size key of drinks and sides
+	static constexpr int HOURS = 24;
+	static constexpr int ORDER_TYPES = 3;
+
+	void reserve(size_t lines);
+	void clear();
+	size_t size() const { return cents.size(); }
+
+	// unixTime is when the order was completed
+	void addOrder(const Order& order, const Menu& menu, int64_t unixTime);
+	void addLine(const OrderLine& line, bool sized, OrderType type, int64_t unixTime);
+
+	// keyCount: menu items for ITEM, fixed for the other groups.
+	// Lines completed in [from, to) count; threads 0 - all cores.
+	SalesTotals query(SalesGroup group, int keyCount, int64_t from = INT64_MIN, int64_t to = INT64_MAX, int threads = 0) const;
+	// how many lines carry each topping
+	std::vector<uint64_t> toppingCounts(int64_t from = INT64_MIN, int64_t to = INT64_MAX, int threads = 0) const;
+
+	static int groupKeyCount(SalesGroup group, const Menu& menu);
+
+private:
+	std::vector<uint16_t> item;
+	std::vector<uint8_t> sizeKey;
+	std::vector<uint8_t> baseType;
+	std::vector<uint8_t> orderType;
+	std::vector<uint8_t> hour;      // local time of completion
+	std::vector<uint32_t> toppings;
+	std::vector<int32_t> cents;
+	std::vector<uint32_t> seconds;  // since epoch
+	int64_t epoch = 0;              // unix time of the first line's day
+	int32_t maxAbsCents = 0;
+	int64_t hourQuarter = -1;       // local hour cache for addLine
+	uint8_t quarterHour = 0;
+
+	void timeRange(int64_t from, int64_t to, uint32_t& begin, uint32_t& span) const;
+};
@@ -2,210 +2,71 @@
 #include "raylib.h"
 #define RAYGUI_IMPLEMENTATION
 #include "raygui.h"
-#include <algorithm>
-#include <vector>
+#define FRAME_PROFILER_IMPLEMENTATION
+#include "frame_profiler.h"
+#include "pizzeria.h"
+#include <cstdio>
+#include <ctime>
+#include <random>
 #include <string>
-#include <iostream>
-
-// ========================
-// Business Logic Classes
-// ========================
-
-struct Topping {
-	std::string name;
-	double price;
-};
-
-class MenuItem {
-protected:
-	std::string name;
-	double basePrice;
-	
-public:
-	MenuItem(const std::string& n, double p) : name(n), basePrice(p) {}
-	virtual ~MenuItem() = default;
-	
-	std::string getName() const { return name; }
-	double getBasePrice() const { return basePrice; }
-	
-	virtual double calculatePrice() const = 0;
-	virtual void display() const = 0;
-};
-
-enum class PizzaSize { SMALL, MEDIUM, LARGE };
-enum class BaseType { THIN, TRADITIONAL, THICK };
-
-class Pizza : public MenuItem {
-private:
-	PizzaSize size;
-	BaseType baseType;
-	std::vector<Topping> toppings;
-	
-public:
-	Pizza(const std::string& n, double p)
-	: MenuItem(n, p), size(PizzaSize::MEDIUM), baseType(BaseType::THIN) {}
-	
-	void setSize(PizzaSize s) { size = s; }
-	void setBaseType(BaseType bt) { baseType = bt; }
-	void addTopping(const Topping& t) { toppings.push_back(t); }
-	void removeTopping(const std::string& toppingName) {
-		toppings.erase(std::remove_if(toppings.begin(), toppings.end(),
-			[&](const Topping& t){ return t.name == toppingName; }), toppings.end());
-	}
-	
-	double calculatePrice() const override {
-		double price = basePrice;
-		switch (size) {
-			case PizzaSize::SMALL: price *= 1.0; break;
-			case PizzaSize::MEDIUM: price *= 1.2; break;
-			case PizzaSize::LARGE: price *= 1.5; break;
-		}
-		for (const auto& t : toppings) price += t.price;
-		return price;
-	}
-	
-	void display() const override {
-		std::cout << "Pizza: " << name << ", Size: ";
-		switch(size) {
-			case PizzaSize::SMALL: std::cout << "Small"; break;
-			case PizzaSize::MEDIUM: std::cout << "Medium"; break;
-			case PizzaSize::LARGE: std::cout << "Large"; break;
-		}
-		std::cout << ", Base: ";
-		switch(baseType) {
-			case BaseType::THIN: std::cout << "Thin"; break;
-			case BaseType::TRADITIONAL: std::cout << "Traditional"; break;
-			case BaseType::THICK: std::cout << "Thick"; break;
-		}
-		std::cout << ", Toppings: ";
-		for (const auto& t : toppings) std::cout << t.name << " ";
-		std::cout << ", Price: $" << calculatePrice() << std::endl;
-	}
-	
-	PizzaSize getSize() const { return size; }
-	BaseType getBaseType() const { return baseType; }
-	const std::vector<Topping>& getToppings() const { return toppings; }
-};
-
-class Drink : public MenuItem {
-private:
-	double volume;
-	bool isCarbonated;
-public:
-	Drink(const std::string& n, double p, double v, bool c)
-	: MenuItem(n, p), volume(v), isCarbonated(c) {}
-	
-	double calculatePrice() const override { return basePrice; }
-	void display() const override {
-		std::cout << "Drink: " << name << ", Volume: " << volume << "L"
-		<< (isCarbonated ? ", Carbonated" : ", Non-carbonated")
-		<< ", Price: $" << basePrice << std::endl;
-	}
-};
-
-class SideDish : public MenuItem {
-private:
-	std::string portionSize;
-public:
-	SideDish(const std::string& n, double p, const std::string& portion)
-	: MenuItem(n, p), portionSize(portion) {}
-	
-	double calculatePrice() const override { return basePrice; }
-	void display() const override {
-		std::cout << "SideDish: " << name << ", Portion: " << portionSize
-		<< ", Price: $" << basePrice << std::endl;
-	}
-};
-
-class Menu {
-public:
-	std::vector<Pizza> availablePizzas;
-	std::vector<Drink> availableDrinks;
-	std::vector<SideDish> availableSides;
-	std::vector<Topping> availableToppings;
-	
-	Menu() {
-		availablePizzas.emplace_back("Margherita", 5.0);
-		availablePizzas.emplace_back("Pepperoni", 6.5);
-		availablePizzas.emplace_back("Hawaiian", 7.0);
-		
-		availableDrinks.emplace_back("Coca-Cola", 1.5, 0.5, true);
-		availableDrinks.emplace_back("Water", 1.0, 0.5, false);
-		
-		availableSides.emplace_back("French Fries", 2.0, "Medium");
-		availableSides.emplace_back("Salad", 2.5, "Small");
-		
-		availableToppings.push_back({"Cheese", 0.5});
-		availableToppings.push_back({"Mushrooms", 0.7});
-		availableToppings.push_back({"Olives", 0.6});
-		availableToppings.push_back({"Peppers", 0.4});
-	}
-};
-
-enum class OrderType { DINE_IN, TAKEAWAY, DELIVERY };
-enum class OrderStatus { PENDING, PREPARING, READY, DELIVERED, CANCELLED };
-
-class Order {
-public:
-	int orderId;
-	std::vector<Pizza> pizzas;
-	std::vector<Drink> drinks;
-	std::vector<SideDish> sides;
-	
-	std::string customerName;
-	OrderType orderType;
-	std::string deliveryAddress;
-	double deliveryFee = 0;
-	double totalAmount = 0;
-	
-	Order(int id) : orderId(id), orderType(OrderType::DINE_IN) {}
-	
-	void addPizza(const Pizza& p) { pizzas.push_back(p); }
-	void addDrink(const Drink& d) { drinks.push_back(d); }
-	void addSideDish(const SideDish& s) { sides.push_back(s); }
-	
-	void calculateTotal() {
-		totalAmount = 0;
-		for (const auto& p : pizzas) totalAmount += p.calculatePrice();
-		for (const auto& d : drinks) totalAmount += d.calculatePrice();
-		for (const auto& s : sides) totalAmount += s.calculatePrice();
-		if (orderType == OrderType::DELIVERY) totalAmount += deliveryFee;
-	}
-	
-	void displayOrder() const {
-		std::cout << "Order #" << orderId << " for " << customerName << std::endl;
-		std::cout << "Pizzas:\n";
-		for (const auto& p : pizzas) p.display();
-		std::cout << "Drinks:\n";
-		for (const auto& d : drinks) d.display();
-		std::cout << "Sides:\n";
-		for (const auto& s : sides) s.display();
-		std::cout << "Total: $" << totalAmount << std::endl;
-	}
-};
+#include <unordered_map>
+#include <vector>
 
 // ====================
 // UI and Management
 // ====================
 
-enum class Screen { MAIN_MENU, CREATE_ORDER, VIEW_ORDER };
+enum class Screen { MAIN_MENU, CREATE_ORDER, VIEW_ORDER, SALES, ORDER_BOARD };
 
 class PizzeriaApp {
 private:
-	Menu menu;
+	MenuCatalog catalog;
+	std::shared_ptr<const Menu> menu; // this frame's snapshot
+	std::string menuError;
+	std::string journalError;
+	double menuCheckTime = -10;
+	OrderArena orderArenas[2]; // pruneOrders() moves the kept orders to the other one
+	int arena = 0;
 	std::vector<Order> activeOrders;
+	std::unordered_map<int, size_t> activeIndex; // order ID -> activeOrders
+	std::vector<int> unsubmitted; // recovered orders the kitchen had no room for, see pollKitchen()
 	int nextOrderId = 1;
+	bool testOrdersShown = false; // see addTestOrders()
+	
+	Kitchen kitchen;
+	int statusCounts[5] = {}; // by OrderStatus, refreshed every frame
+	int prunedCounts[5] = {}; // the orders pruneOrders() dropped, still counted above
+	size_t finishedOrders = 0; // delivered or abandoned since the last pruneOrders()
+	static constexpr size_t PRUNE_AFTER = 4096; // or half of the orders, as OrderServer
+	OrderLog orderLog;
+	Dispatcher dispatcher;
+	std::vector<DispatchEvent> dispatchEvents;
+	
+	SalesStore sales;
+	SalesTotals salesBy[4];          // by SalesGroup
+	std::vector<uint64_t> toppingSales;
+	size_t salesQueried = 0;         // store size at the last query
+	std::shared_ptr<const Menu> salesMenu; // the menu the last query ran against, for its labels
+	double salesQueryTime = -10;
+	
+	// Order board: one cached label per active order, rebuilt when the order changes
+	std::vector<std::string> boardLabels;
+	std::vector<bool> boardLabelValid;
+	Vector2 boardScroll = {0, 0};
+	int boardSelected = -1;
 	
 	Screen currentScreen = Screen::MAIN_MENU;
 	Order currentOrder = Order(0);
 	
-	Pizza tempPizza = Pizza("", 0);
-	
 	int selectedMenuCategory = 0;
 	int selectedItemIndex = 0;
 	
 	int selectedToppingIndex = 0;
 	
+	int orderTypeIndex = 0;
+	char addressText[RecordWriter::MAX_STRING + 1] = "";
+	bool addressEdit = false;
+	
 public:
 	void run() {
 		const int screenWidth = 900;
@@ -214,9 +75,22 @@ public:
 		
 		SetTargetFPS(60);
 		
-		currentOrder = Order(nextOrderId++);
+		refreshMenu();
+		recoverOrders();
+		newOrder();
 		
 		while (!WindowShouldClose()) {
+			PROFILE_BEGIN("update");
+			refreshMenu();
+			pollKitchen();
+			pollDispatch();
+			if (finishedOrders >= std::max(PRUNE_AFTER, activeOrders.size() / 2)) pruneOrders();
+			if (!testOrdersShown && orderLog.snapshotDue() && !orderLog.snapshot(activeOrders, &currentOrder))
+				journalError = "orders.journal: snapshot failed, the journal keeps growing";
+			if (orderLog.failed()) journalError = "orders.journal: cannot write, new orders are not saved";
+			PROFILE_END();
+			
+			PROFILE_BEGIN("draw");
 			BeginDrawing();
 			ClearBackground(RAYWHITE);
 			
@@ -230,34 +104,196 @@ public:
 			case Screen::VIEW_ORDER:
 				drawViewOrder();
 				break;
+			case Screen::SALES:
+				drawSales();
+				break;
+			case Screen::ORDER_BOARD:
+				drawOrderBoard();
+				break;
 			}
 			
+			PROFILE_OVERLAY();
+			PROFILE_END();
 			EndDrawing();
+			PROFILE_FRAME_END();
 		}
 		
 		CloseWindow();
 	}
 	
 private:
+	// menu.txt is checked once a second; an edit goes live on the next frame.
+	void refreshMenu() {
+		if (GetTime() - menuCheckTime >= 1.0) {
+			menuCheckTime = GetTime();
+			std::string error;
+			if (catalog.reloadIfChanged("menu.txt", error)) menuError.clear();
+			else if (!error.empty()) menuError = error;
+		}
+		std::shared_ptr<const Menu> latest = catalog.current();
+		if (latest == menu) return;
+		menu = std::move(latest);
+		// the draft follows the new prices, sent orders keep theirs
+		Order::repriceAll(*menu, &currentOrder, 1);
+		orderLog.repriced(currentOrder);
+	}
+	
+	// Orders the kitchen had not finished go back into its queue; pollKitchen()
+	// retries the ones it had no room for.
+	void recoverOrders() {
+		if (!orderLog.open("orders.journal", *menu, orderArenas[arena], activeOrders, nextOrderId))
+			journalError = "orders.journal: cannot open (in use by another program?), orders are not saved";
+		for (size_t i = 0; i < activeOrders.size(); i++) {
+			Order& o = activeOrders[i];
+			activeIndex[o.orderId] = i;
+			if (o.status == OrderStatus::PENDING || o.status == OrderStatus::PREPARING) {
+				o.kitchenTicket = kitchen.submit();
+				if (!o.kitchenTicket) unsubmitted.push_back(o.orderId);
+			} else if (o.status == OrderStatus::READY && o.orderType == OrderType::DELIVERY)
+				dispatcher.add(o.orderId, dispatcher.locate(o.deliveryAddress), GetTime());
+		}
+	}
+	
+	void newOrder() {
+		if (!currentOrder.empty()) finishedOrders++; // an abandoned draft, its span waits for pruneOrders()
+		currentOrder = Order(nextOrderId++, &orderArenas[arena]);
+		orderLog.created(currentOrder);
+		orderTypeIndex = 0;
+		addressText[0] = '\0';
+		addressEdit = false;
+	}
+	
+	void addActive(Order&& o) {
+		activeIndex[o.orderId] = activeOrders.size();
+		activeOrders.push_back(std::move(o));
+	}
+	
+	// Drops the delivered and cancelled orders and copies the rest, draft
+	// included, into the other arena, so the spans of dropped, regrown and
+	// abandoned orders are released with this one.
+	void pruneOrders() {
+		OrderArena& next = orderArenas[1 - arena];
+		std::vector<Order> kept;
+		kept.reserve(activeOrders.size());
+		activeIndex.clear();
+		for (Order& o : activeOrders) {
+			if (o.status == OrderStatus::DELIVERED || o.status == OrderStatus::CANCELLED) {
+				prunedCounts[(int)o.status]++;
+				continue;
+			}
+			activeIndex[o.orderId] = kept.size();
+			kept.push_back(o.relocate(&next));
+		}
+		activeOrders.swap(kept);
+		currentOrder = currentOrder.relocate(&next);
+		orderArenas[arena].reset();
+		arena = 1 - arena;
+		finishedOrders = 0;
+		boardLabels.clear();
+		boardLabelValid.clear();
+		boardSelected = -1;
+	}
+	
+	// The kitchen threads never touch the orders: statuses are copied in here.
+	void pollKitchen() {
+		for (size_t k = 0; k < unsubmitted.size();) {
+			auto found = activeIndex.find(unsubmitted[k]);
+			if (found != activeIndex.end() && !(activeOrders[found->second].kitchenTicket = kitchen.submit())) {
+				k++;
+				continue;
+			}
+			unsubmitted[k] = unsubmitted.back();
+			unsubmitted.pop_back();
+		}
+		std::copy(std::begin(prunedCounts), std::end(prunedCounts), statusCounts);
+		for (size_t i = 0; i < activeOrders.size(); i++) {
+			Order& o = activeOrders[i];
+			if (o.kitchenTicket && (o.status == OrderStatus::PENDING || o.status == OrderStatus::PREPARING)) {
+				OrderStatus status = kitchen.status(o.kitchenTicket);
+				if (status != o.status) {
+					o.status = status;
+					orderLog.statusChanged(o);
+					invalidateBoardRow(i);
+					if (status == OrderStatus::READY) {
+						sales.addOrder(o, *menu, (int64_t)time(nullptr));
+						if (o.orderType == OrderType::DELIVERY) dispatcher.add(o.orderId, dispatcher.locate(o.deliveryAddress), GetTime());
+					}
+				}
+			}
+			statusCounts[(int)o.status]++;
+		}
+	}
+	
+	// Couriers set the final fee when they leave and deliver on their own clock.
+	void pollDispatch() {
+		dispatchEvents.clear();
+		dispatcher.update(GetTime(), dispatchEvents);
+		for (const auto& e : dispatchEvents) {
+			auto found = activeIndex.find(e.orderId);
+			if (found == activeIndex.end()) continue;
+			Order& o = activeOrders[found->second];
+			if (e.kind == DispatchEvent::DEPARTED) {
+				o.deliveryFee = e.fee;
+				orderLog.deliveryChanged(o);
+			} else {
+				o.status = OrderStatus::DELIVERED;
+				orderLog.statusChanged(o);
+				finishedOrders++;
+			}
+			invalidateBoardRow(found->second);
+		}
+	}
+	
+	void drawKitchenStats(int x, int y) {
+		KitchenStats ks = kitchen.stats();
+		DrawText(TextFormat("Orders: %d pending, %d preparing, %d ready, %d delivered, %d cancelled",
+			statusCounts[(int)OrderStatus::PENDING], statusCounts[(int)OrderStatus::PREPARING], statusCounts[(int)OrderStatus::READY],
+			statusCounts[(int)OrderStatus::DELIVERED], statusCounts[(int)OrderStatus::CANCELLED]), x, y, 18, DARKGRAY);
+		y += 26;
+		for (const auto& st : ks.stations) {
+			DrawText(TextFormat("%-8s queue %4d  busy %d/%d  served %6llu  wait %.0f ms avg, %.0f ms max",
+				st.name, st.queued, st.busy, st.capacity, (unsigned long long)st.served, st.avgWaitMs, st.maxWaitMs), x, y, 16, GRAY);
+			y += 22;
+		}
+		DrawText(TextFormat("Throughput %.2f orders/min, latency %.1f s avg", ks.ordersPerSecond * 60.0, ks.avgLatencyMs / 1000.0), x, y, 16, GRAY);
+		y += 22;
+		DispatchStats ds = dispatcher.stats();
+		DrawText(TextFormat("Couriers %d idle, %d loading, %d out; %d waiting; %.2f orders/trip, %.2f km/order",
+			ds.idle, ds.loading, ds.couriers - ds.idle - ds.loading, ds.waiting, ds.ordersPerTrip, ds.kmPerOrder), x, y, 16, GRAY);
+	}
+	
 	void drawMainMenu() {
 		DrawText("Pizzeria Main Menu", 320, 40, 30, DARKGRAY);
 		
 		if (GuiButton({350, 150, 200, 50}, "Create New Order")) {
-			currentOrder = Order(nextOrderId++);
+			newOrder();
 			currentScreen = Screen::CREATE_ORDER;
 		}
 		
 		if (GuiButton({350, 220, 200, 50}, "View Current Order")) {
-			if (currentOrder.pizzas.empty() && currentOrder.drinks.empty() && currentOrder.sides.empty()) {
+			if (currentOrder.empty()) {
 				// empty
 			} else {
 				currentScreen = Screen::VIEW_ORDER;
 			}
 		}
 		
-		if (GuiButton({350, 290, 200, 50}, "Exit")) {
+		if (GuiButton({350, 290, 200, 50}, "Sales")) {
+			refreshSales();
+			currentScreen = Screen::SALES;
+		}
+		
+		if (GuiButton({350, 360, 200, 50}, "Order Board")) {
+			currentScreen = Screen::ORDER_BOARD;
+		}
+		
+		if (GuiButton({350, 430, 200, 50}, "Exit")) {
 			CloseWindow();
 		}
+		
+		drawKitchenStats(150, 510);
+		if (!menuError.empty()) DrawText(menuError.c_str(), 150, 660, 16, RED);
+		if (!journalError.empty()) DrawText(journalError.c_str(), 150, 636, 16, RED);
 	}
 	
 	void drawCreateOrder() {
@@ -275,44 +311,41 @@ private:
 			}
 		}
 		
+		drawOrderType();
+		
 		int listY = 120;
 		int count = 0;
 		
 		switch (selectedMenuCategory) {
 		case 0:
-			count = (int)menu.availablePizzas.size();
+			count = (int)menu->availablePizzas.size();
 			for (int i = 0; i < count; i++) {
-				std::string btnText = menu.availablePizzas[i].getName() + " $" + std::to_string(menu.availablePizzas[i].getBasePrice());
+				std::string btnText = menu->availablePizzas[i].getName() + " $" + std::to_string(menu->availablePizzas[i].getBasePrice());
 				Rectangle btnRect = {50, (float)(listY + i * 40), 300, 35};
 				if (GuiButton(btnRect, btnText.c_str())) {
-					tempPizza = menu.availablePizzas[i];
-					tempPizza.setSize(PizzaSize::MEDIUM);
-					tempPizza.setBaseType(BaseType::THIN);
 					currentScreen = Screen::VIEW_ORDER;
-					currentOrder.addPizza(tempPizza);
-					currentOrder.calculateTotal();
+					if (currentOrder.addPizza(*menu, menu->pizzaId(i), PizzaSize::MEDIUM, BaseType::THIN, ToppingSet{}))
+						orderLog.lineAdded(currentOrder);
 				}
 			}
 			break;
 		case 1:
-			count = (int)menu.availableDrinks.size();
+			count = (int)menu->availableDrinks.size();
 			for (int i = 0; i < count; i++) {
-				std::string btnText = menu.availableDrinks[i].getName() + " $" + std::to_string(menu.availableDrinks[i].getBasePrice());
+				std::string btnText = menu->availableDrinks[i].getName() + " $" + std::to_string(menu->availableDrinks[i].getBasePrice());
 				Rectangle btnRect = {50, (float)(listY + i * 40), 300, 35};
 				if (GuiButton(btnRect, btnText.c_str())) {
-					currentOrder.addDrink(menu.availableDrinks[i]);
-					currentOrder.calculateTotal();
+					if (currentOrder.addItem(*menu, menu->drinkId(i))) orderLog.lineAdded(currentOrder);
 				}
 			}
 			break;
 		case 2:
-			count = (int)menu.availableSides.size();
+			count = (int)menu->availableSides.size();
 			for (int i = 0; i < count; i++) {
-				std::string btnText = menu.availableSides[i].getName() + " $" + std::to_string(menu.availableSides[i].getBasePrice());
+				std::string btnText = menu->availableSides[i].getName() + " $" + std::to_string(menu->availableSides[i].getBasePrice());
 				Rectangle btnRect = {50, (float)(listY + i * 40), 300, 35};
 				if (GuiButton(btnRect, btnText.c_str())) {
-					currentOrder.addSideDish(menu.availableSides[i]);
-					currentOrder.calculateTotal();
+					if (currentOrder.addItem(*menu, menu->sideId(i))) orderLog.lineAdded(currentOrder);
 				}
 			}
 			break;
@@ -323,40 +356,270 @@ private:
 		}
 	}
 	
+	// Delivery orders get a quote for a trip of their own; batching can only lower it.
+	void drawOrderType() {
+		int previous = orderTypeIndex;
+		GuiToggleGroup({500, 70, 110, 40}, "Dine-in;Takeaway;Delivery", &orderTypeIndex);
+		bool changed = orderTypeIndex != previous;
+		if (orderTypeIndex == (int)OrderType::DELIVERY) {
+			if (GuiTextBox({500, 120, 334, 35}, addressText, sizeof(addressText), addressEdit)) {
+				addressEdit = !addressEdit;
+				changed |= !addressEdit;
+			}
+			DrawText(TextFormat("Delivery fee $%s", formatCents(currentOrder.deliveryFee).c_str()), 500, 165, 18, DARKGRAY);
+		}
+		if (!changed) return;
+		currentOrder.orderType = (OrderType)orderTypeIndex;
+		currentOrder.deliveryAddress = currentOrder.orderType == OrderType::DELIVERY ? addressText : "";
+		currentOrder.deliveryFee = currentOrder.orderType == OrderType::DELIVERY ? dispatcher.quote(dispatcher.locate(addressText)) : 0;
+		orderLog.deliveryChanged(currentOrder);
+	}
+	
 	void drawViewOrder() {
 		DrawText("Current Order", 350, 20, 25, DARKGRAY);
 		
+		static const char* headers[] = { "Pizzas:", "Drinks:", "Sides:" };
 		int y = 80;
-		DrawText("Pizzas:", 50, y, 20, BLACK);
-		y += 30;
-		for (const auto& p : currentOrder.pizzas) {
-			std::string line = p.getName() + " $" + std::to_string(p.calculatePrice());
-			DrawText(line.c_str(), 60, y, 18, DARKGRAY);
-			y += 25;
+		for (int c = 0; c < 3; c++) {
+			if (c > 0) y += 10;
+			DrawText(headers[c], 50, y, 20, BLACK);
+			y += 30;
+			for (const auto& l : currentOrder) {
+				if ((int)menu->category(l.item) != c) continue;
+				std::string line = menu->name(l.item) + " $" + formatCents(l.priceCents);
+				DrawText(line.c_str(), 60, y, 18, DARKGRAY);
+				y += 25;
+			}
+		}
+		
+		y += 40;
+		std::string totalStr = "Total: $" + formatCents(currentOrder.total());
+		DrawText(totalStr.c_str(), 50, y, 22, RED);
+		
+		if (!currentOrder.empty() && GuiButton({420, 600, 200, 50}, "Send to Kitchen")) {
+			uint32_t ticket = kitchen.submit();
+			if (ticket) {
+				currentOrder.kitchenTicket = ticket;
+				orderLog.statusChanged(currentOrder);
+				addActive(std::move(currentOrder));
+				newOrder();
+				currentScreen = Screen::MAIN_MENU;
+			}
+		}
+		
+		if (GuiButton({650, 600, 200, 50}, "Back to Menu")) {
+			currentScreen = Screen::MAIN_MENU;
+		}
+	}
+	
+	// ====================
+	// Order Board
+	// ====================
+	
+	void invalidateBoardRow(size_t i) {
+		if (i < boardLabelValid.size()) boardLabelValid[i] = false;
+	}
+	
+	const std::string& boardLabel(size_t i) {
+		if (boardLabels.size() < activeOrders.size()) {
+			boardLabels.resize(activeOrders.size());
+			boardLabelValid.resize(activeOrders.size(), false);
+		}
+		if (!boardLabelValid[i]) {
+			static const char* types[] = { "Dine-in", "Takeaway", "Delivery" };
+			static const char* statuses[] = { "Pending", "Preparing", "Ready", "Delivered", "Cancelled" };
+			const Order& o = activeOrders[i];
+			char buffer[160];
+			snprintf(buffer, sizeof(buffer), "#%-7d %-12.12s %-9s %3d lines %10s   %s", o.orderId, o.customerName.c_str(),
+				types[(int)o.orderType], o.lineCount(), ("$" + formatCents(o.total())).c_str(), statuses[(int)o.status]);
+			boardLabels[i] = buffer;
+			boardLabelValid[i] = true;
+		}
+		return boardLabels[i];
+	}
+	
+#if defined(DEBUG)
+	// Fills the board with random orders to see it under load (debug builds
+	// only). They are neither journaled nor sent to the kitchen, so they
+	// never reach the sales figures or come back on the next start; a
+	// snapshot would write them, so the journal keeps its history instead.
+	void addTestOrders(int count) {
+		static const char* names[] = { "Anna", "Boris", "Chen", "Dmitri", "Eve", "Farida", "Gustav", "Hana" };
+		std::mt19937 rng((unsigned)activeOrders.size() + 1);
+		activeOrders.reserve(activeOrders.size() + count);
+		for (int n = 0; n < count; n++) {
+			Order o(nextOrderId++, &orderArenas[arena]);
+			o.customerName = names[rng() % 8];
+			o.orderType = (OrderType)(rng() % 3);
+			int lines = 1 + rng() % 5;
+			for (int k = 0; k < lines; k++) {
+				if (rng() % 2) o.addPizza(*menu, menu->pizzaId(rng() % menu->availablePizzas.size()), (PizzaSize)(rng() % SIZE_COUNT), BaseType::THIN, ToppingSet{});
+				else o.addItem(*menu, menu->drinkId(rng() % menu->availableDrinks.size()));
+			}
+			addActive(std::move(o));
 		}
+		testOrdersShown = true;
+	}
+#endif
+	
+	// Only the rows inside the scroll panel's view are formatted and drawn.
+	void drawOrderBoard() {
+		DrawText("Order Board", 360, 20, 25, DARKGRAY);
+		
+		const float rowHeight = 24;
+		Rectangle bounds = {30, 70, 840, 400};
+		Rectangle content = {0, 0, bounds.width - 16, rowHeight * activeOrders.size()};
+		Rectangle view = {0, 0, 0, 0};
+		GuiScrollPanel(bounds, TextFormat("%zu orders", activeOrders.size()), content, &boardScroll, &view);
 		
-		y += 10;
-		DrawText("Drinks:", 50, y, 20, BLACK);
-		y += 30;
-		for (const auto& d : currentOrder.drinks) {
-			std::string line = d.getName() + " $" + std::to_string(d.calculatePrice());
-			DrawText(line.c_str(), 60, y, 18, DARKGRAY);
-			y += 25;
+		int first = (int)(-boardScroll.y / rowHeight);
+		int last = std::min((int)activeOrders.size(), (int)((view.height - boardScroll.y) / rowHeight) + 1);
+		BeginScissorMode((int)view.x, (int)view.y, (int)view.width, (int)view.height);
+		for (int i = first; i < last; i++) {
+			Rectangle row = {view.x, view.y + boardScroll.y + i * rowHeight, view.width, rowHeight};
+			bool hover = CheckCollisionPointRec(GetMousePosition(), row) && CheckCollisionPointRec(GetMousePosition(), view);
+			if (hover && IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) boardSelected = i;
+			if (i == boardSelected) DrawRectangleRec(row, SKYBLUE);
+			else if (hover) DrawRectangleRec(row, LIGHTGRAY);
+			DrawText(boardLabel(i).c_str(), (int)row.x + 8, (int)row.y + 4, 16, DARKGRAY);
 		}
+		EndScissorMode();
 		
-		y += 10;
-		DrawText("Sides:", 50, y, 20, BLACK);
-		y += 30;
-		for (const auto& s : currentOrder.sides) {
-			std::string line = s.getName() + " $" + std::to_string(s.calculatePrice());
-			DrawText(line.c_str(), 60, y, 18, DARKGRAY);
-			y += 25;
+		if (boardSelected >= 0 && boardSelected < (int)activeOrders.size()) {
+			const Order& o = activeOrders[boardSelected];
+			int y = 485;
+			DrawText(TextFormat("Order #%d for %s", o.orderId, o.customerName.c_str()), 30, y, 18, BLACK);
+			int x = 30;
+			y += 26;
+			for (const auto& l : o) {
+				const char* item = TextFormat("%s $%s", menu->name(l.item).c_str(), formatCents(l.priceCents).c_str());
+				int width = MeasureText(item, 16) + 20;
+				if (x + width > 870) { x = 30; y += 22; }
+				if (y > 570) break;
+				DrawText(item, x, y, 16, DARKGRAY);
+				x += width;
+			}
 		}
 		
-		y += 40;
-		std::string totalStr = "Total: $" + std::to_string(currentOrder.totalAmount);
-		DrawText(totalStr.c_str(), 50, y, 22, RED);
+#if defined(DEBUG)
+		if (GuiButton({30, 600, 220, 50}, "Add 100k test orders")) addTestOrders(100000);
+#endif
+		if (GuiButton({650, 600, 200, 50}, "Back to Menu")) {
+			currentScreen = Screen::MAIN_MENU;
+		}
+	}
+	
+	// ====================
+	// Sales Dashboard
+	// ====================
+	
+	void refreshSales() {
+		static const SalesGroup groups[] = { SalesGroup::ITEM, SalesGroup::SIZE, SalesGroup::HOUR, SalesGroup::ORDER_TYPE };
+		salesMenu = menu;
+		for (int g = 0; g < 4; g++)
+			salesBy[g] = sales.query(groups[g], SalesStore::groupKeyCount(groups[g], *salesMenu));
+		toppingSales = sales.toppingCounts();
+		salesQueried = sales.size();
+		salesQueryTime = GetTime();
+	}
+	
+	// A day of made-up completed lines, so the dashboard has something to chew on.
+	void simulateSales(int lines) {
+		std::mt19937 rng((unsigned)sales.size() + 1);
+		int64_t now = (int64_t)time(nullptr);
+		sales.reserve(sales.size() + lines);
+		for (int i = 0; i < lines; i++) {
+			OrderLine l;
+			int category = rng() % 10;
+			if (category < 5) {
+				l.item = menu->pizzaId(rng() % menu->availablePizzas.size());
+				l.size = (PizzaSize)(rng() % SIZE_COUNT);
+				l.baseType = (BaseType)(rng() % 3);
+				for (int t = 0; t < (int)menu->availableToppings.size(); t++)
+					if (menu->topping((ToppingId)t).offered && rng() % 4 == 0) l.toppings.add((ToppingId)t);
+			} else if (category < 8) {
+				l.item = menu->drinkId(rng() % menu->availableDrinks.size());
+			} else {
+				l.item = menu->sideId(rng() % menu->availableSides.size());
+			}
+			l.priceCents = (int32_t)menu->linePrice(l.item, l.size, l.toppings);
+			sales.addLine(l, category < 5, (OrderType)(rng() % 3), now - 86400 + (int64_t)i * 86400 / lines);
+		}
+	}
+	
+	// Horizontal bars, one per label, scaled to the biggest value.
+	void drawBars(Rectangle area, const char* title, const std::vector<std::string>& labels, const std::vector<double>& values, Color color) {
+		GuiGroupBox(area, title);
+		double top = 1;
+		for (double v : values) top = std::max(top, v);
+		size_t rows = std::min(labels.size(), values.size());
+		float rowHeight = std::min(22.0f, (area.height - 16) / std::max<size_t>(1, rows));
+		float barX = area.x + 110, barWidth = area.width - 200;
+		for (size_t i = 0; i < rows; i++) {
+			float y = area.y + 12 + i * rowHeight;
+			DrawText(labels[i].c_str(), (int)area.x + 8, (int)y, 14, DARKGRAY);
+			DrawRectangle((int)barX, (int)y, (int)(barWidth * values[i] / top), (int)rowHeight - 4, color);
+			DrawText(TextFormat("%.0f", values[i]), (int)(barX + barWidth + 6), (int)y, 14, GRAY);
+		}
+	}
+	
+	void drawSales() {
+		DrawText("Sales", 400, 20, 25, DARKGRAY);
+		// new completed orders and menu reloads show up at most once a second
+		if ((sales.size() != salesQueried || salesMenu != menu) && GetTime() - salesQueryTime > 1.0) refreshSales();
+		// labels come from the menu the totals were grouped by, not from this frame's
+		const Menu& queried = *salesMenu;
+		
+		double queryMs = 0;
+		for (const auto& t : salesBy) queryMs += t.milliseconds;
+		DrawText(TextFormat("%zu lines, 4 queries in %.1f ms", salesQueried, queryMs), 30, 60, 18, GRAY);
 		
+		std::vector<std::string> labels;
+		std::vector<double> values;
+		auto revenue = [&](const SalesTotals& t) {
+			values.clear();
+			for (Cents c : t.revenue) values.push_back(c / 100.0);
+		};
+		
+		labels.clear();
+		for (size_t i = 0; i < queried.itemCount(); i++) labels.push_back(queried.name((ItemId)i).substr(0, 14));
+		revenue(salesBy[(int)SalesGroup::ITEM]);
+		drawBars({30, 90, 410, 250}, "Revenue by item, $", labels, values, ORANGE);
+		
+		labels = { "Small", "Medium", "Large", "Not sized" };
+		revenue(salesBy[(int)SalesGroup::SIZE]);
+		drawBars({460, 90, 410, 110}, "Revenue by size, $", labels, values, MAROON);
+		
+		labels = { "Dine-in", "Takeaway", "Delivery" };
+		revenue(salesBy[(int)SalesGroup::ORDER_TYPE]);
+		drawBars({460, 215, 410, 90}, "Revenue by order type, $", labels, values, DARKGREEN);
+		
+		labels.clear();
+		values.clear();
+		for (size_t t = 0; t < queried.availableToppings.size() && t < toppingSales.size(); t++) {
+			labels.push_back(queried.topping((ToppingId)t).name.substr(0, 14));
+			values.push_back((double)toppingSales[t]);
+		}
+		drawBars({460, 320, 410, 160}, "Lines by topping", labels, values, DARKBLUE);
+		
+		// hours as columns
+		Rectangle hours = {30, 355, 410, 220};
+		GuiGroupBox(hours, "Revenue by hour");
+		const auto& byHour = salesBy[(int)SalesGroup::HOUR].revenue;
+		Cents top = 1;
+		for (Cents c : byHour) top = std::max(top, c);
+		for (int h = 0; h < (int)byHour.size(); h++) {
+			float x = hours.x + 12 + h * 16;
+			float height = (hours.height - 40) * (float)byHour[h] / top;
+			DrawRectangle((int)x, (int)(hours.y + hours.height - 22 - height), 12, (int)height, PURPLE);
+			if (h % 3 == 0) DrawText(TextFormat("%d", h), (int)x, (int)(hours.y + hours.height - 18), 12, DARKGRAY);
+		}
+		
+		if (GuiButton({30, 600, 180, 50}, "Refresh")) refreshSales();
+		if (GuiButton({230, 600, 200, 50}, "Simulate 1M lines")) {
+			simulateSales(1000000);
+			refreshSales();
+		}
 		if (GuiButton({650, 600, 200, 50}, "Back to Menu")) {
 			currentScreen = Screen::MAIN_MENU;
 		}
@@ -0,0 +1,63 @@
+// pizzeria_server.cpp
+// Order service process for several tills, see include/order_server.h.
+// Runs until Ctrl+C.
+#include "pizzeria.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static OrderServer* running = nullptr;
+
+static void onSignal(int) {
+	if (running) running->stop();
+}
+
+static void usage() {
+	printf("usage: pizzeria_server [options]\n"
+		"  --host ADDRESS     TCP address to listen on (127.0.0.1)\n"
+		"  --port N           TCP port (5150)\n"
+		"  --unix PATH        listen on a Unix socket instead\n"
+		"  --journal FILE     keep orders in FILE (server_orders.journal)\n"
+		"  --no-journal       keep orders in memory only\n"
+		"  --menu FILE        serve the menu in FILE, reloaded when it changes\n");
+}
+
+int main(int argc, char** argv) {
+	ServerOptions options;
+	// not the app's orders.journal: each journal has exactly one writer
+	options.journalPath = "server_orders.journal";
+	for (int i = 1; i < argc; i++) {
+		const char* a = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		if (!strcmp(a, "--host") && value) options.host = argv[++i];
+		else if (!strcmp(a, "--port") && value) options.port = (uint16_t)atoi(argv[++i]);
+		else if (!strcmp(a, "--unix") && value) options.unixPath = argv[++i];
+		else if (!strcmp(a, "--journal") && value) options.journalPath = argv[++i];
+		else if (!strcmp(a, "--no-journal")) options.journalPath.clear();
+		else if (!strcmp(a, "--menu") && value) options.menuPath = argv[++i];
+		else {
+			usage();
+			return 1;
+		}
+	}
+
+	OrderServer server(options);
+	if (!server.start()) {
+		fprintf(stderr, "cannot start the order server\n");
+		return 1;
+	}
+	if (options.unixPath.empty()) printf("serving orders on %s:%u\n", options.host.c_str(), (unsigned)server.port());
+	else printf("serving orders on %s\n", options.unixPath.c_str());
+
+	running = &server;
+	signal(SIGINT, onSignal);
+	signal(SIGTERM, onSignal);
+	server.run();
+	running = nullptr;
+
+	ServerStats s = server.stats();
+	printf("%llu requests in %llu reads, %llu orders sent to the kitchen\n",
+		(unsigned long long)s.requests, (unsigned long long)s.reads, (unsigned long long)s.ordersSent);
+	return 0;
+}
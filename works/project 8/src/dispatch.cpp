@@ -0,0 +1,252 @@
+// dispatch.cpp
+#include "dispatch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+static const GridPoint PIZZERIA = {0, 0};
+
+Dispatcher::Dispatcher(const DispatchConfig& c) : config(c) {
+	config.tripCapacity = std::min(std::max(config.tripCapacity, 1), MAX_STOPS);
+	config.sectors = std::max(config.sectors, 1);
+	config.couriers = std::max(config.couriers, 0);
+	pool.resize(config.sectors);
+	loading.resize(config.sectors);
+	couriers.resize(config.couriers);
+}
+
+GridPoint Dispatcher::locate(const std::string& address) const {
+	uint64_t h = 1469598103934665603ull; // FNV-1a
+	for (unsigned char ch : address) h = (h ^ ch) * 1099511628211ull;
+	int side = 2 * config.gridRadius + 1;
+	GridPoint p;
+	p.x = (int16_t)((int)(h % side) - config.gridRadius);
+	p.y = (int16_t)((int)((h >> 32) % side) - config.gridRadius);
+	return p;
+}
+
+Cents Dispatcher::quote(GridPoint drop) const {
+	double km = 2.0 * gridDistance(PIZZERIA, drop) * config.blockMeters / 1000.0;
+	return config.baseFee + (Cents)std::llround(config.centsPerKm * km);
+}
+
+int Dispatcher::sectorOf(GridPoint p) const {
+	if (p.x == 0 && p.y == 0) return 0;
+	const double turn = 6.283185307179586;
+	double angle = std::atan2((double)p.y, (double)p.x);
+	if (angle < 0) angle += turn;
+	return std::min((int)(angle / turn * config.sectors), config.sectors - 1);
+}
+
+bool Dispatcher::due(const std::vector<Stop>& sector, double now) const {
+	return !sector.empty() && ((int)sector.size() >= config.tripCapacity || now - sector.front().readyAt >= config.maxHoldSeconds);
+}
+
+// ========================
+// Routes
+// ========================
+
+// Pizzeria, every drop in order, pizzeria again.
+int Dispatcher::routeBlocks(const std::vector<Stop>& route) {
+	int blocks = 0;
+	GridPoint at = PIZZERIA;
+	for (const auto& s : route) {
+		blocks += gridDistance(at, s.drop);
+		at = s.drop;
+	}
+	return blocks + gridDistance(at, PIZZERIA);
+}
+
+// 2-opt with the pizzeria fixed at both ends: reverse any stretch of the
+// route whose two end edges get shorter crossed over, until none does.
+void Dispatcher::improve(std::vector<Stop>& route) {
+	int n = (int)route.size();
+	auto at = [&](int k) { return k == 0 || k == n + 1 ? PIZZERIA : route[k - 1].drop; };
+	for (bool improved = true; improved;) {
+		improved = false;
+		for (int i = 1; i < n; i++) {
+			for (int j = i + 1; j <= n; j++) {
+				int before = gridDistance(at(i - 1), at(i)) + gridDistance(at(j), at(j + 1));
+				int after = gridDistance(at(i - 1), at(j)) + gridDistance(at(i), at(j + 1));
+				if (after < before) {
+					std::reverse(route.begin() + (i - 1), route.begin() + j);
+					improved = true;
+				}
+			}
+		}
+	}
+}
+
+// The oldest order of the sector plus its nearest neighbours; the two
+// adjacent sectors lend orders that lie close to it.
+void Dispatcher::plan(int courier, int sector, double now) {
+	Courier& c = couriers[courier];
+	const Stop seed = pool[sector].front();
+	int reach = gridDistance(PIZZERIA, seed.drop) / 2;
+
+	struct Candidate { int distance; int sector; int index; };
+	std::vector<Candidate> candidates;
+	// with one or two sectors the neighbours coincide; visit each sector once
+	const int around[] = { sector, (sector + 1) % config.sectors, (sector + config.sectors - 1) % config.sectors };
+	for (int n = 0; n < 3; n++) {
+		int s = around[n];
+		if (std::find(around, around + n, s) != around + n) continue;
+		for (int i = 0; i < (int)pool[s].size(); i++) {
+			if (s == sector && i == 0) continue;
+			int distance = gridDistance(seed.drop, pool[s][i].drop);
+			if (s == sector || distance <= reach) candidates.push_back({distance, s, i});
+		}
+	}
+	size_t take = std::min(candidates.size(), (size_t)config.tripCapacity - 1);
+	std::partial_sort(candidates.begin(), candidates.begin() + take, candidates.end(),
+		[](const Candidate& a, const Candidate& b) { return a.distance < b.distance; });
+	candidates.resize(take);
+
+	std::vector<Stop> batch;
+	batch.push_back(seed);
+	for (const auto& k : candidates) batch.push_back(pool[k.sector][k.index]);
+	// erase back to front so the other indices stay valid
+	candidates.push_back({0, sector, 0});
+	std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.index > b.index; });
+	for (const auto& k : candidates) pool[k.sector].erase(pool[k.sector].begin() + k.index);
+	waiting -= (int)batch.size();
+
+	// nearest neighbour from the pizzeria
+	c.route.clear();
+	GridPoint at = PIZZERIA;
+	while (!batch.empty()) {
+		auto next = std::min_element(batch.begin(), batch.end(),
+			[&](const Stop& a, const Stop& b) { return gridDistance(at, a.drop) < gridDistance(at, b.drop); });
+		at = next->drop;
+		c.route.push_back(*next);
+		batch.erase(next);
+	}
+	improve(c.route);
+
+	c.state = Courier::LOADING;
+	c.sector = sector;
+	loading[sector].push_back(courier);
+	c.departAt = (int)c.route.size() >= config.tripCapacity ? now : now + config.loadSeconds;
+}
+
+// Cheapest place in a loading route, taken when the detour costs at most
+// half of a trip of its own.
+bool Dispatcher::insert(Courier& c, const Stop& s) {
+	int best = -1, bestCost = gridDistance(PIZZERIA, s.drop) + 1;
+	GridPoint at = PIZZERIA;
+	for (size_t k = 0; k <= c.route.size(); k++) {
+		GridPoint next = k < c.route.size() ? c.route[k].drop : PIZZERIA;
+		int cost = gridDistance(at, s.drop) + gridDistance(s.drop, next) - gridDistance(at, next);
+		if (cost < bestCost) {
+			bestCost = cost;
+			best = (int)k;
+		}
+		at = next;
+	}
+	if (best < 0) return false;
+	c.route.insert(c.route.begin() + best, s);
+	improve(c.route);
+	return true;
+}
+
+void Dispatcher::depart(Courier& c, int index, double now, std::vector<DispatchEvent>& events) {
+	double blockSeconds = config.blockMeters / config.courierSpeed;
+	double km = routeBlocks(c.route) * config.blockMeters / 1000.0;
+	int direct = 0;
+	for (const auto& s : c.route) direct += gridDistance(PIZZERIA, s.drop);
+
+	c.arrivals.clear();
+	double t = now;
+	GridPoint at = PIZZERIA;
+	for (const auto& s : c.route) {
+		t += gridDistance(at, s.drop) * blockSeconds;
+		c.arrivals.push_back(t);
+		t += config.handoverSeconds;
+		at = s.drop;
+
+		// the route is shared by how far each drop is from the pizzeria
+		double share = direct ? km * gridDistance(PIZZERIA, s.drop) / direct : km / c.route.size();
+		events.push_back({DispatchEvent::DEPARTED, s.orderId, index, config.baseFee + (Cents)std::llround(config.centsPerKm * share)});
+		holdSeconds += now - s.readyAt;
+	}
+	c.backAt = t + gridDistance(at, PIZZERIA) * blockSeconds;
+	c.nextDrop = 0;
+	c.state = Courier::DRIVING;
+	auto& l = loading[c.sector];
+	l.erase(std::find(l.begin(), l.end(), index));
+
+	totals.trips++;
+	ordersCarried += c.route.size();
+	routeKm += km;
+}
+
+// ========================
+// Dispatching
+// ========================
+
+void Dispatcher::add(int orderId, GridPoint drop, double now) {
+	Stop s{orderId, drop, now};
+	int sector = sectorOf(drop);
+	totals.received++;
+	for (int i : loading[sector]) {
+		Courier& c = couriers[i];
+		if ((int)c.route.size() >= config.tripCapacity) continue;
+		if (insert(c, s)) {
+			if ((int)c.route.size() >= config.tripCapacity) c.departAt = now;
+			return;
+		}
+	}
+	pool[sector].push_back(s);
+	waiting++;
+}
+
+void Dispatcher::update(double now, std::vector<DispatchEvent>& events) {
+	auto started = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < (int)couriers.size(); i++) {
+		Courier& c = couriers[i];
+		if (c.state == Courier::LOADING && now >= c.departAt) depart(c, i, now, events);
+		if (c.state != Courier::DRIVING) continue;
+		for (; c.nextDrop < c.route.size() && c.arrivals[c.nextDrop] <= now; c.nextDrop++) {
+			events.push_back({DispatchEvent::DELIVERED, c.route[c.nextDrop].orderId, i, 0});
+			totals.delivered++;
+		}
+		if (now >= c.backAt && c.nextDrop == c.route.size()) {
+			c.state = Courier::IDLE;
+			c.route.clear();
+		}
+	}
+
+	// idle couriers take the due sector whose oldest order has waited longest
+	for (int i = 0; i < (int)couriers.size() && waiting > 0; i++) {
+		Courier& c = couriers[i];
+		if (c.state != Courier::IDLE) continue;
+		int best = -1;
+		for (int s = 0; s < config.sectors; s++)
+			if (due(pool[s], now) && (best < 0 || pool[s].front().readyAt < pool[best].front().readyAt)) best = s;
+		if (best < 0) break;
+		plan(i, best, now);
+		if (now >= c.departAt) depart(c, i, now, events);
+	}
+
+	double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+	totals.maxUpdateMicros = std::max(totals.maxUpdateMicros, micros);
+}
+
+DispatchStats Dispatcher::stats() {
+	DispatchStats s = totals;
+	s.couriers = (int)couriers.size();
+	for (const auto& c : couriers) {
+		s.idle += c.state == Courier::IDLE;
+		s.loading += c.state == Courier::LOADING;
+	}
+	s.waiting = waiting;
+	if (totals.trips) s.ordersPerTrip = (double)ordersCarried / totals.trips;
+	if (ordersCarried) {
+		s.kmPerOrder = routeKm / ordersCarried;
+		s.avgHoldSeconds = holdSeconds / ordersCarried;
+	}
+	totals.maxUpdateMicros = 0;
+	return s;
+}
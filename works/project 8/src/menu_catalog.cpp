@@ -0,0 +1,159 @@
+// menu_catalog.cpp
+#include "menu_catalog.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+void MenuCatalog::publish(std::shared_ptr<const Menu> menu) {
+	std::atomic_store(&snapshot, std::move(menu));
+	published.fetch_add(1, std::memory_order_release);
+}
+
+bool MenuCatalog::load(const std::string& path, std::string& error) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		error = "cannot open " + path;
+		return false;
+	}
+	std::stringstream text;
+	text << file.rdbuf();
+	std::shared_ptr<Menu> menu = parse(text.str(), error);
+	if (menu) {
+		// orders may hold any ID the current menu knows
+		std::shared_ptr<const Menu> old = current();
+		for (size_t id = 0; id < old->itemCount() && error.empty(); id++)
+			if (old->known((ItemId)id) && !menu->known((ItemId)id))
+				error = "item " + std::to_string(id) + " (" + old->name((ItemId)id) + ") is gone, mark it off instead";
+		for (size_t t = 0; t < old->availableToppings.size() && error.empty(); t++)
+			if (!old->availableToppings[t].name.empty() && (t >= menu->availableToppings.size() || menu->availableToppings[t].name.empty()))
+				error = "topping " + std::to_string(t) + " (" + old->availableToppings[t].name + ") is gone, mark it off instead";
+	}
+	if (!menu || !error.empty()) {
+		error = path + ", " + error;
+		return false;
+	}
+	publish(std::move(menu));
+	return true;
+}
+
+bool MenuCatalog::reloadIfChanged(const std::string& path, std::string& error) {
+	std::error_code ec;
+	auto written = std::filesystem::last_write_time(path, ec);
+	if (ec) return false;
+	int64_t stamp = (int64_t)written.time_since_epoch().count();
+	if (stamp == loadedStamp) return false;
+	// a failed load is not retried until the file changes again
+	loadedStamp = stamp;
+	return load(path, error);
+}
+
+// ========================
+// Parsing
+// ========================
+
+static std::string trimmed(const std::string& s) {
+	size_t b = s.find_first_not_of(" \t\r");
+	if (b == std::string::npos) return std::string();
+	return s.substr(b, s.find_last_not_of(" \t\r") - b + 1);
+}
+
+static bool parseNumber(const std::string& s, double& value) {
+	char* end = nullptr;
+	value = strtod(s.c_str(), &end);
+	return !s.empty() && *end == '\0' && value >= 0;
+}
+
+std::shared_ptr<Menu> MenuCatalog::parse(const std::string& text, std::string& error) {
+	auto menu = std::make_shared<Menu>(false);
+	std::vector<bool> usedIds;
+	uint32_t usedBits = 0;
+	std::istringstream lines(text);
+	std::string line;
+	int lineNumber = 0;
+	auto fail = [&](const std::string& what) {
+		error = lineNumber ? "line " + std::to_string(lineNumber) + ": " + what : what;
+		return nullptr;
+	};
+
+	while (std::getline(lines, line)) {
+		lineNumber++;
+		line = line.substr(0, line.find('#'));
+		if (trimmed(line).empty()) continue;
+		std::vector<std::string> f;
+		std::istringstream fields(line);
+		for (std::string field; std::getline(fields, field, '|');) f.push_back(trimmed(field));
+		bool off = f.size() > 4 && f.back() == "off";
+		if (off) f.pop_back();
+		if (f.size() < 4) return fail("expected kind | id | name | price");
+
+		const std::string& kind = f[0];
+		const std::string& name = f[2];
+		double id, price;
+		if (!parseNumber(f[1], id) || id != (int)id) return fail("bad id '" + f[1] + "'");
+		if (!parseNumber(f[3], price)) return fail("bad price '" + f[3] + "'");
+		if (name.empty()) return fail("empty name");
+
+		if (kind == "topping") {
+			if (f.size() != 4) return fail("a topping has no extra fields");
+			if (id >= ToppingSet::CAPACITY) return fail("topping bits go up to 31");
+			if (usedBits >> (int)id & 1u) return fail("topping bit used twice");
+			usedBits |= 1u << (int)id;
+			if (menu->availableToppings.size() <= (size_t)id) menu->availableToppings.resize((size_t)id + 1, Topping{"", 0.0, false});
+			menu->availableToppings[(size_t)id] = Topping{name, price, !off};
+			continue;
+		}
+
+		if (id >= 0xFFFF) return fail("item IDs go up to 65534");
+		ItemId itemId = (ItemId)id;
+		if (usedIds.size() <= itemId) usedIds.resize(itemId + 1);
+		if (usedIds[itemId]) return fail("item ID used twice");
+		usedIds[itemId] = true;
+		ItemCategory category;
+		if (kind == "pizza") {
+			if (f.size() != 4) return fail("a pizza has no extra fields");
+			category = ItemCategory::PIZZA;
+			if (!off) {
+				menu->availablePizzas.emplace_back(name, price);
+				menu->pizzaIds.push_back(itemId);
+			}
+		} else if (kind == "drink") {
+			double litres;
+			if (f.size() != 6 || !parseNumber(f[4], litres) || (f[5] != "carbonated" && f[5] != "still"))
+				return fail("expected drink | id | name | price | litres | carbonated or still");
+			category = ItemCategory::DRINK;
+			if (!off) {
+				menu->availableDrinks.emplace_back(name, price, litres, f[5] == "carbonated");
+				menu->drinkIds.push_back(itemId);
+			}
+		} else if (kind == "side") {
+			if (f.size() != 5) return fail("expected side | id | name | price | portion");
+			category = ItemCategory::SIDE;
+			if (!off) {
+				menu->availableSides.emplace_back(name, price, f[4]);
+				menu->sideIds.push_back(itemId);
+			}
+		} else {
+			return fail("unknown kind '" + kind + "'");
+		}
+		if (off) {
+			menu->unlisted.emplace_back(name, price, "");
+			menu->unlistedIds.push_back(itemId);
+			menu->unlistedCategories.push_back(category);
+		}
+	}
+
+	lineNumber = 0;
+	if (menu->availablePizzas.empty() || menu->availableDrinks.empty() || menu->availableSides.empty())
+		return fail("the menu needs at least one pizza, drink and side");
+	menu->buildIndex();
+	for (const auto* list : { &menu->pizzaIds, &menu->drinkIds, &menu->sideIds }) {
+		for (ItemId id : *list) {
+			if (menu->findItem(menu->name(id)) != id) {
+				return fail("'" + menu->name(id) + "' is on the menu twice");
+			}
+		}
+	}
+	return menu;
+}
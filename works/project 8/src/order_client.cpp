@@ -0,0 +1,156 @@
+// order_client.cpp
+#include "order_client.h"
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// ========================
+// Requests
+// ========================
+
+void OrderClient::newOrder(OrderType type, const std::string& customer, const std::string& address) {
+	RecordWriter w;
+	w.put(Request::NEW_ORDER);
+	w.put((uint8_t)type);
+	w.putString(customer);
+	w.putString(address);
+	appendFrame(out, w);
+}
+
+void OrderClient::line(int32_t orderId, ItemId item, PizzaSize size, BaseType base, ToppingSet toppings) {
+	RecordWriter w;
+	w.put(Request::ADD_LINE);
+	w.put(orderId);
+	w.put(item);
+	w.put((uint8_t)size);
+	w.put((uint8_t)base);
+	w.put(toppings.bits);
+	appendFrame(out, w);
+}
+
+void OrderClient::addPizza(int32_t orderId, ItemId pizza, PizzaSize size, BaseType base, ToppingSet toppings) {
+	line(orderId, pizza, size, base, toppings);
+}
+
+void OrderClient::addItem(int32_t orderId, ItemId item) {
+	line(orderId, item, PizzaSize::MEDIUM, BaseType::THIN, ToppingSet{});
+}
+
+void OrderClient::removeLine(int32_t orderId, int32_t index) {
+	RecordWriter w;
+	w.put(Request::REMOVE_LINE);
+	w.put(orderId);
+	w.put(index);
+	appendFrame(out, w);
+}
+
+void OrderClient::send(int32_t orderId) {
+	RecordWriter w;
+	w.put(Request::SEND);
+	w.put(orderId);
+	appendFrame(out, w);
+}
+
+void OrderClient::status(int32_t orderId) {
+	RecordWriter w;
+	w.put(Request::STATUS);
+	w.put(orderId);
+	appendFrame(out, w);
+}
+
+#if !defined(_WIN32)
+
+// ========================
+// Socket
+// ========================
+
+bool OrderClient::connectTcp(const std::string& host, uint16_t port) {
+	close();
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) return false;
+	fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd < 0) return false;
+	int yes = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+	if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool OrderClient::connectUnix(const std::string& path) {
+	close();
+	sockaddr_un addr{};
+	addr.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(addr.sun_path)) return false;
+	memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) return false;
+	if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+void OrderClient::close() {
+	if (fd >= 0) ::close(fd);
+	fd = -1;
+	out.clear();
+	in.clear();
+	inUsed = 0;
+}
+
+bool OrderClient::flush() {
+	size_t sent = 0;
+	while (sent < out.size()) {
+		ssize_t put = ::send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+		if (put < 0 && errno == EINTR) continue;
+		if (put <= 0) return false;
+		sent += put;
+	}
+	out.clear();
+	return true;
+}
+
+bool OrderClient::receive(Response& r) {
+	for (;;) {
+		uint32_t payloadSize;
+		size_t frameBytes;
+		if (const uint8_t* payload = nextFrame(in.data() + inUsed, in.size() - inUsed, payloadSize, frameBytes)) {
+			bool ok = parseResponse(payload, payloadSize, r);
+			inUsed += frameBytes;
+			if (inUsed == in.size()) {
+				in.clear();
+				inUsed = 0;
+			}
+			return ok;
+		}
+		if (fd < 0) return false;
+		uint8_t buffer[16384];
+		ssize_t got = read(fd, buffer, sizeof(buffer));
+		if (got < 0 && errno == EINTR) continue;
+		if (got <= 0) return false;
+		in.insert(in.end(), buffer, buffer + got);
+	}
+}
+
+#else
+
+bool OrderClient::connectTcp(const std::string&, uint16_t) { return false; }
+bool OrderClient::connectUnix(const std::string&) { return false; }
+void OrderClient::close() {}
+bool OrderClient::flush() { return false; }
+bool OrderClient::receive(Response&) { return false; }
+
+#endif
@@ -0,0 +1,400 @@
+// order_journal.cpp
+// Kept apart from main.cpp: windows.h and raylib.h cannot share a translation unit.
+#include "order_journal.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char JOURNAL_MAGIC[4] = { 'P', 'Z', 'J', '1' };
+static const uint32_t JOURNAL_VERSION = 1;
+static const size_t HEADER_SIZE = 8;
+static const size_t RECORD_HEADER_SIZE = 8;
+
+// ========================
+// Files
+// ========================
+
+#if defined(_WIN32)
+
+// Other processes may read the file but not open it for writing.
+static intptr_t openFile(const std::string& path) {
+	HANDLE h = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	return h == INVALID_HANDLE_VALUE ? -1 : (intptr_t)h;
+}
+
+static void closeFile(intptr_t file) { CloseHandle((HANDLE)file); }
+
+static bool writeFile(intptr_t file, const void* data, size_t size) {
+	const uint8_t* p = (const uint8_t*)data;
+	while (size > 0) {
+		DWORD chunk = size > (1u << 30) ? (1u << 30) : (DWORD)size, written = 0;
+		if (!WriteFile((HANDLE)file, p, chunk, &written, nullptr) || written == 0) return false;
+		p += written;
+		size -= written;
+	}
+	return true;
+}
+
+static bool syncFile(intptr_t file) { return FlushFileBuffers((HANDLE)file) != 0; }
+
+// Cuts the file to size and moves the write position there.
+static bool truncateFile(intptr_t file, uint64_t size) {
+	LARGE_INTEGER pos;
+	pos.QuadPart = (LONGLONG)size;
+	return SetFilePointerEx((HANDLE)file, pos, nullptr, FILE_BEGIN) && SetEndOfFile((HANDLE)file);
+}
+
+static bool replaceFile(const std::string& from, const std::string& to) {
+	return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+struct MappedFile {
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+
+	// false only for a file that exists but cannot be read
+	bool map(const std::string& path) {
+		// shares writing with our own handle from openFile()
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return GetLastError() == ERROR_FILE_NOT_FOUND;
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize)) return false;
+		size = (size_t)fileSize.QuadPart;
+		if (size == 0) return true;
+		mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping) return false;
+		data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		return data != nullptr;
+	}
+
+	~MappedFile() {
+		if (data) UnmapViewOfFile(data);
+		if (mapping) CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+	}
+};
+
+#else
+
+// Locked, so a second process (or a second journal) cannot open the file
+// and append to it at the same time.
+static intptr_t openFile(const std::string& path) {
+	int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (fd >= 0 && flock(fd, LOCK_EX | LOCK_NB) != 0) {
+		::close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+static void closeFile(intptr_t file) { ::close((int)file); }
+
+static bool writeFile(intptr_t file, const void* data, size_t size) {
+	const uint8_t* p = (const uint8_t*)data;
+	while (size > 0) {
+		ssize_t written = write((int)file, p, size);
+		if (written <= 0) return false;
+		p += written;
+		size -= (size_t)written;
+	}
+	return true;
+}
+
+static bool syncFile(intptr_t file) {
+#if defined(__APPLE__)
+	return fsync((int)file) == 0;
+#else
+	return fdatasync((int)file) == 0;
+#endif
+}
+
+// Cuts the file to size and moves the write position there.
+static bool truncateFile(intptr_t file, uint64_t size) {
+	return ftruncate((int)file, (off_t)size) == 0 && lseek((int)file, (off_t)size, SEEK_SET) == (off_t)size;
+}
+
+static bool replaceFile(const std::string& from, const std::string& to) {
+	if (rename(from.c_str(), to.c_str()) != 0) return false;
+	// the rename itself is only durable once the directory is synced
+	size_t slash = to.find_last_of('/');
+	std::string dir = slash == std::string::npos ? "." : to.substr(0, slash + 1);
+	int fd = open(dir.c_str(), O_RDONLY);
+	if (fd >= 0) {
+		fsync(fd);
+		::close(fd);
+	}
+	return true;
+}
+
+struct MappedFile {
+	const uint8_t* data = nullptr;
+	size_t size = 0;
+
+	// false only for a file that exists but cannot be read
+	bool map(const std::string& path) {
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) return errno == ENOENT;
+		struct stat st;
+		bool ok = fstat(fd, &st) == 0;
+		size = ok ? (size_t)st.st_size : 0;
+		if (ok && size > 0) {
+			void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			ok = p != MAP_FAILED;
+			if (ok) {
+				data = (const uint8_t*)p;
+				madvise(p, size, MADV_SEQUENTIAL);
+			}
+		}
+		::close(fd);
+		return ok;
+	}
+
+	~MappedFile() {
+		if (data) munmap((void*)data, size);
+	}
+};
+
+#endif
+
+static uint32_t readU32(const uint8_t* p) {
+	uint32_t v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+// ========================
+// Records
+// ========================
+
+// Slicing-by-8: eight table lookups per 8 bytes instead of one per byte.
+uint32_t OrderJournal::crc32(const uint8_t* data, size_t size) {
+	static uint32_t table[8][256];
+	static bool ready = [] {
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t c = i;
+			for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+			table[0][i] = c;
+		}
+		for (uint32_t i = 0; i < 256; i++)
+			for (int t = 1; t < 8; t++) table[t][i] = (table[t - 1][i] >> 8) ^ table[0][table[t - 1][i] & 0xff];
+		return true;
+	}();
+	(void)ready;
+
+	uint32_t c = 0xFFFFFFFFu;
+	while (size >= 8) {
+		uint32_t lo = readU32(data) ^ c, hi = readU32(data + 4);
+		c = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^ table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+			table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^ table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+		data += 8;
+		size -= 8;
+	}
+	while (size--) c = table[0][(c ^ *data++) & 0xff] ^ (c >> 8);
+	return c ^ 0xFFFFFFFFu;
+}
+
+void OrderJournal::frame(std::vector<uint8_t>& out, const void* payload, uint32_t size) {
+	size_t at = out.size();
+	out.resize(at + RECORD_HEADER_SIZE + size);
+	uint32_t crc = crc32((const uint8_t*)payload, size);
+	memcpy(&out[at], &size, 4);
+	memcpy(&out[at + 4], &crc, 4);
+	memcpy(&out[at + RECORD_HEADER_SIZE], payload, size);
+}
+
+static void writeHeader(std::vector<uint8_t>& out) {
+	out.insert(out.end(), JOURNAL_MAGIC, JOURNAL_MAGIC + 4);
+	out.resize(out.size() + 4);
+	memcpy(&out[out.size() - 4], &JOURNAL_VERSION, 4);
+}
+
+// ========================
+// Journal
+// ========================
+
+bool OrderJournal::open(const std::string& journalPath, RecordCallback onRecord, void* user, const JournalOptions& journalOptions) {
+	close();
+	path = journalPath;
+	options = journalOptions;
+
+	// Opened (and locked) before reading, so nobody appends while we replay.
+	file = openFile(path);
+	if (file < 0) return false;
+
+	// Everything up to the first damaged record is kept; the rest is a
+	// write that did not finish before a crash.
+	uint64_t valid = 0;
+	bool ok = true;
+	{
+		MappedFile mapped;
+		ok = mapped.map(path);
+		if (ok && mapped.size >= HEADER_SIZE) {
+			ok = memcmp(mapped.data, JOURNAL_MAGIC, 4) == 0 && readU32(mapped.data + 4) == JOURNAL_VERSION;
+			size_t pos = HEADER_SIZE;
+			while (ok && mapped.size - pos >= RECORD_HEADER_SIZE) {
+				uint32_t size = readU32(mapped.data + pos);
+				const uint8_t* payload = mapped.data + pos + RECORD_HEADER_SIZE;
+				if (size > mapped.size - pos - RECORD_HEADER_SIZE || crc32(payload, size) != readU32(mapped.data + pos + 4)) break;
+				if (onRecord) onRecord(payload, size, user);
+				pos += RECORD_HEADER_SIZE + size;
+			}
+			valid = pos;
+		}
+	}
+
+	ok = ok && truncateFile(file, valid);
+	if (ok && valid == 0) {
+		std::vector<uint8_t> header;
+		writeHeader(header);
+		ok = writeFile(file, header.data(), header.size()) && syncFile(file);
+		valid = header.size();
+	}
+	if (!ok) {
+		closeFile(file);
+		file = -1;
+		return false;
+	}
+	bytesOnDisk = valid;
+
+	quit = false;
+	failed = false;
+	appendedSequence = durableSequence = 0;
+	flusher = std::thread(&OrderJournal::flusherMain, this);
+	return true;
+}
+
+void OrderJournal::close() {
+	if (flusher.joinable()) {
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			quit = true;
+		}
+		wake.notify_all();
+		flusher.join();
+	}
+	if (file >= 0) closeFile(file);
+	file = -1;
+}
+
+uint64_t OrderJournal::append(const void* payload, uint32_t size) {
+	if (file < 0) return 0;
+	uint64_t sequence;
+	bool full;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		frame(pending, payload, size);
+		sequence = ++appendedSequence;
+		full = pending.size() >= options.flushBytes;
+	}
+	if (full) wake.notify_one();
+	return sequence;
+}
+
+void OrderJournal::waitDurable(uint64_t sequence) {
+	std::unique_lock<std::mutex> guard(lock);
+	durable.wait(guard, [&] { return durableSequence >= sequence || failed || quit; });
+}
+
+void OrderJournal::flusherMain() {
+	std::vector<uint8_t> writing;
+	std::unique_lock<std::mutex> guard(lock);
+	for (;;) {
+		wake.wait_for(guard, std::chrono::milliseconds(options.flushIntervalMs),
+			[&] { return quit || pending.size() >= options.flushBytes; });
+		if (pending.empty()) {
+			if (quit) break;
+			continue;
+		}
+		guard.unlock();
+
+		// Held from taking the records until they are written, so compact()
+		// never runs while records are in flight; it may have taken them
+		// all while we waited.
+		std::lock_guard<std::mutex> fileGuard(fileLock);
+		guard.lock();
+		writing.swap(pending);
+		uint64_t sequence = appendedSequence;
+		guard.unlock();
+
+		bool ok = writing.empty() || (writeFile(file, writing.data(), writing.size()) && (!options.sync || syncFile(file)));
+		if (ok) bytesOnDisk += writing.size();
+		writing.clear();
+
+		guard.lock();
+		if (!ok) failed = true;
+		if (sequence > durableSequence) durableSequence = sequence;
+		durable.notify_all();
+	}
+}
+
+bool OrderJournal::compact(const std::vector<uint8_t>& records) {
+	if (file < 0) return false;
+	std::lock_guard<std::mutex> fileGuard(fileLock);
+	// The snapshot covers what is pending now. Holding fileLock means the
+	// flusher has nothing in flight, so these are all unwritten records; if
+	// the snapshot fails they go below the old file's records instead.
+	uint64_t covered;
+	std::vector<uint8_t> covering;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		covered = appendedSequence;
+		covering.swap(pending);
+	}
+
+	std::string tmpPath = path + ".tmp";
+	std::vector<uint8_t> header;
+	writeHeader(header);
+	intptr_t tmp = openFile(tmpPath);
+	bool ok = tmp >= 0 && truncateFile(tmp, 0) && writeFile(tmp, header.data(), header.size()) &&
+		writeFile(tmp, records.data(), records.size()) && syncFile(tmp);
+#ifdef _WIN32
+	// the old file has to be closed before Windows lets us replace it
+	if (tmp >= 0) closeFile(tmp);
+	closeFile(file);
+	ok = ok && replaceFile(tmpPath, path);
+	file = openFile(path);
+#else
+	// the locked snapshot file becomes the journal, so the lock is held
+	// across the rename and no other process can take the file meanwhile
+	ok = ok && replaceFile(tmpPath, path);
+	if (ok) {
+		closeFile(file);
+		file = tmp;
+	} else if (tmp >= 0) {
+		closeFile(tmp);
+	}
+#endif
+	uint64_t size = ok ? header.size() + records.size() : bytesOnDisk;
+	if (file >= 0 && !truncateFile(file, size)) {
+		closeFile(file);
+		file = -1;
+	}
+	bool written = file >= 0;
+	if (ok) {
+		bytesOnDisk = size;
+	} else if (written && !covering.empty()) {
+		written = writeFile(file, covering.data(), covering.size()) && (!options.sync || syncFile(file));
+		if (written) bytesOnDisk += covering.size();
+	}
+
+	std::lock_guard<std::mutex> guard(lock);
+	if (!written) failed = true; // neither file took the covered records
+	else if (covered > durableSequence) durableSequence = covered;
+	durable.notify_all();
+	return ok;
+}
@@ -0,0 +1,470 @@
+// order_server.cpp
+#include "order_server.h"
+#include <algorithm>
+#include <cstdio>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+OrderServer::OrderServer(const ServerOptions& o) : options(o), kitchen(o.kitchen) {}
+
+OrderServer::~OrderServer() {
+#if defined(__linux__)
+	for (auto& kv : connections) ::close(kv.first);
+	if (listenFd >= 0) ::close(listenFd);
+	if (epollFd >= 0) ::close(epollFd);
+	if (wakeFd >= 0) ::close(wakeFd);
+	if (!options.unixPath.empty() && listenFd >= 0) unlink(options.unixPath.c_str());
+#endif
+}
+
+ServerStats OrderServer::stats() const {
+	ServerStats s;
+	s.connections = connectionCount.load(std::memory_order_relaxed);
+	s.requests = requestCount.load(std::memory_order_relaxed);
+	s.ordersSent = sentCount.load(std::memory_order_relaxed);
+	s.reads = readCount.load(std::memory_order_relaxed);
+	return s;
+}
+
+static bool finished(OrderStatus s) { return s != OrderStatus::PENDING && s != OrderStatus::PREPARING; }
+
+// prune() waits for this many finished orders, or half of all of them,
+// so each kept order is copied O(1) times on average.
+static constexpr size_t PRUNE_AFTER = 4096;
+// How often pollKitchen() runs, and so the longest epoll wait.
+static constexpr int KITCHEN_POLL_MS = 100;
+
+// ========================
+// Requests
+// ========================
+
+Order* OrderServer::find(Connection& c, int32_t id, Response& r) {
+	if (id == 0) id = c.current;
+	r.orderId = id;
+	auto found = orderIndex.find(id);
+	if (found == orderIndex.end()) {
+		r.result = Result::UNKNOWN_ORDER;
+		return nullptr;
+	}
+	return &orders[found->second];
+}
+
+Response OrderServer::handle(Connection& c, const uint8_t* payload, uint32_t size) {
+	RecordReader in{payload, payload + size};
+	Response r;
+	r.request = in.get<Request>();
+	requestCount.fetch_add(1, std::memory_order_relaxed);
+
+	switch (r.request) {
+	case Request::NEW_ORDER: {
+		uint8_t type = in.get<uint8_t>();
+		std::string customer = in.getString();
+		std::string address = in.getString();
+		if (!in.ok || type > (uint8_t)OrderType::DELIVERY) break;
+		Order o(allocateOrderId(), &arenas[arena]);
+		o.orderType = (OrderType)type;
+		o.customerName = std::move(customer);
+		if (o.orderType == OrderType::DELIVERY) {
+			o.deliveryAddress = std::move(address);
+			o.deliveryFee = quotes.quote(quotes.locate(o.deliveryAddress));
+		}
+		log.created(o);
+		c.current = r.orderId = o.orderId;
+		c.drafts.push_back(o.orderId);
+		r.total = o.total();
+		orderIndex[o.orderId] = orders.size();
+		orders.push_back(std::move(o));
+		return r;
+	}
+	case Request::ADD_LINE: {
+		int32_t id = in.get<int32_t>();
+		ItemId item = in.get<ItemId>();
+		uint8_t sizeIndex = in.get<uint8_t>();
+		uint8_t base = in.get<uint8_t>();
+		ToppingSet toppings;
+		toppings.bits = in.get<uint32_t>();
+		if (!in.ok) break;
+		Order* o = find(c, id, r);
+		if (!o) return r;
+		if (o->status != OrderStatus::PENDING || o->kitchenTicket) {
+			r.result = Result::ALREADY_SENT;
+			return r;
+		}
+		bool added = false;
+		if (menu->offered(item) && sizeIndex < SIZE_COUNT && base <= (uint8_t)BaseType::THICK && menu->offered(toppings)) {
+			added = menu->category(item) == ItemCategory::PIZZA
+				? o->addPizza(*menu, item, (PizzaSize)sizeIndex, (BaseType)base, toppings)
+				: o->addItem(*menu, item);
+		}
+		if (!added) r.result = Result::BAD_ITEM;
+		else log.lineAdded(*o);
+		r.total = o->total();
+		return r;
+	}
+	case Request::REMOVE_LINE: {
+		int32_t id = in.get<int32_t>();
+		int32_t index = in.get<int32_t>();
+		if (!in.ok) break;
+		Order* o = find(c, id, r);
+		if (!o) return r;
+		if (o->kitchenTicket) r.result = Result::ALREADY_SENT;
+		else if (index < 0 || index >= o->lineCount()) r.result = Result::BAD_ITEM;
+		else {
+			o->removeLine(index);
+			log.lineRemoved(*o, index);
+		}
+		r.total = o->total();
+		return r;
+	}
+	case Request::SEND: {
+		int32_t id = in.get<int32_t>();
+		if (!in.ok) break;
+		Order* o = find(c, id, r);
+		if (!o) return r;
+		r.total = o->total();
+		if (o->kitchenTicket || o->empty()) {
+			r.result = o->kitchenTicket ? Result::ALREADY_SENT : Result::BAD_ITEM;
+			return r;
+		}
+		o->kitchenTicket = r.ticket = kitchen.submit();
+		if (!r.ticket) {
+			r.result = Result::KITCHEN_FULL;
+			return r;
+		}
+		log.statusChanged(*o);
+		cooking.push_back(o->orderId);
+		auto draft = std::find(c.drafts.begin(), c.drafts.end(), o->orderId);
+		if (draft != c.drafts.end()) c.drafts.erase(draft);
+		sentCount.fetch_add(1, std::memory_order_relaxed);
+		return r;
+	}
+	case Request::STATUS: {
+		int32_t id = in.get<int32_t>();
+		if (!in.ok) break;
+		Order* o = find(c, id, r);
+		if (!o) return r;
+		updateStatus(*o);
+		r.status = o->status;
+		r.ticket = o->kitchenTicket;
+		r.total = o->total();
+		return r;
+	}
+	}
+	r.result = Result::MALFORMED;
+	return r;
+}
+
+// ========================
+// Housekeeping
+// ========================
+
+void OrderServer::updateStatus(Order& o) {
+	if (!o.kitchenTicket || finished(o.status)) return;
+	OrderStatus status = kitchen.status(o.kitchenTicket);
+	if (status == o.status) return;
+	o.status = status;
+	log.statusChanged(o);
+	if (finished(status)) finishedOrders++;
+}
+
+// The kitchen threads never touch the orders: statuses are copied in here
+// for every order in the kitchen, not only the ones tills ask about.
+// Recovered orders the kitchen had no room for are submitted again.
+void OrderServer::pollKitchen() {
+	unsubmitted = 0;
+	for (size_t i = 0; i < cooking.size();) {
+		auto found = orderIndex.find(cooking[i]);
+		Order* o = found == orderIndex.end() ? nullptr : &orders[found->second];
+		if (o && !o->kitchenTicket && !(o->kitchenTicket = kitchen.submit())) unsubmitted++;
+		if (o) updateStatus(*o);
+		if (o && !finished(o->status)) {
+			i++;
+			continue;
+		}
+		cooking[i] = cooking.back();
+		cooking.pop_back();
+	}
+}
+
+// Runs between batches of requests, and at least every KITCHEN_POLL_MS.
+void OrderServer::maintain() {
+	auto now = std::chrono::steady_clock::now();
+	if (now - kitchenChecked >= std::chrono::milliseconds(KITCHEN_POLL_MS)) {
+		kitchenChecked = now;
+		pollKitchen();
+	}
+	bool snapshotDue = log.snapshotDue();
+	if (finishedOrders >= std::max(PRUNE_AFTER, orders.size() / 2) || (snapshotDue && finishedOrders > 0)) prune();
+	// a PENDING order without a ticket would be written as a draft and lost
+	if (snapshotDue && !unsubmitted && !log.snapshot(orders, nextOrderId.load())) fprintf(stderr, "%s: snapshot failed, the journal keeps growing\n", options.journalPath.c_str());
+	if (log.failed() && !journalFailed) {
+		fprintf(stderr, "%s: cannot write, new orders are not saved\n", options.journalPath.c_str());
+		journalFailed = true;
+	}
+}
+
+// Drops the finished orders and copies the rest into the other arena, so
+// the spans of dropped and regrown orders are released with this one.
+void OrderServer::prune() {
+	OrderArena& next = arenas[1 - arena];
+	std::vector<Order> kept;
+	kept.reserve(orders.size() - std::min(finishedOrders, orders.size()));
+	orderIndex.clear();
+	for (Order& o : orders) {
+		if (finished(o.status)) continue;
+		orderIndex[o.orderId] = kept.size();
+		kept.push_back(o.relocate(&next));
+	}
+	orders.swap(kept);
+	kept.clear();
+	arenas[arena].reset();
+	arena = 1 - arena;
+	finishedOrders = 0;
+}
+
+#if defined(__linux__)
+
+// ========================
+// Event loop
+// ========================
+
+static bool setNonBlocking(int fd) {
+	int flags = fcntl(fd, F_GETFL, 0);
+	return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+bool OrderServer::start() {
+	if (!options.menuPath.empty()) {
+		std::string error;
+		if (!catalog.reloadIfChanged(options.menuPath, error)) {
+			fprintf(stderr, "%s\n", error.empty() ? ("cannot open " + options.menuPath).c_str() : error.c_str());
+			return false;
+		}
+		menuChecked = std::chrono::steady_clock::now();
+	}
+	menu = catalog.current();
+
+	int recovered = 1;
+	if (!options.journalPath.empty()) {
+		if (!log.open(options.journalPath, *menu, arenas[arena], orders, recovered, options.journal)) {
+			fprintf(stderr, "cannot open %s, is another server or till using it?\n", options.journalPath.c_str());
+			return false;
+		}
+		for (size_t i = 0; i < orders.size(); i++) {
+			orderIndex[orders[i].orderId] = i;
+			if (finished(orders[i].status)) finishedOrders++;
+			if (orders[i].status == OrderStatus::PENDING || orders[i].status == OrderStatus::PREPARING) {
+				orders[i].kitchenTicket = kitchen.submit();
+				if (!orders[i].kitchenTicket) unsubmitted++;
+				cooking.push_back(orders[i].orderId);
+			}
+		}
+		if (unsubmitted) fprintf(stderr, "%zu recovered orders wait for room in the kitchen\n", unsubmitted);
+	}
+	nextOrderId.store(recovered);
+
+	if (options.unixPath.empty()) {
+		listenFd = socket(AF_INET, SOCK_STREAM, 0);
+		if (listenFd < 0) return false;
+		int yes = 1;
+		setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+		sockaddr_in addr{};
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(options.port);
+		if (inet_pton(AF_INET, options.host.c_str(), &addr.sin_addr) != 1) return false;
+		if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0) return false;
+		socklen_t length = sizeof(addr);
+		getsockname(listenFd, (sockaddr*)&addr, &length);
+		boundPort = ntohs(addr.sin_port);
+	} else {
+		listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (listenFd < 0) return false;
+		sockaddr_un addr{};
+		addr.sun_family = AF_UNIX;
+		if (options.unixPath.size() >= sizeof(addr.sun_path)) return false;
+		memcpy(addr.sun_path, options.unixPath.c_str(), options.unixPath.size() + 1);
+		unlink(options.unixPath.c_str());
+		if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0) return false;
+	}
+	if (listen(listenFd, SOMAXCONN) != 0 || !setNonBlocking(listenFd)) return false;
+
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (epollFd < 0 || wakeFd < 0) return false;
+	epoll_event ev{};
+	ev.events = EPOLLIN;
+	ev.data.fd = listenFd;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+	ev.data.fd = wakeFd;
+	epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+	running = true;
+	return true;
+}
+
+void OrderServer::stop() {
+	running = false;
+	if (wakeFd >= 0) {
+		uint64_t one = 1;
+		if (write(wakeFd, &one, sizeof(one)) < 0) {} // already woken
+	}
+}
+
+void OrderServer::run() {
+	epoll_event events[256];
+	while (running) {
+		int n = epoll_wait(epollFd, events, 256, KITCHEN_POLL_MS);
+		if (n < 0 && errno != EINTR) break;
+		if (!options.menuPath.empty()) reloadMenu();
+		menu = catalog.current();
+		for (int i = 0; i < n; i++) {
+			int fd = events[i].data.fd;
+			if (fd == listenFd) {
+				accept();
+				continue;
+			}
+			if (fd == wakeFd) continue;
+			auto found = connections.find(fd);
+			if (found == connections.end()) continue;
+			Connection& c = found->second;
+			if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+				close(c);
+				continue;
+			}
+			if ((events[i].events & EPOLLOUT) && !flush(c)) continue;
+			if (events[i].events & EPOLLIN) readable(c);
+		}
+		maintain();
+	}
+}
+
+// Requests read after this see the new menu; orders keep their lines.
+void OrderServer::reloadMenu() {
+	auto now = std::chrono::steady_clock::now();
+	if (now - menuChecked < std::chrono::seconds(1)) return;
+	menuChecked = now;
+	std::string error;
+	if (catalog.reloadIfChanged(options.menuPath, error)) printf("menu reloaded from %s\n", options.menuPath.c_str());
+	else if (!error.empty()) fprintf(stderr, "menu not reloaded: %s\n", error.c_str());
+}
+
+void OrderServer::accept() {
+	for (;;) {
+		int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0) return;
+		int yes = 1;
+		if (options.unixPath.empty()) setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+		Connection& c = connections[fd];
+		c.fd = fd;
+		epoll_event ev{};
+		ev.events = EPOLLIN;
+		ev.data.fd = fd;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+		connectionCount.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+// Drains the socket, answers every complete frame, writes once.
+void OrderServer::readable(Connection& c) {
+	uint8_t buffer[16384];
+	for (;;) {
+		ssize_t got = read(c.fd, buffer, sizeof(buffer));
+		if (got > 0) {
+			c.in.insert(c.in.end(), buffer, buffer + got);
+			if (got < (ssize_t)sizeof(buffer)) break;
+		} else if (got == 0 || (errno != EAGAIN && errno != EINTR)) {
+			close(c);
+			return;
+		} else if (errno == EAGAIN) {
+			break;
+		}
+	}
+	readCount.fetch_add(1, std::memory_order_relaxed);
+
+	size_t used = 0;
+	uint32_t payloadSize;
+	size_t frameBytes;
+	while (const uint8_t* payload = nextFrame(c.in.data() + used, c.in.size() - used, payloadSize, frameBytes)) {
+		appendResponse(c.out, handle(c, payload, payloadSize));
+		used += frameBytes;
+	}
+	if (c.in.size() - used >= 4) {
+		memcpy(&payloadSize, c.in.data() + used, 4);
+		if (payloadSize > MAX_FRAME_SIZE) {
+			close(c);
+			return;
+		}
+	}
+	c.in.erase(c.in.begin(), c.in.begin() + used);
+	flush(c);
+}
+
+// false when the connection was closed
+bool OrderServer::flush(Connection& c) {
+	while (c.outSent < c.out.size()) {
+		ssize_t put = send(c.fd, c.out.data() + c.outSent, c.out.size() - c.outSent, MSG_NOSIGNAL);
+		if (put > 0) {
+			c.outSent += put;
+		} else if (put < 0 && errno == EINTR) {
+			continue;
+		} else if (put < 0 && errno == EAGAIN) {
+			if (!c.writing) {
+				epoll_event ev{};
+				ev.events = EPOLLIN | EPOLLOUT;
+				ev.data.fd = c.fd;
+				epoll_ctl(epollFd, EPOLL_CTL_MOD, c.fd, &ev);
+				c.writing = true;
+			}
+			return true;
+		} else {
+			close(c);
+			return false;
+		}
+	}
+	c.out.clear();
+	c.outSent = 0;
+	if (c.writing) {
+		epoll_event ev{};
+		ev.events = EPOLLIN;
+		ev.data.fd = c.fd;
+		epoll_ctl(epollFd, EPOLL_CTL_MOD, c.fd, &ev);
+		c.writing = false;
+	}
+	return true;
+}
+
+// Drafts nobody sent before the till went away are cancelled in memory
+// only (recovery drops drafts anyway) and go with the next prune().
+void OrderServer::close(Connection& c) {
+	for (int32_t id : c.drafts) {
+		auto found = orderIndex.find(id);
+		if (found == orderIndex.end()) continue;
+		Order& o = orders[found->second];
+		if (o.kitchenTicket || o.status != OrderStatus::PENDING) continue;
+		o.status = OrderStatus::CANCELLED;
+		finishedOrders++;
+	}
+	int fd = c.fd;
+	epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+	::close(fd);
+	connections.erase(fd);
+	connectionCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+#else
+
+bool OrderServer::start() { return false; }
+void OrderServer::run() {}
+void OrderServer::stop() {}
+
+#endif
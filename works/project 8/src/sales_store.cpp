@@ -0,0 +1,294 @@
+// sales_store.cpp
+#include "sales_store.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SALES_SSE2 1
+#include <emmintrin.h>
+#else
+#define SALES_SSE2 0
+#endif
+
+// 32-bit partial sums of BLOCK lines cannot overflow below this price.
+static const size_t BLOCK = 2048;
+static const int32_t MASKED_MAX_CENTS = 1 << 20;
+static const size_t MIN_ROWS_PER_THREAD = 1 << 20;
+
+// ========================
+// Kernels
+// ========================
+
+// Row i counts when (times[i] - from) < span, compared unsigned.
+
+#if SALES_SSE2
+static inline __m128i loadKeys(const uint8_t* k) {
+	int32_t packed;
+	memcpy(&packed, k, 4);
+	__m128i zero = _mm_setzero_si128();
+	return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+}
+
+static inline __m128i loadKeys(const uint16_t* k) {
+	return _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i*)k), _mm_setzero_si128());
+}
+
+static inline int64_t sumLanes(__m128i v) {
+	int32_t lanes[4];
+	_mm_storeu_si128((__m128i*)lanes, v);
+	return (int64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+#endif
+
+// K compares per row, K >= keyCount; sums and counts have keyCount slots, keys
+// past them are dropped.
+template <int K, typename Key>
+static void maskedGroupSum(const Key* keys, const int32_t* values, const uint32_t* times, size_t begin, size_t end,
+	uint32_t from, uint32_t span, int keyCount, int64_t* sums, uint64_t* counts) {
+	for (size_t b = begin; b < end; b += BLOCK) {
+		size_t e = std::min(end, b + BLOCK);
+		size_t i = b;
+#if SALES_SSE2
+		__m128i s[K], c[K];
+		for (int g = 0; g < K; g++) s[g] = c[g] = _mm_setzero_si128();
+		const __m128i bias = _mm_set1_epi32(INT32_MIN);
+		const __m128i fromV = _mm_set1_epi32((int32_t)from);
+		const __m128i spanV = _mm_set1_epi32((int32_t)(span ^ 0x80000000u));
+		for (; i + 4 <= e; i += 4) {
+			__m128i t = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(times + i)), fromV);
+			__m128i in = _mm_cmplt_epi32(_mm_xor_si128(t, bias), spanV);
+			__m128i v = _mm_and_si128(_mm_loadu_si128((const __m128i*)(values + i)), in);
+			__m128i k = loadKeys(keys + i);
+			for (int g = 0; g < K; g++) {
+				__m128i m = _mm_cmpeq_epi32(k, _mm_set1_epi32(g));
+				s[g] = _mm_add_epi32(s[g], _mm_and_si128(m, v));
+				c[g] = _mm_sub_epi32(c[g], _mm_and_si128(m, in));
+			}
+		}
+		for (int g = 0; g < keyCount; g++) {
+			sums[g] += sumLanes(s[g]);
+			counts[g] += (uint64_t)sumLanes(c[g]);
+		}
+#endif
+		for (; i < e; i++) {
+			if (times[i] - from >= span || keys[i] >= keyCount) continue;
+			sums[keys[i]] += values[i];
+			counts[keys[i]]++;
+		}
+	}
+}
+
+// Four interleaved tables so that neighbouring rows with the same key do
+// not wait on each other's store. Keys past keyCount go to an extra slot.
+template <typename Key>
+static void histogramGroupSum(const Key* keys, const int32_t* values, const uint32_t* times, size_t begin, size_t end,
+	uint32_t from, uint32_t span, int keyCount, int64_t* sums, uint64_t* counts) {
+	size_t stride = keyCount + 1;
+	std::vector<int64_t> s(4 * stride);
+	std::vector<uint64_t> c(4 * stride);
+	size_t i = begin;
+	for (; i + 4 <= end; i += 4) {
+		for (int j = 0; j < 4; j++) {
+			bool in = times[i + j] - from < span;
+			size_t slot = j * stride + std::min<size_t>(keys[i + j], keyCount);
+			s[slot] += in ? values[i + j] : 0;
+			c[slot] += in;
+		}
+	}
+	for (; i < end; i++) {
+		bool in = times[i] - from < span;
+		size_t slot = std::min<size_t>(keys[i], keyCount);
+		s[slot] += in ? values[i] : 0;
+		c[slot] += in;
+	}
+	for (int j = 0; j < 4; j++) {
+		for (int k = 0; k < keyCount; k++) {
+			sums[k] += s[j * stride + k];
+			counts[k] += c[j * stride + k];
+		}
+	}
+}
+
+template <typename Key>
+static void groupSum(const Key* keys, const int32_t* values, const uint32_t* times, size_t begin, size_t end,
+	uint32_t from, uint32_t span, int keyCount, bool masked, int64_t* sums, uint64_t* counts) {
+	if (masked && keyCount <= 4) maskedGroupSum<4>(keys, values, times, begin, end, from, span, keyCount, sums, counts);
+	else if (masked && keyCount <= 8) maskedGroupSum<8>(keys, values, times, begin, end, from, span, keyCount, sums, counts);
+	else histogramGroupSum(keys, values, times, begin, end, from, span, keyCount, sums, counts);
+}
+
+// Byte counters, one per topping bit, flushed every 255 rows. The mask is
+// broadcast to all four dwords; lane L tests bit L / 4 (low) or 4 + L / 4
+// (high) of byte L % 4.
+static void toppingKernel(const uint32_t* masks, const uint32_t* times, size_t begin, size_t end,
+	uint32_t from, uint32_t span, uint64_t* counts) {
+	for (size_t b = begin; b < end; b += 255) {
+		size_t e = std::min(end, b + 255);
+#if SALES_SSE2
+		const __m128i lowBits = _mm_set_epi8(8, 8, 8, 8, 4, 4, 4, 4, 2, 2, 2, 2, 1, 1, 1, 1);
+		const __m128i highBits = _mm_set_epi8(-128, -128, -128, -128, 64, 64, 64, 64, 32, 32, 32, 32, 16, 16, 16, 16);
+		__m128i low = _mm_setzero_si128(), high = _mm_setzero_si128();
+		for (size_t i = b; i < e; i++) {
+			__m128i m = _mm_set1_epi32(times[i] - from < span ? (int32_t)masks[i] : 0);
+			low = _mm_sub_epi8(low, _mm_cmpeq_epi8(_mm_and_si128(m, lowBits), lowBits));
+			high = _mm_sub_epi8(high, _mm_cmpeq_epi8(_mm_and_si128(m, highBits), highBits));
+		}
+		uint8_t lanes[2][16];
+		_mm_storeu_si128((__m128i*)lanes[0], low);
+		_mm_storeu_si128((__m128i*)lanes[1], high);
+		for (int L = 0; L < 16; L++) {
+			counts[(L % 4) * 8 + L / 4] += lanes[0][L];
+			counts[(L % 4) * 8 + 4 + L / 4] += lanes[1][L];
+		}
+#else
+		for (size_t i = b; i < e; i++) {
+			uint32_t bits = times[i] - from < span ? masks[i] : 0;
+			for (; bits; bits &= bits - 1) counts[lowestBit(bits)]++;
+		}
+#endif
+	}
+}
+
+// Splits [0, rows) into one range per thread; work(begin, end, part).
+template <typename F>
+static void forEachPart(size_t rows, int parts, F work) {
+	std::vector<std::thread> pool;
+	for (int p = 1; p < parts; p++)
+		pool.emplace_back(work, rows * p / parts, rows * (p + 1) / parts, p);
+	work(0, rows / parts, 0);
+	for (auto& t : pool) t.join();
+}
+
+static int partCount(size_t rows, int threads) {
+	if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+	return (int)std::max<size_t>(1, std::min<size_t>(threads, rows / MIN_ROWS_PER_THREAD));
+}
+
+// ========================
+// Store
+// ========================
+
+void SalesStore::reserve(size_t lines) {
+	item.reserve(lines);
+	sizeKey.reserve(lines);
+	baseType.reserve(lines);
+	orderType.reserve(lines);
+	hour.reserve(lines);
+	toppings.reserve(lines);
+	cents.reserve(lines);
+	seconds.reserve(lines);
+}
+
+void SalesStore::clear() {
+	item.clear();
+	sizeKey.clear();
+	baseType.clear();
+	orderType.clear();
+	hour.clear();
+	toppings.clear();
+	cents.clear();
+	seconds.clear();
+	maxAbsCents = 0;
+}
+
+void SalesStore::addOrder(const Order& order, const Menu& menu, int64_t unixTime) {
+	for (const auto& l : order)
+		addLine(l, menu.category(l.item) == ItemCategory::PIZZA, order.orderType, unixTime);
+}
+
+void SalesStore::addLine(const OrderLine& line, bool sized, OrderType type, int64_t unixTime) {
+	if (cents.empty()) epoch = unixTime - unixTime % 86400;
+	// UTC offsets and DST switches fall on quarter hours, so the local hour
+	// holds for the whole quarter and localtime runs once per quarter.
+	int64_t quarter = unixTime - unixTime % 900;
+	if (quarter != hourQuarter) {
+		time_t t = (time_t)unixTime;
+		struct tm local;
+#if defined(_WIN32)
+		localtime_s(&local, &t);
+#else
+		localtime_r(&t, &local);
+#endif
+		hourQuarter = quarter;
+		quarterHour = (uint8_t)local.tm_hour;
+	}
+	item.push_back(line.item);
+	sizeKey.push_back(sized ? (uint8_t)line.size : (uint8_t)NO_SIZE);
+	baseType.push_back((uint8_t)line.baseType);
+	orderType.push_back((uint8_t)type);
+	hour.push_back(quarterHour);
+	toppings.push_back(line.toppings.bits);
+	cents.push_back(line.priceCents);
+	seconds.push_back((uint32_t)std::min<int64_t>(std::max<int64_t>(unixTime - epoch, 0), UINT32_MAX - 1));
+	maxAbsCents = std::max(maxAbsCents, line.priceCents < 0 ? -line.priceCents : line.priceCents);
+}
+
+void SalesStore::timeRange(int64_t from, int64_t to, uint32_t& begin, uint32_t& span) const {
+	int64_t b = from == INT64_MIN ? 0 : std::max<int64_t>(0, from - epoch);
+	int64_t e = to == INT64_MAX ? UINT32_MAX : std::max<int64_t>(0, to - epoch);
+	b = std::min<int64_t>(b, UINT32_MAX);
+	e = std::min<int64_t>(e, UINT32_MAX);
+	begin = (uint32_t)b;
+	span = e > b ? (uint32_t)(e - b) : 0;
+}
+
+int SalesStore::groupKeyCount(SalesGroup group, const Menu& menu) {
+	switch (group) {
+		case SalesGroup::ITEM: return (int)menu.itemCount();
+		case SalesGroup::SIZE: return NO_SIZE + 1;
+		case SalesGroup::HOUR: return HOURS;
+		case SalesGroup::ORDER_TYPE: return ORDER_TYPES;
+	}
+	return 0;
+}
+
+SalesTotals SalesStore::query(SalesGroup group, int keyCount, int64_t from, int64_t to, int threads) const {
+	auto started = std::chrono::steady_clock::now();
+	uint32_t begin, span;
+	timeRange(from, to, begin, span);
+	bool masked = keyCount <= 8 && maxAbsCents < MASKED_MAX_CENTS;
+
+	int parts = partCount(size(), threads);
+	std::vector<int64_t> sums(parts * keyCount);
+	std::vector<uint64_t> counts(parts * keyCount);
+	forEachPart(size(), parts, [&](size_t b, size_t e, int p) {
+		int64_t* s = &sums[p * keyCount];
+		uint64_t* c = &counts[p * keyCount];
+		switch (group) {
+			case SalesGroup::ITEM: groupSum(item.data(), cents.data(), seconds.data(), b, e, begin, span, keyCount, masked, s, c); break;
+			case SalesGroup::SIZE: groupSum(sizeKey.data(), cents.data(), seconds.data(), b, e, begin, span, keyCount, masked, s, c); break;
+			case SalesGroup::HOUR: groupSum(hour.data(), cents.data(), seconds.data(), b, e, begin, span, keyCount, masked, s, c); break;
+			case SalesGroup::ORDER_TYPE: groupSum(orderType.data(), cents.data(), seconds.data(), b, e, begin, span, keyCount, masked, s, c); break;
+		}
+	});
+
+	SalesTotals totals;
+	totals.revenue.assign(keyCount, 0);
+	totals.lines.assign(keyCount, 0);
+	for (int p = 0; p < parts; p++) {
+		for (int k = 0; k < keyCount; k++) {
+			totals.revenue[k] += sums[p * keyCount + k];
+			totals.lines[k] += counts[p * keyCount + k];
+		}
+	}
+	totals.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+	return totals;
+}
+
+std::vector<uint64_t> SalesStore::toppingCounts(int64_t from, int64_t to, int threads) const {
+	uint32_t begin, span;
+	timeRange(from, to, begin, span);
+	int parts = partCount(size(), threads);
+	std::vector<uint64_t> counts(parts * ToppingSet::CAPACITY);
+	forEachPart(size(), parts, [&](size_t b, size_t e, int p) {
+		toppingKernel(toppings.data(), seconds.data(), b, e, begin, span, &counts[p * ToppingSet::CAPACITY]);
+	});
+	std::vector<uint64_t> totals(ToppingSet::CAPACITY);
+	for (int p = 0; p < parts; p++)
+		for (int t = 0; t < ToppingSet::CAPACITY; t++) totals[t] += counts[p * ToppingSet::CAPACITY + t];
+	return totals;
+}